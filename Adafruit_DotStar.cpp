@@ -51,13 +51,15 @@
                 per pixel. Default if unspecified is DOTSTAR_BRG.
   @param   spi  Pointer to hardware SPIClass object (default is primary
                 SPI device 'SPI' if defined, else MUST pass in device).
+  @param   freq SPI clock rate in Hz, default is DOTSTAR_CLOCK_SPEED
+                (8 MHz). See setClockSpeed().
   @return  Adafruit_DotStar object. Call the begin() function before use.
 */
-Adafruit_DotStar::Adafruit_DotStar(uint16_t n, uint8_t o, SPIClass *spi)
-    : numLEDs(n), brightness(0), pixels(NULL), rOffset(o & 3),
-      gOffset((o >> 2) & 3), bOffset((o >> 4) & 3) {
-  spi_dev = new Adafruit_SPIDevice(-1, 8000000, SPI_BITORDER_MSBFIRST,
-                                   SPI_MODE0, spi);
+Adafruit_DotStar::Adafruit_DotStar(uint16_t n, uint8_t o, SPIClass *spi,
+                                   uint32_t freq)
+    : spiBus(spi), clockSpeed(freq), numLEDs(n), brightness(0), pixels(NULL),
+      rOffset(o & 3), gOffset((o >> 2) & 3), bOffset((o >> 4) & 3) {
+  newDevice();
   updateLength(n);
 }
 
@@ -71,13 +73,20 @@ Adafruit_DotStar::Adafruit_DotStar(uint16_t n, uint8_t o, SPIClass *spi)
                   Adafruit_DotStar.h, for example DOTSTAR_BRG for DotStars
                   expecting color bytes expressed in blue, red, green order
                   per pixel. Default if unspecified is DOTSTAR_BRG.
+  @param   freq   SPI clock rate in Hz, default is DOTSTAR_CLOCK_SPEED
+                  (8 MHz). See setClockSpeed().
   @return  Adafruit_DotStar object. Call the begin() function before use.
+  @note    With BUSIO_USE_FAST_PINIO and both pins on the same port, each
+           byte is clocked out with interrupts disabled (16 port writes),
+           so that interrupt handlers may safely change other pins on
+           that port. Interrupts are left enabled afterward.
 */
 Adafruit_DotStar::Adafruit_DotStar(uint16_t n, uint8_t data, uint8_t clock,
-                                   uint8_t o)
-    : brightness(0), pixels(NULL), rOffset(o & 3), gOffset((o >> 2) & 3),
+                                   uint8_t o, uint32_t freq)
+    : dataPin(data), clockPin(clock), clockSpeed(freq), brightness(0),
+      pixels(NULL), rOffset(o & 3), gOffset((o >> 2) & 3),
       bOffset((o >> 4) & 3) {
-  spi_dev = new Adafruit_SPIDevice(-1, clock, -1, data, 8000000);
+  newDevice();
   updateLength(n);
 }
 
@@ -86,7 +95,14 @@ Adafruit_DotStar::Adafruit_DotStar(uint16_t n, uint8_t data, uint8_t clock,
            back to INPUT.
 */
 Adafruit_DotStar::~Adafruit_DotStar(void) {
-  free(pixels);
+  if (!fixedPixels)
+    free(pixels);
+  free(palette);
+  free(frame);
+  free(front);
+  free(levels);
+  free(lut);
+  free(dither);
   if (spi_dev)
     delete (spi_dev);
 }
@@ -95,7 +111,10 @@ Adafruit_DotStar::~Adafruit_DotStar(void) {
   @brief   Initialize Adafruit_DotStar object -- sets data and clock pins
            to outputs and initializes hardware SPI if necessary.
 */
-void Adafruit_DotStar::begin(void) { spi_dev->begin(); }
+void Adafruit_DotStar::begin(void) {
+  spi_dev->begin();
+  resetCounters();
+}
 
 // Pins may be reassigned post-begin(), so a sketch can store hardware
 // config in flash, SD card, etc. rather than hardcoded. Also permits
@@ -107,12 +126,15 @@ void Adafruit_DotStar::begin(void) { spi_dev->begin(); }
   @brief   Switch over to hardware SPI. DotStars must be connected to
            MOSI, SCK pins. Data in pixel buffer is unaffected and can
            continue to be used.
+  @note    Uses the SPIClass passed to the constructor, if any, else the
+           default SPI device. Clock rate is unchanged.
 */
 void Adafruit_DotStar::updatePins(void) {
-  if (spi_dev)
-    delete (spi_dev);
-  spi_dev = new Adafruit_SPIDevice(-1, 8000000);
+  waitForShow();
+  dataPin = clockPin = -1;
+  newDevice();
   spi_dev->begin();
+  touch(0, numLEDs); // Different strip, maybe; don't skip next show()
 }
 
 /*!
@@ -121,177 +143,1612 @@ void Adafruit_DotStar::updatePins(void) {
            continue to be used.
   @param   data   Arduino pin number for data out.
   @param   clock  Arduino pin number for clock out.
+  @note    Clock rate is unchanged. See the soft SPI constructor regarding
+           interrupts.
 */
 void Adafruit_DotStar::updatePins(uint8_t data, uint8_t clock) {
+  waitForShow();
+  dataPin = data;
+  clockPin = clock;
+  newDevice();
+  spi_dev->begin();
+  touch(0, numLEDs); // Different strip, maybe; don't skip next show()
+}
+
+/*!
+  @brief   Change the SPI clock rate. APA102 strips can often run at 20 MHz
+           or more on short runs, while long runs (or long wires to the
+           first pixel) may need less than the default 8 MHz. Data in pixel
+           buffer is unaffected and can continue to be used.
+  @param   freq  Clock rate in Hz. The hardware SPI peripheral will use the
+                 nearest rate it supports at or below this; for soft SPI,
+                 this is an upper limit (bitbang is typically slower).
+                 Soft SPI above 500 KHz runs as fast as the pins can be
+                 toggled.
+  @note    Persists across updatePins() calls. See measureShowTime() for
+           help choosing a rate.
+*/
+void Adafruit_DotStar::setClockSpeed(uint32_t freq) {
+  if (freq == clockSpeed)
+    return;
+  waitForShow();
+  clockSpeed = freq;
+  newDevice();
+  spi_dev->begin();
+}
+
+/*!
+  @brief   Measure the time taken by show() at a given SPI clock rate,
+           for choosing the fastest rate that works reliably in a given
+           installation: e.g. step through a few rates, checking the strip
+           for glitches (show a test pattern afterward) and comparing the
+           time per frame. The current pixel data is issued to the strip.
+  @param   freq    Clock rate in Hz to measure, see setClockSpeed(). The
+                   previous rate is restored afterward.
+  @param   frames  Number of show() calls to average over (default 10).
+  @return  Average time per frame in microseconds. Divide getFrameBytes()
+           by this to get achieved throughput in bytes per microsecond.
+  @note    Every frame is issued even if dirty tracking is enabled. If an
+           output was set with setOutput(), its time is included (or, if
+           not also sending to SPI, only its time and the encoding time).
+*/
+uint32_t Adafruit_DotStar::measureShowTime(uint32_t freq, uint16_t frames) {
+  uint32_t prev = clockSpeed, t;
+  if (!frames)
+    frames = 1;
+  setClockSpeed(freq);
+  t = micros();
+  for (uint16_t i = 0; i < frames; i++) {
+    markDirty();
+    show();
+  }
+  t = (micros() - t) / frames;
+  setClockSpeed(prev);
+  return t;
+}
+
+/*!
+  @brief   Create (or re-create) the SPI device using the current pins
+           (or hardware SPI bus) and clock rate.
+*/
+void Adafruit_DotStar::newDevice(void) {
   if (spi_dev)
     delete (spi_dev);
-  spi_dev = new Adafruit_SPIDevice(-1, clock, -1, data, 8000000);
-  spi_dev->begin();
+  // Soft SPI is issued directly by softTransfer() at rates where the SPI
+  // device's own bitbang wouldn't add delays (over 500 KHz); lower rates
+  // are left to it, as they're presumably being used for a reason.
+  fastSoftSPI = (clockPin >= 0) && (clockSpeed > 500000);
+#ifdef BUSIO_USE_FAST_PINIO
+  if (clockPin >= 0) {
+    dataPort = (BusIO_PortReg *)portOutputRegister(digitalPinToPort(dataPin));
+    dataMask = digitalPinToBitMask(dataPin);
+    clockPort =
+        (BusIO_PortReg *)portOutputRegister(digitalPinToPort(clockPin));
+    clockMask = digitalPinToBitMask(clockPin);
+  }
+#endif
+  if (clockPin >= 0)
+    spi_dev = new Adafruit_SPIDevice(-1, clockPin, -1, dataPin, clockSpeed);
+  else if (spiBus)
+    spi_dev = new Adafruit_SPIDevice(-1, clockSpeed, SPI_BITORDER_MSBFIRST,
+                                     SPI_MODE0, spiBus);
+  else
+    spi_dev = new Adafruit_SPIDevice(-1, clockSpeed);
+}
+
+/*!
+  @brief   Change the length of a previously-declared Adafruit_DotStar
+           strip object. Old data is deallocated and new data is cleared.
+           Pin numbers and pixel format are unchanged.
+  @param   n  New length of strip, in pixels.
+  @note    This function is deprecated, here only for old projects that
+           may still be calling it. New projects should instead use the
+           'new' keyword. On an Adafruit_DotStarStrip with a static
+           buffer, the length is clipped to the buffer size and nothing
+           is reallocated.
+*/
+void Adafruit_DotStar::updateLength(uint16_t n) {
+  waitForShow();
+  if (fixedPixels) { // Buffer isn't ours to free, see Adafruit_DotStarStrip
+    setLength((n < fixedPixels) ? n : fixedPixels);
+    return;
+  }
+  free(pixels);
+  pixels = n ? (uint8_t *)malloc(bufferBytes(n)) : NULL;
+  setLength(pixels ? n : 0);
+}
+
+/*!
+  @brief   Return the size of the pixel buffer for a given strip length,
+           depending on pixel type.
+  @param   n  Length of strip, in pixels.
+  @return  Buffer size in bytes.
+*/
+uint32_t Adafruit_DotStar::bufferBytes(uint16_t n) const {
+  if (paletteBits) // PALETTE: 4 or 8 bits/pixel, round up
+    return ((uint32_t)n * paletteBits + 7) / 8;
+  return (rOffset == gOffset) ? (uint32_t)n + (((uint32_t)n + 3) / 4)
+                              :         // MONO: 10 bits/pixel, round up
+             (uint32_t)n * 3; // COLOR: 3 bytes/pixel
+}
+
+/*!
+  @brief   Set the pixel count once 'pixels' points to a suitably-sized
+           buffer, clearing it and discarding or resizing any other
+           per-pixel buffers to match.
+  @param   n  Length of strip, in pixels.
+*/
+void Adafruit_DotStar::setLength(uint16_t n) {
+  free(front);
+  free(levels);
+  front = NULL;
+  levels = NULL;
+  numLEDs = n;
+  clear();
+  if (frame) { // Frame buffer in use? Resize to match
+    free(frame);
+    frame = NULL;
+    setFrameBuffer(true);
+  }
+  if (dither) { // Same for dither buffer
+    free(dither);
+    dither = NULL;
+    setDithering(true);
+  }
+}
+
+/*!
+  @brief   Enable or disable the optional wire-format frame buffer. When
+           enabled, show() builds the complete APA102 data stream (start
+           frame, pixel data, end frame) in RAM and issues it to the SPI
+           device as a single bulk transfer, which allows DMA-capable SPI
+           implementations to move the whole frame without per-chunk
+           overhead. When disabled (the default), show() encodes and sends
+           DOTSTAR_CHUNK_PIXELS pixels at a time from a small stack buffer.
+  @param   enable  true to allocate the frame buffer, false to release it.
+  @return  true on success, false if the frame buffer could not be
+           allocated (show() will continue to work in chunked mode).
+  @note    The frame buffer costs getFrameBytes() of RAM on top of the
+           3 bytes per pixel already used, so this is mostly of interest
+           on boards with RAM to spare and very long strips. The encoded
+           frame is kept between show() calls, so with dirty tracking
+           (setDirtyTracking()) only pixels changed since the last frame
+           are encoded again.
+*/
+bool Adafruit_DotStar::setFrameBuffer(bool enable) {
+  if (!enable) {
+    free(frame);
+    frame = NULL;
+    return true;
+  }
+  if (!frame) {
+    frame = (uint8_t *)malloc(getFrameBytes());
+    frameValid = false;
+  }
+  return frame != NULL;
+}
+
+/*!
+  @brief   Return the number of bytes issued over SPI by each call to
+           show(), including start and end frames.
+  @return  Wire frame size in bytes.
+*/
+uint32_t Adafruit_DotStar::getFrameBytes(void) const {
+  return 4 + (uint32_t)numLEDs * 4 + ((uint32_t)numLEDs + 15) / 16;
+}
+
+// SPI STUFF ---------------------------------------------------------------
+
+/* ISSUE DATA TO LED STRIP -------------------------------------------------
+
+  The LED driver has an additional per-pixel 5-bit brightness setting,
+  which is NOT used by default. On APA102, the normally very fast PWM is
+  gated through a much slower PWM (about 400 Hz), rendering it useless for
+  POV or other high-speed things that are probably why one is using
+  DotStars instead of NeoPixels in the first place. Some APA102 clones
+  (e.g. SK9822) use current control rather than PWM for this, which is
+  much more worthwhile, so it's available as an opt-in: see
+  setHardwareBrightness() and setPixelBrightness(). Otherwise the header
+  byte is always 0xFF (full) and brightness is applied by scaling the
+  color bytes.
+*/
+
+/*!
+  @brief   Encode pixels into APA102 wire format (0xFF header byte plus
+           brightness-scaled color bytes in device-native order).
+  @param   out     Destination, must have room for count * 4 bytes.
+  @param   src     Source pixel buffer, in the strip's pixel format.
+  @param   first   Index of first pixel to encode.
+  @param   count   Number of pixels to encode.
+  @param   bright  Brightness as stored in the brightness member.
+*/
+void Adafruit_DotStar::encode(uint8_t *out, const uint8_t *src,
+                              uint16_t first, uint16_t count,
+                              uint8_t bright) const {
+  if (paletteBits) {
+    // Expand palette indices to 3-byte colors a chunk at a time, then
+    // encode those same as a regular strip.
+    uint8_t rgb[DOTSTAR_CHUNK_PIXELS * 3], *p;
+    uint16_t i, n;
+    while (count) {
+      n = (count > DOTSTAR_CHUNK_PIXELS) ? DOTSTAR_CHUNK_PIXELS : count;
+      for (p = rgb, i = first; i < first + n; i++, p += 3)
+        memcpy(p, &palette[indexGet(src, i) * 3], 3);
+      encodeRGB(out, rgb, levels ? &levels[first] : NULL,
+                dither ? &dither[first * 3] : NULL, n, bright);
+      out += n * 4;
+      first += n;
+      count -= n;
+    }
+    return;
+  }
+
+  if (rOffset != gOffset) { // Color
+    encodeRGB(out, &src[first * 3], levels ? &levels[first] : NULL,
+              dither ? &dither[first * 3] : NULL, count, bright);
+    return;
+  }
+
+  uint16_t b16 = (uint16_t)bright; // Type-convert for fixed-point math
+  const uint8_t *lvl = levels ? &levels[first] : NULL;
+  uint8_t l, g5 = 31; // Global 5-bit level
+
+  if (hwBrightness) {
+    if (bright)
+      g5 = (b16 * 31 + 128) >> 8;
+    b16 = 0; // Color bytes are issued unscaled
+  }
+
+  // MONO: single-color strips use the same driver chip as RGB, its three
+  // channels all driving same-color LEDs. Each 10-bit level (0-1023) is
+  // mapped to 0-765 and spread across the three 8-bit channels (e.g.
+  // 403 -> 301 -> 101,100,100), giving 766 distinct output steps rather
+  // than 256. If only one channel were connected, it'd still be within
+  // 1 LSB of the 8-bit equivalent.
+  uint32_t v;
+  uint16_t t;
+  uint8_t base, rem;
+  for (uint16_t i = first, end = first + count; i < end; i++) {
+    v = monoGet(src, i);
+    if (b16)
+      v = (v * b16) >> 8;
+    t = (v * 49008 + 32704) >> 16; // 0-1023 -> 0-765, rounded
+    base = (t * 683) >> 11;        // t / 3 (exact for 0-765)
+    rem = t - base * 3;
+    l = lvl ? (*lvl++ * (g5 + 1)) >> 5 : g5;
+    out[0] = 0xE0 | l;
+    out[1] = base + (rem > 0);
+    out[2] = base + (rem > 1);
+    out[3] = base;
+    out += 4;
+  }
+}
+
+/*!
+  @brief   Encode 3-byte-per-pixel color data into APA102 wire format,
+           see encode().
+  @param   out     Destination, must have room for count * 4 bytes.
+  @param   ptr     Color data for first pixel onward, 3 bytes per pixel.
+  @param   lvl     Per-pixel 5-bit brightness for first pixel onward, or
+                   NULL if not used.
+  @param   err     Dither remainders for first pixel onward (3 bytes per
+                   pixel, updated here), or NULL if not dithering.
+  @param   count   Number of pixels to encode.
+  @param   bright  Brightness as stored in the brightness member.
+*/
+void Adafruit_DotStar::encodeRGB(uint8_t *out, const uint8_t *ptr,
+                                 const uint8_t *lvl, uint8_t *err,
+                                 uint16_t count, uint8_t bright) const {
+  uint16_t b16 = (uint16_t)bright; // Type-convert for fixed-point math
+  uint8_t l, g5 = 31;              // Global 5-bit level
+
+  if (hwBrightness) {
+    if (bright)
+      g5 = (b16 * 31 + 128) >> 8;
+    b16 = 0; // Color bytes are issued unscaled
+  }
+
+  if (lut) { // Fused brightness/gamma/white balance, see updateLUT()
+    const uint8_t *t1 = lut + lutStride, *t2 = t1 + lutStride;
+    while (count--) {
+      l = lvl ? (*lvl++ * (g5 + 1)) >> 5 : g5;
+      out[0] = 0xE0 | l; // 0xFF if 5-bit brightness not in use
+      out[1] = lut[ptr[0]];
+      out[2] = t1[ptr[1]];
+      out[3] = t2[ptr[2]];
+      out += 4;
+      ptr += 3;
+    }
+    return;
+  }
+
+  if (err && b16) { // Temporal dithering, see setDithering()
+    // Each channel is scaled to 16 bits and the previous frame's
+    // remainder added before taking the upper byte; the new remainder
+    // (lower byte) is kept for next time.
+    uint16_t x;
+    while (count--) {
+      l = lvl ? (*lvl++ * (g5 + 1)) >> 5 : g5;
+      out[0] = 0xE0 | l; // 0xFF if 5-bit brightness not in use
+      x = ptr[0] * b16 + err[0];
+      out[1] = x >> 8;
+      err[0] = x;
+      x = ptr[1] * b16 + err[1];
+      out[2] = x >> 8;
+      err[1] = x;
+      x = ptr[2] * b16 + err[2];
+      out[3] = x >> 8;
+      err[2] = x;
+      out += 4;
+      ptr += 3;
+      err += 3;
+    }
+    return;
+  }
+
+  if (hwBrightness || lvl) { // Using the 5-bit header field
+    while (count--) {
+      l = lvl ? (*lvl++ * (g5 + 1)) >> 5 : g5;
+      out[0] = 0xE0 | l; // Pixel start + brightness
+      if (b16) {
+        out[1] = (ptr[0] * b16) >> 8;
+        out[2] = (ptr[1] * b16) >> 8;
+        out[3] = (ptr[2] * b16) >> 8;
+      } else {
+        out[1] = ptr[0];
+        out[2] = ptr[1];
+        out[3] = ptr[2];
+      }
+      out += 4;
+      ptr += 3;
+    }
+    return;
+  }
+
+  if (bright) {       // Scale pixel brightness on output
+    while (count--) { // For each pixel...
+      out[0] = 0xFF;  //  Pixel start
+      out[1] = (ptr[0] * b16) >> 8;
+      out[2] = (ptr[1] * b16) >> 8;
+      out[3] = (ptr[2] * b16) >> 8;
+      out += 4;
+      ptr += 3;
+    }
+  } else {             // Full brightness (no scaling)
+    while (count--) {  // For each pixel...
+      out[0] = 0xFF;   //  Pixel start
+      out[1] = ptr[0]; // R,G,B
+      out[2] = ptr[1];
+      out[3] = ptr[2];
+      out += 4;
+      ptr += 3;
+    }
+  }
+}
+
+/*!
+  @brief   Issue encoded data to the SPI device and/or output set with
+           setOutput(). Must be called within an SPI transaction.
+  @param   buf  Data to send. Contents are undefined afterward, as
+                Adafruit_SPIDevice::transfer() overwrites it.
+  @param   len  Number of bytes to send.
+*/
+void Adafruit_DotStar::transmit(uint8_t *buf, uint32_t len) {
+  if (output) {
+    output->write(buf, len);
+    if (!outputSPI)
+      return;
+  }
+  if (fastSoftSPI)
+    softTransfer(buf, len);
+  else
+    spi_dev->transfer(buf, len);
+}
+
+/*!
+  @brief   Issue the whole-frame buffer (see setFrameBuffer()), leaving it
+           intact: Adafruit_SPIDevice::write() is used rather than
+           transfer(), which would overwrite it with incoming data. Unlike
+           transmit(), this must NOT be called within an SPI transaction,
+           write() begins and ends its own.
+*/
+void Adafruit_DotStar::sendFrame(void) {
+  uint32_t len = getFrameBytes();
+  if (output) {
+    output->write(frame, len);
+    if (!outputSPI)
+      return;
+  }
+  if (fastSoftSPI)
+    softTransfer(frame, len);
+  else
+    spi_dev->write(frame, len);
+}
+
+/*!
+  @brief   Clock out data on the soft SPI pins directly, rather than
+           through Adafruit_SPIDevice's general-purpose bitbang transfer.
+           Used when the clock rate is high enough that the SPI device
+           wouldn't insert delays anyway (see newDevice()).
+  @param   buf  Data to send (left unchanged).
+  @param   len  Number of bytes to send.
+*/
+void Adafruit_DotStar::softTransfer(const uint8_t *buf, uint32_t len) {
+  uint8_t b, bit;
+#ifdef BUSIO_USE_FAST_PINIO
+  if (dataPort == clockPort) {
+    // Data and clock on the same port: one write sets the data bit (and
+    // drops the clock), a second raises the clock. Port state is sampled
+    // once per byte, with interrupts held off until the byte is out so an
+    // interrupt handler changing other pins on the port isn't undone by
+    // the stale copy. The bits are unrolled.
+    BusIO_PortMask lo, hi, x;
+    while (len--) {
+      b = *buf++;
+      noInterrupts();
+      lo = *clockPort & ~(dataMask | clockMask);
+      hi = lo | dataMask;
+      x = (b & 0x80) ? hi : lo;
+      *clockPort = x;
+      *clockPort = x | clockMask;
+      x = (b & 0x40) ? hi : lo;
+      *clockPort = x;
+      *clockPort = x | clockMask;
+      x = (b & 0x20) ? hi : lo;
+      *clockPort = x;
+      *clockPort = x | clockMask;
+      x = (b & 0x10) ? hi : lo;
+      *clockPort = x;
+      *clockPort = x | clockMask;
+      x = (b & 0x08) ? hi : lo;
+      *clockPort = x;
+      *clockPort = x | clockMask;
+      x = (b & 0x04) ? hi : lo;
+      *clockPort = x;
+      *clockPort = x | clockMask;
+      x = (b & 0x02) ? hi : lo;
+      *clockPort = x;
+      *clockPort = x | clockMask;
+      x = (b & 0x01) ? hi : lo;
+      *clockPort = x;
+      *clockPort = x | clockMask; // Dropped by next byte's first write
+      if (!len)
+        *clockPort = x; // Or here, after the last byte
+      interrupts();
+    }
+    return;
+  }
+#endif
+  // Otherwise the data pin is only written when the bit changes, which
+  // for long runs of 0xFF (headers, end frame) or 0x00 saves most writes.
+  uint8_t prev = 2; // Data pin state unknown
+  while (len--) {
+    b = *buf++;
+    for (bit = 0x80; bit; bit >>= 1) {
+      if ((b & bit ? 1 : 0) != prev) {
+        prev = (b & bit) ? 1 : 0;
+#ifdef BUSIO_USE_FAST_PINIO
+        if (prev)
+          *dataPort |= dataMask;
+        else
+          *dataPort &= ~dataMask;
+#else
+        digitalWrite(dataPin, prev);
+#endif
+      }
+#ifdef BUSIO_USE_FAST_PINIO
+      *clockPort |= clockMask;
+      *clockPort &= ~clockMask;
+#else
+      digitalWrite(clockPin, HIGH);
+      digitalWrite(clockPin, LOW);
+#endif
+    }
+  }
+}
+
+/*!
+  @brief   Send wire-format data to a Print object (e.g. Serial, a file,
+           or an in-memory Adafruit_DotStarCapture) instead of, or in
+           addition to, the SPI device. Everything show(), showAsync() and
+           poll() would issue -- start frame, pixel data, end frame -- is
+           written, and the Print's flush() function is called after each
+           complete frame. This permits byte-for-byte verification and
+           profiling of output without DotStars or even SPI hardware.
+  @param   out  Pointer to Print object, or NULL to resume normal output
+                to SPI only.
+  @param   spi  If true, data is also issued to the SPI device (a 'tap'),
+                if false (default) only to the Print object.
+*/
+void Adafruit_DotStar::setOutput(Print *out, bool spi) {
+  waitForShow();
+  output = out;
+  outputSPI = spi;
+  touch(0, numLEDs); // New destination hasn't seen the current pixels
+}
+
+/*!
+  @brief   Issue the end frame, using a caller-provided scratch buffer.
+           Must be called within an SPI transaction.
+  @param   buf    Scratch buffer.
+  @param   size   Size of scratch buffer in bytes.
+  @param   count  Number of pixels issued in this frame.
+*/
+void Adafruit_DotStar::endFrame(uint8_t *buf, uint16_t size,
+                                uint32_t count) {
+  // Four end-frame bytes are seemingly indistinguishable from a white
+  // pixel, and empirical testing suggests it can be left out...but it's
+  // always a good idea to follow the datasheet, in case future hardware
+  // revisions are more strict (e.g. might mandate use of end-frame
+  // before start-frame marker). i.e. let's not remove this. But after
+  // testing a bit more the suggestion is to use at least (numLeds+1)/2
+  // high values (1) or (numLeds+15)/16 full bytes as EndFrame. For details
+  // see also:
+  // https://cpldcpu.wordpress.com/2014/11/30/understanding-the-apa102-superled/
+  uint32_t n, endBytes = (count + 15) / 16;
+  while (endBytes) {
+    n = (endBytes > size) ? size : endBytes;
+    memset(buf, 0xFF, n);
+    transmit(buf, n);
+    endBytes -= n;
+  }
+}
+
+/*!
+  @brief   Transmit pixel data in RAM to DotStars. If a showAsync() frame
+           is still in progress, it is completed first.
+*/
+void Adafruit_DotStar::show(void) {
+  if (!pixels)
+    return;
+
+  waitForShow();
+
+  if (dirtyTracking && !dither && !isDirty()) {
+    framesSkipped++;
+    return;
+  }
+  uint16_t first = dirtyFirst, end = dirtyEnd;
+  dirtyFirst = numLEDs; // Mark clean
+  dirtyEnd = 0;
+  uint8_t prev = frameBrightness, bright = limitBrightness();
+
+  if (frame) {
+    // Whole frame is assembled in RAM and issued in one bulk transfer.
+    // The frame is left intact by sendFrame(), so with dirty tracking
+    // (whose rules cover every change that affects encoding) only the
+    // changed span need be re-encoded -- unless the brightness differs
+    // (power limit), dithering changes every pixel, or something other
+    // than show() issued the last frame.
+    if (!dirtyTracking || !frameValid || dither || (bright != prev)) {
+      memset(frame, 0x00, 4); // [START FRAME]
+      memset(&frame[4 + (uint32_t)numLEDs * 4], 0xFF,
+             ((uint32_t)numLEDs + 15) / 16); // [END FRAME]
+      first = 0;
+      end = numLEDs;
+    }
+    if (first < end) { // [PIXEL DATA]
+      encode(&frame[4 + (uint32_t)first * 4], pixels, first, end - first,
+             bright);
+      pixelsEncoded += end - first;
+    }
+    frameValid = true;
+    sendFrame();
+  } else {
+    pixelsEncoded += numLEDs;
+    // Begin transaction, setting SPI frequency
+    spi_dev->beginTransaction();
+
+    uint8_t buf[DOTSTAR_CHUNK_PIXELS * 4];
+    uint16_t i, n;
+
+    // [START FRAME]
+    memset(buf, 0x00, 4);
+    transmit(buf, 4);
+
+    // [PIXEL DATA]
+    for (i = 0; i < numLEDs; i += n) {
+      n = numLEDs - i;
+      if (n > DOTSTAR_CHUNK_PIXELS)
+        n = DOTSTAR_CHUNK_PIXELS;
+      encode(buf, pixels, i, n, bright);
+      transmit(buf, n * 4);
+    }
+
+    // [END FRAME]
+    endFrame(buf, sizeof(buf), numLEDs);
+
+    // Finish SPI transaction
+    spi_dev->endTransaction();
+  }
+
+  if (output)
+    output->flush(); // Mark end of frame
+}
+
+/*!
+  @brief   Transmit pixels generated on the fly to DotStars, rather than
+           from the pixel buffer. A source function is called to produce
+           pixel colors DOTSTAR_CHUNK_PIXELS at a time, each chunk being
+           encoded and issued before the next is requested, so only a
+           small stack buffer is used regardless of strip length. This
+           suits POV displays and strips longer than would fit in RAM
+           (construct with length 0 to have no pixel buffer at all), and
+           data starts going out to the strip almost immediately.
+  @param   source  Function called with this strip, the index of the first
+                   pixel in the chunk, an array to fill in, and the number
+                   of pixels to fill, as 32-bit 'packed' RGB values (e.g.
+                   0x00RRGGBB) in pixel order.
+  @param   n       Number of pixels to issue. 0 (default) for the strip
+                   length, numPixels().
+  @note    Brightness, gamma correction and white balance apply as with
+           show(). Per-pixel brightness and dithering apply only to
+           chunks within numPixels(). The power limit (setPowerLimit())
+           does NOT: it's estimated from the pixel buffer, which these
+           colors never pass through, so getFrameBrightness() reads
+           getBrightness() and getFramePower() still refers to the last
+           buffered frame. The pixel buffer is left as-is, dirty tracking
+           does not skip these frames, and the next show() issues the
+           buffer even if nothing in it changed. Not supported on
+           DOTSTAR_MONO strips (nothing is issued).
+*/
+void Adafruit_DotStar::show(void (*source)(Adafruit_DotStar *, uint16_t,
+                                           uint32_t *, uint16_t),
+                            uint16_t n) {
+  if (rOffset == gOffset)
+    return;
+
+  waitForShow();
+  if (!n)
+    n = numLEDs;
+
+  uint32_t colors[DOTSTAR_CHUNK_PIXELS], c;
+  uint8_t buf[DOTSTAR_CHUNK_PIXELS * 4], *rgb = (uint8_t *)colors;
+  uint16_t i, j, count;
+  bool state; // Use per-pixel brightness & dither state?
+
+  frameBrightness = brightness; // Not power-limited, see above
+  useLUT(brightness);
+  spi_dev->beginTransaction();
+
+  // [START FRAME]
+  memset(buf, 0x00, 4);
+  transmit(buf, 4);
+
+  // [PIXEL DATA]
+  for (i = 0; i < n; i += count) {
+    count = n - i;
+    if (count > DOTSTAR_CHUNK_PIXELS)
+      count = DOTSTAR_CHUNK_PIXELS;
+    (*source)(this, i, colors, count);
+    // Convert to native order in place; pixel j's 3 bytes never reach
+    // past colors[j], so no color is overwritten before it's read.
+    for (j = 0; j < count; j++) {
+      c = colors[j];
+      rgb[j * 3 + rOffset] = (uint8_t)(c >> 16);
+      rgb[j * 3 + gOffset] = (uint8_t)(c >> 8);
+      rgb[j * 3 + bOffset] = (uint8_t)c;
+    }
+    state = (i + count) <= numLEDs;
+    encodeRGB(buf, rgb, (state && levels) ? &levels[i] : NULL,
+              (state && dither) ? &dither[i * 3] : NULL, count, brightness);
+    transmit(buf, count * 4);
+  }
+  pixelsEncoded += n;
+
+  endFrame(buf, sizeof(buf), n); // [END FRAME]
+
+  spi_dev->endTransaction();
+  if (output)
+    output->flush(); // Mark end of frame
+  touchSpan(0, numLEDs); // Strip no longer shows the buffer
+}
+
+/*!
+  @brief   Transmit a frame that's already in DotStar wire format, start
+           frame to end frame, e.g. one baked ahead of time and played by
+           Adafruit_DotStarPlayer. Nothing is encoded: the pixel buffer,
+           brightness, gamma and other output settings don't apply, the
+           data is issued exactly as given. The next show() issues the
+           pixel buffer even if nothing in it changed.
+  @param   frame  Wire-format data, left unchanged.
+  @param   len    Length of data in bytes.
+*/
+void Adafruit_DotStar::showEncoded(const uint8_t *frame, uint32_t len) {
+  uint8_t buf[DOTSTAR_CHUNK_PIXELS * 4];
+  uint32_t n;
+
+  waitForShow();
+  spi_dev->beginTransaction();
+  // transmit() may overwrite its buffer with incoming SPI data, so the
+  // frame goes out through a small copy, a chunk at a time.
+  for (; len; len -= n, frame += n) {
+    n = (len > sizeof(buf)) ? sizeof(buf) : len;
+    memcpy(buf, frame, n);
+    transmit(buf, n);
+  }
+  spi_dev->endTransaction();
+  if (output)
+    output->flush(); // Mark end of frame
+  touchSpan(0, numLEDs); // Strip no longer shows the buffer
+}
+
+/*!
+  @brief   Begin transmitting pixel data to DotStars without waiting for
+           it to finish. The current pixel buffer and brightness are copied
+           to a second (front) buffer, so the sketch can immediately begin
+           drawing the next frame with setPixelColor() etc. while this one
+           is issued a few pixels at a time by subsequent calls to poll()
+           (or isBusy() loops, waitForShow(), or the next show()).
+  @return  true if the frame was started, false if the second buffer could
+           not be allocated -- in which case the frame is issued with a
+           regular blocking show() instead.
+  @note    If a previous frame is still in progress, it's completed first.
+           If dirty tracking is enabled and nothing has changed, no frame
+           is started (the callback is still invoked) and true is returned.
+           This doubles pixel RAM use.
+           Per-pixel brightness levels (setPixelBrightness()) are not
+           double-buffered, they're read as each chunk is issued.
+           Frames started here are always issued in chunks of
+           DOTSTAR_CHUNK_PIXELS, the frame buffer (if any) is not used.
+           Other devices must not use the SPI bus mid-frame, though it's
+           released between calls to poll().
+*/
+bool Adafruit_DotStar::showAsync(void) {
+  if (!pixels)
+    return false;
+
+  waitForShow();
+
+  if (dirtyTracking && !dither && !isDirty()) {
+    framesSkipped++;
+    if (showCallback)
+      (*showCallback)(this);
+    return true;
+  }
+
+  if (!front && !(front = (uint8_t *)malloc(bufferBytes(numLEDs)))) {
+    show(); // No RAM for front buffer, do it the old way
+    if (showCallback)
+      (*showCallback)(this);
+    return false;
+  }
+
+  memcpy(front, pixels, bufferBytes(numLEDs));
+  frontBrightness = limitBrightness();
+  dirtyFirst = numLEDs; // Mark clean
+  dirtyEnd = 0;
+  frameValid = false; // Changes since the last show() aren't in frame
+  sendPos = 0;
+  busy = true;
+
+  // [START FRAME]
+  uint8_t buf[4] = {0x00, 0x00, 0x00, 0x00};
+  spi_dev->beginTransaction();
+  transmit(buf, 4);
+  spi_dev->endTransaction();
+
+  poll(); // Get the first pixels going right away
+  return true;
+}
+
+/*!
+  @brief   Issue the next DOTSTAR_CHUNK_PIXELS pixels of a frame started
+           with showAsync(). Call this frequently between rendering steps
+           to overlap rendering of the next frame with output of this one.
+  @return  true if the frame is still in progress, false if complete (or
+           if no showAsync() frame was pending).
+*/
+bool Adafruit_DotStar::poll(void) {
+  if (!busy)
+    return false;
+
+  uint8_t buf[DOTSTAR_CHUNK_PIXELS * 4];
+  uint16_t n = numLEDs - sendPos;
+  if (n > DOTSTAR_CHUNK_PIXELS)
+    n = DOTSTAR_CHUNK_PIXELS;
+
+  spi_dev->beginTransaction();
+  encode(buf, front, sendPos, n, frontBrightness); // [PIXEL DATA]
+  transmit(buf, n * 4);
+  pixelsEncoded += n;
+  if ((sendPos += n) >= numLEDs) {
+    endFrame(buf, sizeof(buf), numLEDs); // [END FRAME]
+    busy = false;
+  }
+  spi_dev->endTransaction();
+  if (!busy && output)
+    output->flush(); // Mark end of frame
+
+  if (!busy && showCallback)
+    (*showCallback)(this);
+
+  return busy;
+}
+
+/*!
+  @brief   Block until any frame started with showAsync() has been
+           completely issued to the strip.
+*/
+void Adafruit_DotStar::waitForShow(void) {
+  while (poll())
+    ;
+}
+
+/*!
+  @brief   Enable or disable dirty tracking. When enabled, show() and
+           showAsync() return immediately without issuing any data if
+           neither the pixels nor the brightness have changed since the
+           prior frame (as far as the library can tell -- see markDirty()).
+           Useful for sketches that call show() every pass through loop()
+           but only occasionally change anything.
+  @param   enable  true to enable, false (the default) to always issue data.
+  @note    Changes are noticed through setPixelColor(), fill(), clear(),
+           rainbow(), setBrightness() and updateLength(). Sketches that
+           write directly to the getPixels() buffer must call markDirty().
+           With a frame buffer (setFrameBuffer()), show() also re-encodes
+           only the changed pixels. updatePins() and setOutput() mark
+           every pixel changed, as the next frame goes somewhere new.
+*/
+void Adafruit_DotStar::setDirtyTracking(bool enable) {
+  dirtyTracking = enable;
+  markDirty(); // Start out with a full frame
+}
+
+/*!
+  @brief   Flag a range of pixels as changed, so the next show() won't be
+           skipped when dirty tracking is enabled. Only needed when
+           writing directly to the getPixels() buffer.
+  @param   first  Index of first changed pixel, starting from 0. 0 if
+                  unspecified.
+  @param   count  Number of changed pixels. Passing 0 or leaving
+                  unspecified flags through the end of the strip.
+*/
+void Adafruit_DotStar::markDirty(uint16_t first, uint16_t count) {
+  if (first >= numLEDs)
+    return;
+  uint16_t end = (count && (count < numLEDs - first)) ? first + count : numLEDs;
+  touch(first, end);
+}
+
+/*!
+  @brief   Reset the getFramesSkipped(), getPixelsEncoded() and
+           getFramesLimited() counters to zero. This is done automatically
+           by begin().
+*/
+void Adafruit_DotStar::resetCounters(void) {
+  framesSkipped = 0;
+  pixelsEncoded = 0;
+  framesLimited = 0;
+}
+
+/*!
+  @brief   Set up a model of the strip's current draw, for
+           getPowerEstimate() and setPowerLimit(). Current is estimated as
+           each pixel's idle current plus, per color channel, a current
+           per step of its value after global brightness. The per-channel
+           sums this needs are kept up to date as pixels change, so an
+           estimate is normally O(1) rather than a scan of the buffer.
+  @param   red    Current per step of red (of 255), in microamps. For a
+                  typical APA102 strip, about 78 (20 mA at full), but
+                  measure yours.
+  @param   green  Current per step of green, in microamps.
+  @param   blue   Current per step of blue, in microamps.
+  @param   idle   Current per pixel when dark, in microamps (e.g. 1000).
+  @note    All 0 disables the model (the default). Per-pixel brightness,
+           gamma correction, white balance and output tables aren't
+           modeled, each of which only lowers the real current, so the
+           estimate errs on the high side. setPixelColor(), fill() and
+           clear() update the sums as they go; most other changes to
+           pixels cause a rescan at the next estimate, as do writes to the
+           getPixels() buffer followed by markDirty().
+*/
+void Adafruit_DotStar::setPowerModel(uint16_t red, uint16_t green,
+                                     uint16_t blue, uint16_t idle) {
+  powerStep[0] = red;
+  powerStep[1] = green;
+  powerStep[2] = blue;
+  powerIdle = idle;
+  powerModel = red || green || blue || idle;
+  powerCounted = false;
+  framePower = 0;
+}
+
+/*!
+  @brief   Recount the per-channel sums of the power estimate from the
+           pixel buffer.
+*/
+void Adafruit_DotStar::countPower(void) {
+  powerSum[0] = powerSum[1] = powerSum[2] = 0;
+  if (!pixels)
+    return;
+  if (paletteBits || (rOffset == gOffset)) { // PALETTE or MONO
+    for (uint16_t i = 0; i < numLEDs; i++) {
+      uint32_t c = getPixelColor(i);
+      powerSum[0] += (uint8_t)(c >> 16);
+      powerSum[1] += (uint8_t)(c >> 8);
+      powerSum[2] += (uint8_t)c;
+    }
+  } else {
+    for (const uint8_t *p = pixels; p < &pixels[numLEDs * 3]; p += 3) {
+      powerSum[0] += p[rOffset];
+      powerSum[1] += p[gOffset];
+      powerSum[2] += p[bOffset];
+    }
+  }
+  powerCounted = true;
+}
+
+/*!
+  @brief   Estimate the strip's current draw at a given brightness.
+  @param   scale  Brightness, 1-256 (256 = full).
+  @return  Estimate in microamps.
+*/
+uint64_t Adafruit_DotStar::powerAt(uint16_t scale) {
+  if (!powerCounted)
+    countPower();
+  uint64_t color = (uint64_t)powerSum[0] * powerStep[0] +
+                   (uint64_t)powerSum[1] * powerStep[1] +
+                   (uint64_t)powerSum[2] * powerStep[2];
+  return ((color * scale) >> 8) + (uint32_t)numLEDs * powerIdle;
+}
+
+/*!
+  @brief   Estimate the strip's current draw with its present pixels and
+           brightness setting (before any power limit), see
+           setPowerModel().
+  @return  Estimate in milliamps, rounded up; 0 if there's no power model.
+*/
+uint32_t Adafruit_DotStar::getPowerEstimate(void) {
+  if (!powerModel)
+    return 0;
+  return (powerAt(brightness ? brightness : 256) + 999) / 1000;
+}
+
+/*!
+  @brief   Work out the brightness to issue a frame at, lowered if needed
+           to keep within the power limit, and record the frame metrics.
+           The output lookup table, if any, is refilled to match. Called
+           once per frame by show() and showAsync().
+  @return  Brightness, as stored in the brightness member.
+*/
+uint8_t Adafruit_DotStar::limitBrightness(void) {
+  if (!powerModel)
+    return limitBrightness(0, 0);
+  uint64_t idle = (uint64_t)numLEDs * powerIdle;
+  return limitBrightness(powerAt(256) - idle, idle);
+}
+
+/*!
+  @brief   Work out the brightness to issue a frame at, as above, from a
+           power estimate worked out by the caller (for strips that don't
+           use the pixel buffer, e.g. Adafruit_DotStarLarge).
+  @param   color  Current of the color channels at full brightness, in
+                  microamps (ignored without a power model).
+  @param   idle   Idle current of all pixels, in microamps.
+  @return  Brightness, as stored in the brightness member.
+*/
+uint8_t Adafruit_DotStar::limitBrightness(uint64_t color, uint64_t idle) {
+  uint8_t bright = brightness;
+  if (powerModel) {
+    // Current follows the level actually issued: brightness/256 of the
+    // color bytes, or with hardware brightness the 5-bit header level
+    // (out of 31) that encode() rounds it to.
+    uint32_t steps = hwBrightness ? 31 : 256, level = bright ? bright : 256;
+    if (hwBrightness)
+      level = bright ? (level * 31 + 128) >> 8 : 31;
+    uint64_t ua = color * level / steps + idle,
+             limit = (uint64_t)powerLimit * 1000;
+    if (powerLimit && (ua > limit)) {
+      // Scale the color part of the current down to fit what the idle
+      // current leaves of the budget (or as far as it goes, if nothing),
+      // rounding down so the level issued stays within it.
+      uint64_t fit = (limit > idle) ? (limit - idle) * steps / color : 0;
+      if (hwBrightness) {
+        level = fit; // 0-30; bright maps back to it exactly in encode()
+        bright = level ? level * 256 / 31 : 1;
+      } else {
+        level = fit ? fit : 1;
+        bright = level;
+      }
+      ua = color * level / steps + idle;
+      framesLimited++;
+    }
+    framePower = (ua + 999) / 1000;
+  }
+  frameBrightness = bright;
+  useLUT(bright);
+  return bright;
+}
+
+/*!
+  @brief   Fill the whole DotStar strip with 0 / black / off.
+  @note    In palette mode, every pixel is set to index 0, which shows
+           whatever color that palette entry holds.
+*/
+void Adafruit_DotStar::clear() {
+  if (!pixels)
+    return;
+  touchSpan(0, numLEDs);
+  memset(pixels, 0, bufferBytes(numLEDs));
+  // Every pixel is now the same color, so the power sums are just that
+  uint32_t c = paletteBits ? getPaletteColor(0) : 0;
+  powerSum[0] = (uint32_t)numLEDs * (uint8_t)(c >> 16);
+  powerSum[1] = (uint32_t)numLEDs * (uint8_t)(c >> 8);
+  powerSum[2] = (uint32_t)numLEDs * (uint8_t)c;
+  powerCounted = powerModel;
+}
+
+/*!
+  @brief   Set a pixel's color using separate red, green and blue components.
+  @param   n  Pixel index, starting from 0.
+  @param   r  Red brightness, 0 = minimum (off), 255 = maximum.
+  @param   g  Green brightness, 0 = minimum (off), 255 = maximum.
+  @param   b  Blue brightness, 0 = minimum (off), 255 = maximum.
+*/
+void Adafruit_DotStar::setPixelColor(uint16_t n, uint8_t r, uint8_t g,
+                                     uint8_t b) {
+  if (n < numLEDs) {
+    if (paletteBits || (rOffset == gOffset)) { // PALETTE or MONO
+      setPixelColor(n, Color(r, g, b));
+      return;
+    }
+    uint8_t *p = &pixels[n * 3];
+    recount(p, r, g, b);
+    touchSpan(n, n + 1);
+    p[rOffset] = r;
+    p[gOffset] = g;
+    p[bOffset] = b;
+  }
+}
+
+/*!
+  @brief   Set a pixel's color using a 32-bit 'packed' RGB value.
+  @param   n  Pixel index, starting from 0.
+  @param   c  32-bit color value. Most significant byte is 0, second is
+              red, then green, and least significant byte is blue.
+              e.g. 0x00RRGGBB
+  @note    On DOTSTAR_MONO strips, the largest of the R, G and B
+           components sets the pixel's level. See also setPixelLevel().
+           In palette mode, the closest palette color is used (which
+           takes a search of the palette, setPixelIndex() is faster).
+*/
+void Adafruit_DotStar::setPixelColor(uint16_t n, uint32_t c) {
+  if (n < numLEDs) {
+    if (paletteBits) { // PALETTE
+      touch(n, n + 1);
+      indexSet(n, paletteIndex(c));
+      return;
+    }
+    if (rOffset == gOffset) { // MONO
+      touch(n, n + 1);
+      monoSet(n, monoLevel(c));
+      return;
+    }
+    uint8_t *p = &pixels[n * 3];
+    recount(p, (uint8_t)(c >> 16), (uint8_t)(c >> 8), (uint8_t)c);
+    touchSpan(n, n + 1);
+    p[rOffset] = (uint8_t)(c >> 16);
+    p[gOffset] = (uint8_t)(c >> 8);
+    p[bOffset] = (uint8_t)c;
+  }
+}
+
+/*!
+  @brief   Fill all or part of the DotStar strip with a color.
+  @param   c      32-bit color value. Most significant byte is 0, second
+                  is red, then green, and least significant byte is blue.
+                  e.g. 0x00RRGGBB. If all arguments are unspecified, this
+                  will be 0 (off).
+  @param   first  Index of first pixel to fill, starting from 0. 0 if
+                  unspecified.
+  @param   count  Number of pixels to fill, as a positive value. Passing
+                  0 or leaving unspecified will fill to end of strip.
+                  Clipped at end of strip.
+*/
+void Adafruit_DotStar::fill(uint32_t c, uint16_t first, uint16_t count) {
+  uint16_t end;
+
+  if (first >= numLEDs) {
+    return; // If first LED is past end of strip, nothing to do
+  }
+
+  // Calculate the index ONE AFTER the last pixel to fill
+  if ((count == 0) || (count > numLEDs - first)) {
+    // Fill to end of strip
+    end = numLEDs;
+  } else {
+    end = first + count;
+  }
+
+  if (paletteBits) { // PALETTE
+    uint8_t i = paletteIndex(c);
+    touch(first, end);
+    if (paletteBits == 4) { // Two pixels per byte; do odd ends singly
+      if (first & 1)
+        indexSet(first++, i);
+      if ((end & 1) && (first < end))
+        indexSet(--end, i);
+      i |= i << 4;
+      first >>= 1;
+      end >>= 1;
+    }
+    if (first < end)
+      memset(&pixels[first], i, end - first);
+    return;
+  }
+
+  if (rOffset == gOffset) { // MONO
+    uint16_t v = monoLevel(c);
+    touch(first, end);
+    memset(&pixels[first], v >> 2, end - first); // Upper 8 bits
+    // Lower 2 bits, four pixels per byte; do partial bytes at the ends
+    // singly, then the rest with the 2 bits replicated across each byte.
+    while ((first & 3) && (first < end))
+      monoSet(first++, v);
+    while ((end & 3) && (first < end))
+      monoSet(--end, v);
+    if (first < end)
+      memset(&pixels[numLEDs + (first >> 2)], (v & 3) * 0x55,
+             (end - first) >> 2);
+    return;
+  }
+
+  // Power estimate: take the old colors out of the sums and put the new
+  // one in. Filling the whole strip sets the sums outright.
+  if (powerModel && !first && (end == numLEDs)) {
+    powerSum[0] = powerSum[1] = powerSum[2] = 0;
+    powerCounted = true;
+  } else if (powerCounted) {
+    for (const uint8_t *q = &pixels[first * 3]; q < &pixels[end * 3];
+         q += 3) {
+      powerSum[0] -= q[rOffset];
+      powerSum[1] -= q[gOffset];
+      powerSum[2] -= q[bOffset];
+    }
+  }
+  if (powerCounted) {
+    uint32_t k = end - first;
+    powerSum[0] += k * (uint8_t)(c >> 16);
+    powerSum[1] += k * (uint8_t)(c >> 8);
+    powerSum[2] += k * (uint8_t)c;
+  }
+
+  // Store the first pixel, then replicate it by repeatedly doubling the
+  // filled region with memcpy() (3, 6, 12, 24... bytes), rather than
+  // storing each pixel individually.
+  uint8_t *p = &pixels[first * 3];
+  uint32_t done = 3, bytes = (uint32_t)(end - first) * 3, n;
+  p[rOffset] = (uint8_t)(c >> 16);
+  p[gOffset] = (uint8_t)(c >> 8);
+  p[bOffset] = (uint8_t)c;
+  while (done < bytes) {
+    n = (done < bytes - done) ? done : bytes - done;
+    memcpy(p + done, p, n);
+    done += n;
+  }
+  touchSpan(first, end);
+}
+
+/*!
+  @brief   Set the colors of a run of consecutive pixels from an array of
+           32-bit 'packed' RGB values. Faster than calling setPixelColor()
+           for each, as bounds checking and color-order lookup happen once.
+  @param   first   Index of first pixel to set, starting from 0.
+  @param   colors  Array of 32-bit color values, e.g. 0x00RRGGBB.
+  @param   count   Number of pixels to set. Clipped at end of strip.
+*/
+void Adafruit_DotStar::setPixels(uint16_t first, const uint32_t *colors,
+                                 uint16_t count) {
+  if (first >= numLEDs)
+    return;
+  if (count > numLEDs - first)
+    count = numLEDs - first;
+  touch(first, first + count);
+  if (paletteBits) { // PALETTE
+    for (uint16_t i = first, end = first + count; i < end; i++)
+      indexSet(i, paletteIndex(*colors++));
+    return;
+  }
+  if (rOffset == gOffset) { // MONO
+    for (uint16_t i = first, end = first + count; i < end; i++)
+      monoSet(i, monoLevel(*colors++));
+    return;
+  }
+  uint8_t *p = &pixels[first * 3], r = rOffset, g = gOffset, b = bOffset;
+  while (count--) {
+    uint32_t c = *colors++;
+    p[r] = (uint8_t)(c >> 16);
+    p[g] = (uint8_t)(c >> 8);
+    p[b] = (uint8_t)c;
+    p += 3;
+  }
+}
+
+/*!
+  @brief   Read the colors of a run of consecutive pixels from a Stream
+           (Serial, a file, network client, etc.), 3 bytes per pixel. On
+           regular color strips, data is read straight into the pixel
+           buffer; if the incoming color order differs from the strip's,
+           it's then rearranged in place. No intermediate buffer or
+           per-pixel function calls are needed, and if the orders match
+           (e.g. the sender already uses the strip's native order), the
+           data isn't touched again at all.
+  @param   in     Stream to read from. Its setTimeout() applies.
+  @param   first  Index of first pixel to set, starting from 0.
+  @param   count  Number of pixels to read. Clipped at end of strip (any
+                  excess data is left in the stream).
+  @param   order  Color order of incoming data, one of the DOTSTAR_*
+                  color-order constants. Default is DOTSTAR_RGB.
+  @return  Number of whole pixels read, less than count if the stream
+           timed out (which may leave part of a pixel unread).
+  @note    On DOTSTAR_MONO and palette-mode strips, each pixel is stored
+           with setPixelColor(), which is slower.
+*/
+uint16_t Adafruit_DotStar::readPixels(Stream &in, uint16_t first,
+                                      uint16_t count, uint8_t order) {
+  if (first >= numLEDs)
+    return 0;
+  if (count > numLEDs - first)
+    count = numLEDs - first;
+  uint8_t r = order & 3, g = (order >> 2) & 3, b = (order >> 4) & 3;
+  uint16_t i;
+
+  if (paletteBits || (rOffset == gOffset)) { // PALETTE or MONO
+    uint8_t p[3];
+    for (i = 0; (i < count) && (in.readBytes(p, 3) == 3); i++)
+      setPixelColor(first + i, p[r], p[g], p[b]);
+    return i;
+  }
+
+  uint8_t *p = &pixels[first * 3], t[3];
+  count = in.readBytes(p, (uint32_t)count * 3) / 3;
+  touch(first, first + count);
+  if ((r != rOffset) || (g != gOffset) || (b != bOffset)) {
+    for (i = 0; i < count; i++, p += 3) { // Remap to native order
+      t[0] = p[0];
+      t[1] = p[1];
+      t[2] = p[2];
+      p[rOffset] = t[r];
+      p[gOffset] = t[g];
+      p[bOffset] = t[b];
+    }
+  }
+  return count;
+}
+
+/*!
+  @brief   Move all pixels along the strip, e.g. for scrolling effects.
+           Pixels moved off one end are lost, and those vacated at the
+           other end are set to a given color.
+  @param   n  Number of pixels to shift by. Positive values move pixels
+              toward the end of the strip (higher indices), negative
+              values toward the start.
+  @param   c  Color for vacated pixels, 32-bit 'packed' RGB value. 0
+              (off) if unspecified.
+*/
+void Adafruit_DotStar::shift(int32_t n, uint32_t c) {
+  if (!n || !numLEDs)
+    return;
+  // Distance, clipped to the strip length. Unsigned, so -n can't overflow
+  uint32_t d = (n > 0) ? (uint32_t)n : 0u - (uint32_t)n;
+  uint16_t k = (d < numLEDs) ? d : numLEDs;
+  if ((rOffset == gOffset) || (paletteBits == 4)) {
+    // MONO or 4-bit PALETTE: move pixels one at a time
+    uint16_t i;
+    if (n > 0) {
+      for (i = numLEDs - 1; i >= k; i--)
+        packedSet(i, packedGet(i - k));
+      fill(c, 0, k);
+    } else {
+      for (i = k; i < numLEDs; i++)
+        packedSet(i - k, packedGet(i));
+      fill(c, numLEDs - k, k);
+    }
+    touch(0, numLEDs);
+    return;
+  }
+  uint8_t bpp = paletteBits ? 1 : 3; // Bytes per pixel
+  uint32_t bytes = (uint32_t)(numLEDs - k) * bpp;
+  if (n > 0) {
+    memmove(&pixels[k * bpp], pixels, bytes);
+    fill(c, 0, k);
+  } else {
+    memmove(pixels, &pixels[k * bpp], bytes);
+    fill(c, numLEDs - k, k);
+  }
+  touch(0, numLEDs);
+}
+
+/*!
+  @brief   Rotate all pixels along the strip, e.g. for scrolling effects.
+           Like shift(), but pixels moved off one end reappear at the
+           other.
+  @param   n  Number of pixels to rotate by. Positive values move pixels
+              toward the end of the strip (higher indices), negative
+              values toward the start.
+*/
+void Adafruit_DotStar::rotate(int32_t n) {
+  if (!numLEDs)
+    return;
+  // Reduce to a rotation toward the end of the strip of 0 to numLEDs-1,
+  // then pick the shorter direction.
+  n %= (int32_t)numLEDs;
+  if (n < 0)
+    n += numLEDs;
+  if (!n)
+    return;
+  bool up = (n <= numLEDs / 2);
+  uint16_t k = up ? n : numLEDs - n;
+  touch(0, numLEDs);
+  if ((rOffset == gOffset) || (paletteBits == 4) ||
+      (k > DOTSTAR_CHUNK_PIXELS)) {
+    // MONO or 4-bit PALETTE (pixels aren't whole bytes), or too many
+    // pixels wrapping around to stash: rotate by reversal, which moves
+    // every pixel twice whatever the count.
+    reversePixels(0, numLEDs);
+    reversePixels(0, n);
+    reversePixels(n, numLEDs);
+    return;
+  }
+
+  // Pixels wrapping around are stashed in a small stack buffer while
+  // the rest are moved with one memmove().
+  uint8_t tmp[DOTSTAR_CHUNK_PIXELS * 3], bpp = paletteBits ? 1 : 3;
+  uint32_t bytes = (uint32_t)k * bpp, rest = (uint32_t)(numLEDs - k) * bpp;
+  if (up) {
+    memcpy(tmp, &pixels[rest], bytes);
+    memmove(&pixels[bytes], pixels, rest);
+    memcpy(pixels, tmp, bytes);
+  } else {
+    memcpy(tmp, pixels, bytes);
+    memmove(pixels, &pixels[bytes], rest);
+    memcpy(&pixels[rest], tmp, bytes);
+  }
+}
+
+// Effect kernels. Pixel bytes are processed four at a time as a 32-bit
+// word, regardless of color order (all channels are treated alike): the
+// even and odd bytes are spread into two words of 16-bit lanes
+// (0x00FF00FF masks), so one multiply scales two channels with room for
+// the 16-bit intermediate product. The same functions work on 'packed'
+// 0x00RRGGBB colors, for strips not stored as 3 bytes per pixel.
+
+#define LANES 0x00FF00FF ///< Even bytes of a word, as 16-bit lanes
+
+/*!
+  @brief   Scale the four bytes of a word.
+  @param   x  Four 8-bit values.
+  @param   s  Scale, 0 (all zero) to 256 (unchanged).
+  @return  Four scaled values, each (value * s) >> 8.
+*/
+static inline uint32_t scale4(uint32_t x, uint16_t s) {
+  return ((((x & LANES) * s) >> 8) & LANES) |
+         ((((x >> 8) & LANES) * s) & ~LANES);
+}
+
+/*!
+  @brief   Linear interpolation between the four bytes of two words.
+  @param   a  Four 8-bit values, returned when w is 0.
+  @param   b  Four 8-bit values, returned when w is 256.
+  @param   w  Weight of b, 0 to 256.
+  @return  Four interpolated values, each (a * (256 - w) + b * w) >> 8.
+*/
+static inline uint32_t lerp4(uint32_t a, uint32_t b, uint16_t w) {
+  uint16_t v = 256 - w;
+  return ((((a & LANES) * v + (b & LANES) * w) >> 8) & LANES) |
+         ((((a >> 8) & LANES) * v + ((b >> 8) & LANES) * w) & ~LANES);
+}
+
+/*!
+  @brief   Saturating addition of the four bytes of two words.
+  @param   a  Four 8-bit values.
+  @param   b  Four 8-bit values.
+  @return  Four sums, each limited to 255.
+*/
+static inline uint32_t add4(uint32_t a, uint32_t b) {
+  // Add low 7 bits of each byte, then the top bits without carry-out
+  uint32_t s = ((a & 0x7F7F7F7F) + (b & 0x7F7F7F7F)) ^ ((a ^ b) & 0x80808080);
+  uint32_t c = ((a & b) | ((a | b) & ~s)) & 0x80808080; // Carry-outs
+  return s | ((c << 1) - (c >> 7)); // Saturate bytes that carried
+}
+
+/*!
+  @brief   3-tap blur of the four bytes of a word.
+  @param   p  Four 8-bit values from the previous pixel.
+  @param   x  Four 8-bit values from this pixel.
+  @param   n  Four 8-bit values from the next pixel.
+  @param   w  Amount of blur, 0 (none) to 256 (fully blurred).
+  @return  Four values, each x interpolated toward (p + 2x + n) / 4.
+*/
+static inline uint32_t blur4(uint32_t p, uint32_t x, uint32_t n, uint16_t w) {
+  uint32_t lo = ((p & LANES) + ((x & LANES) << 1) + (n & LANES)) >> 2,
+           hi = (((p >> 8) & LANES) + (((x >> 8) & LANES) << 1) +
+                 ((n >> 8) & LANES)) >> 2;
+  return lerp4(x, (lo & LANES) | ((hi & LANES) << 8), w);
 }
 
 /*!
-  @brief   Change the length of a previously-declared Adafruit_DotStar
-           strip object. Old data is deallocated and new data is cleared.
-           Pin numbers and pixel format are unchanged.
-  @param   n  New length of strip, in pixels.
-  @note    This function is deprecated, here only for old projects that
-           may still be calling it. New projects should instead use the
-           'new' keyword.
+  @brief   Load a pixel's (or fewer) bytes into a word. Unaligned safe.
+  @param   p    Pointer to bytes.
+  @param   len  Number of bytes, 1 to 4.
+  @return  Word containing the bytes, rest zero.
 */
-void Adafruit_DotStar::updateLength(uint16_t n) {
-  free(pixels);
-  uint16_t bytes = (rOffset == gOffset)
-                       ? n + ((n + 3) / 4)
-                       :      // MONO: 10 bits/pixel, round up to next byte
-                       n * 3; // COLOR: 3 bytes/pixel
-  if ((pixels = (uint8_t *)malloc(bytes))) {
-    numLEDs = n;
-    clear();
-  } else {
-    numLEDs = 0;
+static inline uint32_t load4(const uint8_t *p, uint8_t len) {
+  uint32_t x = 0;
+  if (len == 4) {
+    memcpy(&x, p, 4);
+    return x;
   }
+  // Fewer bytes are shifted in (memory order doesn't matter to the
+  // kernels, so long as store4() matches). A partial memcpy() would go
+  // through memory and stall the word load after it.
+  while (len--)
+    x = (x << 8) | p[len];
+  return x;
 }
 
-// SPI STUFF ---------------------------------------------------------------
-
-/* ISSUE DATA TO LED STRIP -------------------------------------------------
-
-  Although the LED driver has an additional per-pixel 5-bit brightness
-  setting, it is NOT used or supported here. On APA102, the normally
-  very fast PWM is gated through a much slower PWM (about 400 Hz),
-  rendering it useless for POV or other high-speed things that are
-  probably why one is using DotStars instead of NeoPixels in the first
-  place. I'm told that some APA102 clones use current control rather than
-  PWM for this, which would be much more worthwhile. Still, no support
-  here, no plans for it. If you really can't live without it, you can fork
-  the library and add it for your own use, but any pull requests for this
-  are unlikely be merged for the foreseeable future.
+/*!
+  @brief   Store a word's bytes. Unaligned safe.
+  @param   p    Pointer to bytes.
+  @param   x    Word to store.
+  @param   len  Number of bytes, 1 to 4.
 */
+static inline void store4(uint8_t *p, uint32_t x, uint8_t len) {
+  if (len == 4) {
+    memcpy(p, &x, 4);
+    return;
+  }
+  for (; len--; x >>= 8)
+    *p++ = x;
+}
 
 /*!
-  @brief   Transmit pixel data in RAM to DotStars.
+  @brief   Scale the colors of all or part of the strip toward black, e.g.
+           for fading trails. Much faster than getPixelColor() and
+           setPixelColor() for each pixel, as the pixel buffer is
+           processed directly, several color components at a time.
+  @param   scale  Scale, 0 (black) to 255 (unchanged). Each color
+                  component becomes component * (scale + 1) / 256.
+  @param   first  Index of first pixel, starting from 0. 0 if unspecified.
+  @param   count  Number of pixels. Passing 0 or leaving unspecified will
+                  process to end of strip. Clipped at end of strip.
 */
-void Adafruit_DotStar::show(void) {
-  if (!pixels)
+void Adafruit_DotStar::fade(uint8_t scale, uint16_t first, uint16_t count) {
+  if (first >= numLEDs)
     return;
+  if ((count == 0) || (count > numLEDs - first))
+    count = numLEDs - first;
+  uint16_t s = scale + 1;
+  touch(first, first + count);
 
-  uint8_t *ptr = pixels, i;            // -> LED data
-  uint16_t n = numLEDs;                // Counter
-  uint16_t b16 = (uint16_t)brightness; // Type-convert for fixed-point math
-
-  // Begin transaction, setting SPI frequency
-  spi_dev->beginTransaction();
-
-  // [START FRAME]
-  for (i = 0; i < 4; i++)
-    spi_dev->transfer(0x00);
-
-  // [PIXEL DATA]
-  if (brightness) {            // Scale pixel brightness on output
-    do {                       // For each pixel...
-      spi_dev->transfer(0xFF); //  Pixel start
-      for (i = 0; i < 3; i++)
-        spi_dev->transfer((*ptr++ * b16) >> 8); // Scale, write
-    } while (--n);
-  } else {                     // Full brightness (no scaling)
-    do {                       // For each pixel...
-      spi_dev->transfer(0xFF); //  Pixel start
-      for (i = 0; i < 3; i++)
-        spi_dev->transfer(*ptr++); // R,G,B
-    } while (--n);
-  }
-
-  // [END FRAME]
-  // Four end-frame bytes are seemingly indistinguishable from a white
-  // pixel, and empirical testing suggests it can be left out...but it's
-  // always a good idea to follow the datasheet, in case future hardware
-  // revisions are more strict (e.g. might mandate use of end-frame
-  // before start-frame marker). i.e. let's not remove this. But after
-  // testing a bit more the suggestion is to use at least (numLeds+1)/2
-  // high values (1) or (numLeds+15)/16 full bytes as EndFrame. For details
-  // see also:
-  // https://cpldcpu.wordpress.com/2014/11/30/understanding-the-apa102-superled/
-  for (i = 0; i < ((numLEDs + 15) / 16); i++)
-    spi_dev->transfer(0xFF);
-
-  // Finish SPI transaction
-  spi_dev->endTransaction();
+  if (paletteBits || (rOffset == gOffset)) { // PALETTE or MONO
+    for (uint16_t i = first, end = first + count; i < end; i++)
+      setPixelColor(i, scale4(getPixelColor(i), s));
+    return;
+  }
+  uint8_t *p = &pixels[first * 3];
+  uint32_t len = (uint32_t)count * 3;
+  for (; len >= 4; len -= 4, p += 4)
+    store4(p, scale4(load4(p, 4), s), 4);
+  if (len)
+    store4(p, scale4(load4(p, len), s), len);
 }
 
 /*!
-  @brief   Fill the whole DotStar strip with 0 / black / off.
+  @brief   Check whether another strip's pixel buffer holds colors in the
+           same format as this one's, 3 bytes per pixel in the same order.
+  @param   s  Strip to compare.
+  @return  true if the buffers can be processed together byte-for-byte.
 */
-void Adafruit_DotStar::clear() {
-  memset(pixels, 0,
-         (rOffset == gOffset) ? numLEDs + ((numLEDs + 3) / 4)
-                              : // MONO: 10 bits/pixel
-             numLEDs * 3);      // COLOR: 3 bytes/pixel
+bool Adafruit_DotStar::sameFormat(const Adafruit_DotStar &s) const {
+  return !paletteBits && (rOffset != gOffset) && !s.paletteBits &&
+         (s.rOffset == rOffset) && (s.gOffset == gOffset) &&
+         (s.bOffset == bOffset);
 }
 
 /*!
-  @brief   Set a pixel's color using separate red, green and blue components.
-  @param   n  Pixel index, starting from 0.
-  @param   r  Red brightness, 0 = minimum (off), 255 = maximum.
-  @param   g  Green brightness, 0 = minimum (off), 255 = maximum.
-  @param   b  Blue brightness, 0 = minimum (off), 255 = maximum.
+  @brief   Set this strip's pixels to a blend of two strips, e.g. to
+           crossfade from one frame to another. Either may be this strip.
+  @param   a       Strip whose pixels are used when amount is 0.
+  @param   b       Strip whose pixels are used when amount is 255.
+  @param   amount  Amount of b, 0 to 255.
+  @note    Pixels are processed up to the shortest of the three strips.
+           If all three store 3 bytes per pixel in the same color order,
+           pixel buffers are processed directly, several color components
+           at a time; otherwise (e.g. DOTSTAR_MONO, palette mode or
+           different color orders) it works, but pixel by pixel.
 */
-void Adafruit_DotStar::setPixelColor(uint16_t n, uint8_t r, uint8_t g,
-                                     uint8_t b) {
-  if (n < numLEDs) {
-    uint8_t *p = &pixels[n * 3];
-    p[rOffset] = r;
-    p[gOffset] = g;
-    p[bOffset] = b;
+void Adafruit_DotStar::blend(const Adafruit_DotStar &a,
+                             const Adafruit_DotStar &b, uint8_t amount) {
+  uint16_t w = amount + (amount >> 7), count = numLEDs; // w is 0 to 256
+  if (a.numLEDs < count)
+    count = a.numLEDs;
+  if (b.numLEDs < count)
+    count = b.numLEDs;
+  if (!count)
+    return;
+  touch(0, count);
+
+  if (!sameFormat(a) || !sameFormat(b)) {
+    for (uint16_t i = 0; i < count; i++)
+      setPixelColor(i, lerp4(a.getPixelColor(i), b.getPixelColor(i), w));
+    return;
   }
+  const uint8_t *pa = a.pixels, *pb = b.pixels;
+  uint8_t *p = pixels;
+  uint32_t len = (uint32_t)count * 3;
+  for (; len >= 4; len -= 4, p += 4, pa += 4, pb += 4)
+    store4(p, lerp4(load4(pa, 4), load4(pb, 4), w), 4);
+  if (len)
+    store4(p, lerp4(load4(pa, len), load4(pb, len), w), len);
 }
 
 /*!
-  @brief   Set a pixel's color using a 32-bit 'packed' RGB value.
-  @param   n  Pixel index, starting from 0.
-  @param   c  32-bit color value. Most significant byte is 0, second is
-              red, then green, and least significant byte is blue.
-              e.g. 0x00RRGGBB
+  @brief   Add another strip's pixels to this strip's, e.g. to layer
+           effects. Each color component is limited to 255.
+  @param   src  Strip to add. Pixels are processed up to the shorter of
+                the two strips.
+  @note    As with blend(), fastest if both strips store 3 bytes per pixel
+           in the same color order.
 */
-void Adafruit_DotStar::setPixelColor(uint16_t n, uint32_t c) {
-  if (n < numLEDs) {
-    uint8_t *p = &pixels[n * 3];
-    p[rOffset] = (uint8_t)(c >> 16);
-    p[gOffset] = (uint8_t)(c >> 8);
-    p[bOffset] = (uint8_t)c;
+void Adafruit_DotStar::add(const Adafruit_DotStar &src) {
+  uint16_t count = (src.numLEDs < numLEDs) ? src.numLEDs : numLEDs;
+  if (!count)
+    return;
+  touch(0, count);
+
+  if (!sameFormat(src)) {
+    for (uint16_t i = 0; i < count; i++)
+      setPixelColor(i, add4(getPixelColor(i), src.getPixelColor(i)));
+    return;
   }
+  const uint8_t *ps = src.pixels;
+  uint8_t *p = pixels;
+  uint32_t len = (uint32_t)count * 3;
+  for (; len >= 4; len -= 4, p += 4, ps += 4)
+    store4(p, add4(load4(p, 4), load4(ps, 4)), 4);
+  if (len)
+    store4(p, add4(load4(p, len), load4(ps, len)), len);
 }
 
 /*!
-  @brief   Fill all or part of the DotStar strip with a color.
-  @param   c      32-bit color value. Most significant byte is 0, second
-                  is red, then green, and least significant byte is blue.
-                  e.g. 0x00RRGGBB. If all arguments are unspecified, this
-                  will be 0 (off).
-  @param   first  Index of first pixel to fill, starting from 0. Must be
-                  in-bounds, no clipping is performed. 0 if unspecified.
-  @param   count  Number of pixels to fill, as a positive value. Passing
-                  0 or leaving unspecified will fill to end of strip.
+  @brief   Blur all or part of the strip, blending each pixel with its
+           neighbors, e.g. to soften or spread effects. Repeat for more
+           blur. Pixels at the ends of the range are blurred with
+           themselves in place of a missing neighbor, so overall
+           brightness is preserved.
+  @param   amount  Amount of blur, 0 (none) to 255 (each pixel replaced
+                   by a 1-2-1 weighted average of itself and neighbors).
+  @param   first   Index of first pixel, starting from 0. 0 if
+                   unspecified.
+  @param   count   Number of pixels. Passing 0 or leaving unspecified
+                   will process to end of strip. Clipped at end of strip.
 */
-void Adafruit_DotStar::fill(uint32_t c, uint16_t first, uint16_t count) {
-  uint16_t i, end;
-
-  if (first >= numLEDs) {
-    return; // If first LED is past end of strip, nothing to do
-  }
+void Adafruit_DotStar::blur(uint8_t amount, uint16_t first, uint16_t count) {
+  if (first >= numLEDs)
+    return;
+  if ((count == 0) || (count > numLEDs - first))
+    count = numLEDs - first;
+  uint16_t w = amount + (amount >> 7), i, end = first + count;
+  uint32_t prev, cur, next;
+  touch(first, end);
 
-  // Calculate the index ONE AFTER the last pixel to fill
-  if (count == 0) {
-    // Fill to end of strip
-    end = numLEDs;
-  } else {
-    // Ensure that the loop won't go past the last pixel
-    end = first + count;
-    if (end > numLEDs)
-      end = numLEDs;
+  if (paletteBits || (rOffset == gOffset)) { // PALETTE or MONO
+    prev = cur = getPixelColor(first);
+    for (i = first; i < end; i++, prev = cur, cur = next) {
+      next = (i + 1 < end) ? getPixelColor(i + 1) : cur;
+      setPixelColor(i, blur4(prev, cur, next, w));
+    }
+    return;
   }
-
-  for (i = first; i < end; i++) {
-    this->setPixelColor(i, c);
+  // Each pixel's 3 bytes are handled as one word. The original value of
+  // the previous pixel is carried along, as it's already been replaced.
+  uint8_t *p = &pixels[first * 3];
+  prev = cur = load4(p, 3);
+  for (i = first; i < end; i++, p += 3, prev = cur, cur = next) {
+    next = (i + 1 < end) ? load4(p + 3, 3) : cur;
+    store4(p, blur4(prev, cur, next, w), 3);
   }
 }
 
@@ -318,6 +1775,27 @@ void Adafruit_DotStar::fill(uint32_t c, uint16_t first, uint16_t count) {
            help when using low-saturation colors.
 */
 uint32_t Adafruit_DotStar::ColorHSV(uint16_t hue, uint8_t sat, uint8_t val) {
+  uint32_t rgb = ColorHue(hue);
+  uint8_t r = rgb >> 16, g = rgb >> 8, b = rgb;
+
+  // Apply saturation and value to R,G,B, pack into 32-bit result:
+  uint32_t v1 = 1 + val;  // 1 to 256; allows >>8 instead of /255
+  uint16_t s1 = 1 + sat;  // 1 to 256; same reason
+  uint8_t s2 = 255 - sat; // 255 to 0
+  return ((((((r * s1) >> 8) + s2) * v1) & 0xff00) << 8) |
+         (((((g * s1) >> 8) + s2) * v1) & 0xff00) |
+         (((((b * s1) >> 8) + s2) * v1) >> 8);
+}
+
+/*!
+  @brief   Convert hue into a packed 32-bit RGB color at full saturation
+           and value. Same as ColorHSV(hue, 255, 255) but without the
+           saturation and value math.
+  @param   hue  An unsigned 16-bit value, 0 to 65535, representing one full
+                loop of the color wheel, see ColorHSV().
+  @return  Packed 32-bit RGB color.
+*/
+uint32_t Adafruit_DotStar::ColorHue(uint16_t hue) {
 
   uint8_t r, g, b;
 
@@ -384,13 +1862,7 @@ uint32_t Adafruit_DotStar::ColorHSV(uint16_t hue, uint8_t sat, uint8_t val) {
     g = b = 0;
   }
 
-  // Apply saturation and value to R,G,B, pack into 32-bit result:
-  uint32_t v1 = 1 + val;  // 1 to 256; allows >>8 instead of /255
-  uint16_t s1 = 1 + sat;  // 1 to 256; same reason
-  uint8_t s2 = 255 - sat; // 255 to 0
-  return ((((((r * s1) >> 8) + s2) * v1) & 0xff00) << 8) |
-         (((((g * s1) >> 8) + s2) * v1) & 0xff00) |
-         (((((b * s1) >> 8) + s2) * v1) >> 8);
+  return ((uint32_t)r << 16) | ((uint16_t)g << 8) | b;
 }
 
 /*!
@@ -402,11 +1874,227 @@ uint32_t Adafruit_DotStar::ColorHSV(uint16_t hue, uint8_t sat, uint8_t val) {
 uint32_t Adafruit_DotStar::getPixelColor(uint16_t n) const {
   if (n >= numLEDs)
     return 0;
+  if (paletteBits) // PALETTE
+    return getPaletteColor(indexGet(pixels, n));
+  if (rOffset == gOffset) { // MONO: return gray at upper 8 bits of level
+    uint32_t v = pixels[n];
+    return (v << 16) | (v << 8) | v;
+  }
   uint8_t *p = &pixels[n * 3];
   return ((uint32_t)p[rOffset] << 16) | ((uint32_t)p[gOffset] << 8) |
          (uint32_t)p[bOffset];
 }
 
+/*!
+  @brief   Set a pixel's 10-bit level. Intended for DOTSTAR_MONO strips,
+           which store 10 bits per pixel for finer dimming than 8-bit
+           colors allow.
+  @param   n      Pixel index, starting from 0.
+  @param   level  Pixel level, 0 (off) to 1023 (max). Larger values are
+                  clipped to 1023. On color strips, R, G and B are all set
+                  to level / 4.
+*/
+void Adafruit_DotStar::setPixelLevel(uint16_t n, uint16_t level) {
+  if (n < numLEDs) {
+    if (level > 1023)
+      level = 1023;
+    if (rOffset == gOffset) { // MONO
+      touch(n, n + 1);
+      monoSet(n, level);
+    } else {
+      level >>= 2;
+      setPixelColor(n, level, level, level);
+    }
+  }
+}
+
+/*!
+  @brief   Query a pixel's 10-bit level.
+  @param   n  Index of pixel to read (0 = first).
+  @return  Pixel level, 0 (off) to 1023 (max). On color strips this is
+           derived from the largest of the R, G and B components.
+*/
+uint16_t Adafruit_DotStar::getPixelLevel(uint16_t n) const {
+  if (n >= numLEDs)
+    return 0;
+  return (rOffset == gOffset) ? monoGet(pixels, n)
+                              : monoLevel(getPixelColor(n));
+}
+
+/*!
+  @brief   Convert a packed RGB color to a 10-bit MONO level, using the
+           largest of the R, G and B components.
+  @param   c  32-bit color value, 0x00RRGGBB.
+  @return  Level, 0 to 1023.
+*/
+uint16_t Adafruit_DotStar::monoLevel(uint32_t c) {
+  uint8_t r = c >> 16, g = c >> 8, b = c, v = r;
+  if (g > v)
+    v = g;
+  if (b > v)
+    v = b;
+  return ((uint16_t)v << 2) | (v >> 6); // 255 -> 1023
+}
+
+/*!
+  @brief   Reverse the order of a range of pixels, in any storage format.
+  @param   first  Index of first pixel.
+  @param   end    Index ONE AFTER the last pixel.
+*/
+void Adafruit_DotStar::reversePixels(uint16_t first, uint16_t end) {
+  if ((rOffset == gOffset) || (paletteBits == 4)) { // MONO, 4-bit PALETTE
+    uint16_t t;
+    while ((first + 1) < end) {
+      end--;
+      t = packedGet(first);
+      packedSet(first, packedGet(end));
+      packedSet(end, t);
+      first++;
+    }
+    return;
+  }
+  if ((first + 1) >= end)
+    return;
+  uint8_t bpp = paletteBits ? 1 : 3, t, i; // 8-bit PALETTE or COLOR
+  uint8_t *a = &pixels[(uint32_t)first * bpp],
+          *b = &pixels[(uint32_t)(end - 1) * bpp];
+  for (; a < b; a += bpp, b -= bpp) {
+    for (i = 0; i < bpp; i++) {
+      t = a[i];
+      a[i] = b[i];
+      b[i] = t;
+    }
+  }
+}
+
+/*!
+  @brief   Switch between regular (3 bytes per pixel) and palette-indexed
+           pixel storage. In palette mode, each pixel is a 4- or 8-bit
+           index into a table of 16 or 256 colors, cutting pixel RAM to
+           1/6 or 1/3, and colors are expanded as data is issued to the
+           strip. Changing a palette color with setPaletteColor() recolors
+           every pixel using it, whatever the strip length, so palette
+           cycling effects cost next to nothing.
+  @param   bits  4 or 8 for palette-indexed storage, 0 for regular.
+  @return  true on success, false if bits is invalid, the strip is
+           DOTSTAR_MONO or has a static buffer (Adafruit_DotStarStrip), or
+           memory could not be allocated (in which case the strip is
+           unchanged).
+  @note    Like updateLength(), the pixel buffer is reallocated and
+           cleared (palette index 0), as are per-pixel brightness levels.
+           The palette starts out all black (0). setPixelColor(), fill()
+           and other RGB functions still work, using the closest palette
+           color, but are slower than setPixelIndex(). Palette changes
+           apply to frames in progress with showAsync(). To avoid ever
+           allocating a full-size buffer, construct the strip with length
+           0, call this, then updateLength().
+*/
+bool Adafruit_DotStar::setPaletteMode(uint8_t bits) {
+  if (bits == paletteBits)
+    return true;
+  if (((bits != 4) && (bits != 8) && bits) || (rOffset == gOffset) ||
+      fixedPixels)
+    return false;
+  waitForShow();
+  uint8_t *pal = NULL, *buf = NULL, prevBits = paletteBits;
+  if (bits && !(pal = (uint8_t *)calloc(3 << bits, 1)))
+    return false;
+  paletteBits = bits;
+  if (numLEDs && !(buf = (uint8_t *)malloc(bufferBytes(numLEDs)))) {
+    free(pal);
+    paletteBits = prevBits;
+    return false;
+  }
+  free(pixels);
+  free(palette);
+  pixels = buf;
+  palette = pal;
+  setLength(numLEDs);
+  return true;
+}
+
+/*!
+  @brief   Set one palette color. All pixels using this palette index
+           will show the new color on the next show().
+  @param   i  Palette index, 0 to 15 (4-bit mode) or 255 (8-bit mode).
+  @param   c  32-bit color value, e.g. 0x00RRGGBB.
+  @note    Has no effect if not in palette mode.
+*/
+void Adafruit_DotStar::setPaletteColor(uint8_t i, uint32_t c) {
+  if (!paletteBits || (i >> paletteBits))
+    return;
+  uint8_t *p = &palette[i * 3];
+  touch(0, numLEDs); // Any pixel could be using it
+  p[rOffset] = (uint8_t)(c >> 16);
+  p[gOffset] = (uint8_t)(c >> 8);
+  p[bOffset] = (uint8_t)c;
+}
+
+/*!
+  @brief   Query a palette color.
+  @param   i  Palette index, 0 to 15 (4-bit mode) or 255 (8-bit mode).
+  @return  'Packed' 32-bit RGB value, or 0 if not in palette mode or
+           index is out of range.
+*/
+uint32_t Adafruit_DotStar::getPaletteColor(uint8_t i) const {
+  if (!paletteBits || (i >> paletteBits))
+    return 0;
+  const uint8_t *p = &palette[i * 3];
+  return ((uint32_t)p[rOffset] << 16) | ((uint32_t)p[gOffset] << 8) |
+         (uint32_t)p[bOffset];
+}
+
+/*!
+  @brief   Set a pixel's palette index, in palette mode.
+  @param   n  Pixel index, starting from 0.
+  @param   i  Palette index, 0 to 15 (4-bit mode) or 255 (8-bit mode).
+  @note    Has no effect if not in palette mode.
+*/
+void Adafruit_DotStar::setPixelIndex(uint16_t n, uint8_t i) {
+  if (paletteBits && (n < numLEDs)) {
+    touch(n, n + 1);
+    indexSet(n, i);
+  }
+}
+
+/*!
+  @brief   Query a pixel's palette index, in palette mode.
+  @param   n  Index of pixel to read (0 = first).
+  @return  Palette index, or 0 if not in palette mode.
+*/
+uint8_t Adafruit_DotStar::getPixelIndex(uint16_t n) const {
+  return (paletteBits && (n < numLEDs)) ? indexGet(pixels, n) : 0;
+}
+
+/*!
+  @brief   Find the palette color closest to a given RGB color.
+  @param   c  32-bit color value, 0x00RRGGBB.
+  @return  Palette index of an exact match if there is one, else the
+           nearest (smallest sum of squared R, G, B differences).
+*/
+uint8_t Adafruit_DotStar::paletteIndex(uint32_t c) const {
+  uint8_t rgb[3], best = 0;
+  rgb[rOffset] = c >> 16; // Compare in native order
+  rgb[gOffset] = c >> 8;
+  rgb[bOffset] = c;
+  uint32_t bestDist = 0xFFFFFFFF, d;
+  int16_t d0, d1, d2;
+  const uint8_t *p = palette;
+  for (uint16_t i = 0, n = 1 << paletteBits; i < n; i++, p += 3) {
+    d0 = p[0] - rgb[0];
+    d1 = p[1] - rgb[1];
+    d2 = p[2] - rgb[2];
+    d = (int32_t)d0 * d0 + (int32_t)d1 * d1 + (int32_t)d2 * d2;
+    if (d < bestDist) {
+      if (!d)
+        return i; // Exact match
+      bestDist = d;
+      best = i;
+    }
+  }
+  return best;
+}
+
 /*!
   @brief   Adjust output brightness. Does not immediately affect what's
            currently displayed on the LEDs. The next call to show() will
@@ -427,7 +2115,13 @@ void Adafruit_DotStar::setBrightness(uint8_t b) {
   // here may (intentionally) roll over...so 0 = max brightness (color
   // values are interpreted literally; no scaling), 1 = min brightness
   // (off), 255 = just below max brightness.
-  brightness = b + 1;
+  if ((uint8_t)(b + 1) != brightness) {
+    if (lut)
+      waitForShow(); // Don't change table mid-frame
+    brightness = b + 1;
+    touchSpan(0, numLEDs); // All pixels need re-scaling
+    updateLUT();
+  }
 }
 
 /*!
@@ -438,6 +2132,215 @@ uint8_t Adafruit_DotStar::getBrightness(void) const {
   return brightness - 1; // Reverse above operation
 }
 
+/*!
+  @brief   Select how setBrightness() is applied. By default, color bytes
+           are scaled in software as they're issued. With hardware
+           brightness enabled, brightness is instead mapped onto the 5-bit
+           global brightness field in each pixel's header byte, and color
+           bytes are issued unscaled. This preserves full 8-bit color
+           resolution at low brightness (8 + 5 bits of dimming range) and
+           avoids the per-byte scaling in show().
+  @param   enable  true to use the 5-bit header field, false (default) to
+                   scale color bytes.
+  @note    Only recommended for APA102 clones that implement this field
+           with current control (e.g. SK9822). On genuine APA102s it
+           introduces a slow (~400 Hz) PWM, bad for POV or video capture.
+           Brightness is quantized to 32 levels in this mode.
+*/
+void Adafruit_DotStar::setHardwareBrightness(bool enable) {
+  if (enable != hwBrightness) {
+    waitForShow();
+    hwBrightness = enable;
+    touchSpan(0, numLEDs);
+    updateLUT();
+  }
+}
+
+/*!
+  @brief   Enable or disable gamma correction at output time. When
+           enabled, colors stored with setPixelColor() etc. are taken as
+           perceptual (e.g. straight from ColorHSV(), without gamma32())
+           and gamma-corrected as data is issued to the strip, combined
+           with brightness and white balance in a single lookup table.
+           Stored colors are unaffected, so getPixelColor() returns
+           exactly what was set.
+  @param   enable  true to gamma-correct output, false (default) to issue
+                   colors as stored.
+  @return  true on success, false if the 256-byte table could not be
+           allocated (output is then not gamma-corrected).
+  @note    Uses the same fixed 2.6 exponent as gamma8(). Not applied to
+           DOTSTAR_MONO strips.
+*/
+bool Adafruit_DotStar::setGammaCorrection(bool enable) {
+  waitForShow();
+  gammaOut = enable;
+  touchSpan(0, numLEDs);
+  return updateLUT();
+}
+
+/*!
+  @brief   Set per-channel output scaling, e.g. to tame LEDs whose "white"
+           is too blue. Applied as data is issued to the strip, in the
+           same lookup table as brightness and gamma correction, so stored
+           colors are unaffected.
+  @param   r  Red output scale, 0 (off) to 255 (full, default).
+  @param   g  Green output scale, 0 (off) to 255 (full, default).
+  @param   b  Blue output scale, 0 (off) to 255 (full, default).
+  @return  true on success, false if the lookup table (256 bytes, or 768
+           if the three scales differ) could not be allocated (output is
+           then not white-balanced).
+  @note    Not applied to DOTSTAR_MONO strips.
+*/
+bool Adafruit_DotStar::setWhiteBalance(uint8_t r, uint8_t g, uint8_t b) {
+  waitForShow();
+  white[0] = r;
+  white[1] = g;
+  white[2] = b;
+  touchSpan(0, numLEDs);
+  return updateLUT();
+}
+
+/*!
+  @brief   Enable or disable temporal dithering. Normally each color byte
+           is truncated to 8 bits after brightness scaling, so at low
+           setBrightness() values only a few distinct levels remain and
+           fades visibly stair-step. With dithering, the fraction lost
+           to truncation is carried over to the next show(), so over a
+           few consecutive frames each channel averages out to its exact
+           scaled value. This works best when show() is called at a high,
+           steady rate (a few hundred frames per second is easily within
+           reach of DotStars), even if the pixel data isn't changing.
+  @param   enable  true to allocate the dither buffer (3 bytes per pixel),
+                   false to release it.
+  @return  true on success, false if the dither buffer could not be
+           allocated or the strip is DOTSTAR_MONO (output is then not
+           dithered).
+  @note    Only applies to brightness scaling, i.e. there's nothing to
+           dither at full brightness, with setHardwareBrightness(), or
+           when setGammaCorrection() or setWhiteBalance() are in use.
+           Dirty tracking does not skip frames while dithering, as output
+           changes from frame to frame.
+*/
+bool Adafruit_DotStar::setDithering(bool enable) {
+  waitForShow();
+  if (!enable || (rOffset == gOffset)) {
+    free(dither);
+    dither = NULL;
+    return !enable;
+  }
+  if (!dither) {
+    uint32_t bytes = (uint32_t)numLEDs * 3;
+    if (!(dither = (uint8_t *)malloc(bytes)))
+      return false;
+    // Seed with a spread of starting remainders so that neighboring
+    // pixels of the same color don't all step up in unison.
+    for (uint32_t i = 0; i < bytes; i++)
+      dither[i] = i * 167;
+  }
+  return true;
+}
+
+/*!
+  @brief   (Re)build, resize or free the output lookup table used by
+           encode() to apply brightness, gamma correction and white
+           balance in one step. Called whenever any of those change.
+  @return  true on success (or if no table is needed), false if the table
+           could not be allocated.
+*/
+bool Adafruit_DotStar::updateLUT(void) {
+  bool perChannel = (white[0] != white[1]) || (white[1] != white[2]);
+  if (!gammaOut && !perChannel && (white[0] == 255)) {
+    free(lut); // Not needed, encode() does plain brightness scaling
+    lut = NULL;
+    lutStride = 0;
+    return true;
+  }
+
+  uint16_t stride = perChannel ? 256 : 0;
+  if (!lut || (stride != lutStride)) {
+    free(lut);
+    if (!(lut = (uint8_t *)malloc(perChannel ? 768 : 256))) {
+      lutStride = 0;
+      return false;
+    }
+    lutStride = stride;
+  }
+  fillLUT(brightness);
+  return true;
+}
+
+/*!
+  @brief   Fill in the output lookup table(s) for a given brightness.
+  @param   bright  Brightness as stored in the brightness member.
+*/
+void Adafruit_DotStar::fillLUT(uint8_t bright) {
+  bool perChannel = lutStride;
+  // Brightness goes in the table unless issued in the 5-bit header
+  uint16_t b16 = hwBrightness ? 0 : bright, w, x;
+  for (uint8_t c = 0; c < (perChannel ? 3 : 1); c++) {
+    // Table c is for the c'th color byte on the wire; look up which of
+    // R, G, B that is for this strip's color order.
+    w = 1 + white[(c == rOffset) ? 0 : (c == gOffset) ? 1 : 2];
+    uint8_t *t = &lut[c * 256];
+    for (uint16_t v = 0; v < 256; v++) {
+      x = gammaOut ? gamma8(v) : v;
+      if (b16)
+        x = (x * b16) >> 8;
+      t[v] = (x * w) >> 8;
+    }
+  }
+  lutBrightness = bright;
+}
+
+/*!
+  @brief   Make sure the output lookup table (if any) is filled in for the
+           brightness a frame is about to be encoded at, which can differ
+           from the brightness setting when a power limit is in effect.
+  @param   bright  Brightness as stored in the brightness member.
+*/
+void Adafruit_DotStar::useLUT(uint8_t bright) {
+  if (lut && !hwBrightness && (bright != lutBrightness))
+    fillLUT(bright);
+}
+
+/*!
+  @brief   Set an individual pixel's 5-bit brightness level, issued in the
+           pixel's header byte. This is combined with the global brightness
+           (either in the header with setHardwareBrightness() or by
+           scaling color bytes otherwise). The first call allocates one
+           extra byte per pixel, with all pixels initially at full level.
+  @param   n      Pixel index, starting from 0.
+  @param   level  Brightness level, 0 (off) to 31 (max). Larger values are
+                  clipped to 31.
+  @return  true on success, false if the level buffer could not be
+           allocated.
+  @note    See notes at setHardwareBrightness() regarding APA102 vs.
+           current-controlled clones. Levels are discarded by
+           updateLength().
+*/
+bool Adafruit_DotStar::setPixelBrightness(uint16_t n, uint8_t level) {
+  if (n >= numLEDs)
+    return true;
+  if (!levels) {
+    if (!(levels = (uint8_t *)malloc(numLEDs)))
+      return false;
+    memset(levels, 31, numLEDs);
+  }
+  levels[n] = (level > 31) ? 31 : level;
+  touchSpan(n, n + 1);
+  return true;
+}
+
+/*!
+  @brief   Query a pixel's 5-bit brightness level.
+  @param   n  Index of pixel to read (0 = first).
+  @return  Brightness level, 0 (off) to 31 (max). 31 if no level has been
+           set for any pixel.
+*/
+uint8_t Adafruit_DotStar::getPixelBrightness(uint16_t n) const {
+  return (levels && (n < numLEDs)) ? levels[n] : 31;
+}
+
 /*!
   @brief   A gamma-correction function for 32-bit packed RGB colors.
            Makes color transitions appear more perceptially correct.
@@ -485,11 +2388,123 @@ uint32_t Adafruit_DotStar::gamma32(uint32_t x) {
 void Adafruit_DotStar::rainbow(uint16_t first_hue, int8_t reps,
                                uint8_t saturation, uint8_t brightness,
                                bool gammify) {
-  for (uint16_t i = 0; i < numLEDs; i++) {
-    uint16_t hue = first_hue + (i * reps * 65536) / numLEDs;
-    uint32_t color = ColorHSV(hue, saturation, brightness);
-    if (gammify)
-      color = gamma32(color);
+  rainbowSpan(first_hue, reps, saturation, brightness, gammify, 0, numLEDs);
+}
+
+/*!
+  @brief   Fill a range of pixels with their part of the rainbow() pattern,
+           as if the whole strip were being filled. Lets the strip be
+           filled in pieces, e.g. by Adafruit_DotStarRender.
+  @param   first_hue   See rainbow().
+  @param   reps        See rainbow().
+  @param   saturation  See rainbow().
+  @param   brightness  See rainbow().
+  @param   gammify     See rainbow().
+  @param   first       Index of first pixel to fill.
+  @param   count       Number of pixels to fill, must not run past the end
+                       of the strip.
+*/
+void Adafruit_DotStar::rainbowSpan(uint16_t first_hue, int8_t reps,
+                                   uint8_t saturation, uint8_t brightness,
+                                   bool gammify, uint16_t first,
+                                   uint16_t count) {
+  if (!count)
+    return;
+
+  // Hue of pixel i is first_hue + (i * reps * 65536) / numLEDs. Rather
+  // than a multiply and divide per pixel, the offset is stepped by the
+  // integer quotient plus a running remainder, giving the same result.
+  // The starting offset is first * q + (first * r) / numLEDs, as
+  // first * k = first * (q * numLEDs + r); hue wraps at 16 bits anyway.
+  uint32_t k = (uint32_t)((reps < 0) ? -reps : reps) << 16;
+  uint16_t q = k / numLEDs, r = k % numLEDs;
+  uint32_t rem = (uint32_t)first * r;
+  uint16_t offset = first * q + rem / numLEDs;
+  rem %= numLEDs;
+
+  // Saturation, value and gamma map each of R, G, B independently, so
+  // for longer strips it's quicker to compute all 256 possible results
+  // once than to do that math for every pixel. Output is identical to
+  // ColorHSV() and gamma32() either way.
+  uint8_t lut[256];
+  bool useLut = (count > 85);
+  if (useLut) {
+    uint32_t v1 = 1 + brightness; // Same math as ColorHSV()
+    uint16_t s1 = 1 + saturation;
+    uint8_t s2 = 255 - saturation, v;
+    for (uint16_t x = 0; x < 256; x++) {
+      v = ((((x * s1) >> 8) + s2) * v1) >> 8;
+      lut[x] = gammify ? gamma8(v) : v;
+    }
+  }
+
+  for (uint16_t i = first, end = first + count; i < end; i++) {
+    uint16_t hue = (reps < 0) ? first_hue - offset : first_hue + offset;
+    uint32_t color;
+    if (useLut) {
+      color = ColorHue(hue);
+      color = ((uint32_t)lut[(uint8_t)(color >> 16)] << 16) |
+              ((uint16_t)lut[(uint8_t)(color >> 8)] << 8) |
+              lut[(uint8_t)color];
+    } else {
+      color = ColorHSV(hue, saturation, brightness);
+      if (gammify)
+        color = gamma32(color);
+    }
     setPixelColor(i, color);
+    offset += q;
+    if ((rem += r) >= numLEDs) {
+      rem -= numLEDs;
+      offset++;
+    }
   }
 }
+
+/*!
+  @brief   Adafruit_DotStarCapture constructor.
+  @param   size  Capacity of capture buffer in bytes. Frames larger than
+                 this are truncated (see overflowed()). Use
+                 Adafruit_DotStar::getFrameBytes() for the exact size.
+*/
+Adafruit_DotStarCapture::Adafruit_DotStarCapture(uint32_t size)
+    : buf((uint8_t *)malloc(size)), capacity(buf ? size : 0) {}
+
+/*!
+  @brief   Deallocate Adafruit_DotStarCapture object.
+*/
+Adafruit_DotStarCapture::~Adafruit_DotStarCapture(void) { free(buf); }
+
+/*!
+  @brief   Append one byte to the frame in progress.
+  @param   b  Byte to append.
+  @return  1 (byte accepted, even if discarded on overflow).
+*/
+size_t Adafruit_DotStarCapture::write(uint8_t b) { return write(&b, 1); }
+
+/*!
+  @brief   Append bytes to the frame in progress.
+  @param   data  Bytes to append.
+  @param   len   Number of bytes.
+  @return  len (bytes accepted, even if discarded on overflow).
+*/
+size_t Adafruit_DotStarCapture::write(const uint8_t *data, size_t len) {
+  uint32_t n = (len < capacity - pos) ? len : capacity - pos;
+  if (n)
+    memcpy(&buf[pos], data, n);
+  if (n < len)
+    overflow = true;
+  pos += n;
+  total += len;
+  return len;
+}
+
+/*!
+  @brief   Mark the end of a frame (called by Adafruit_DotStar). The frame
+           in progress becomes the one returned by getFrame() and the next
+           write starts a new frame.
+*/
+void Adafruit_DotStarCapture::flush(void) {
+  length = pos;
+  pos = 0;
+  frames++;
+}
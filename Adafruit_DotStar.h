@@ -33,7 +33,20 @@
 #define DOTSTAR_GBR (2 | (0 << 2) | (1 << 4)) ///< Transmit as G,B,R
 #define DOTSTAR_BRG (1 | (2 << 2) | (0 << 4)) ///< Transmit as B,R,G
 #define DOTSTAR_BGR (2 | (1 << 2) | (0 << 4)) ///< Transmit as B,G,R
-#define DOTSTAR_MONO 0 ///< Single-color strip WIP DO NOT USE, use RGB for now
+#define DOTSTAR_MONO 0 ///< Single-color strip, 10 bits/pixel
+
+// show() encodes pixels into a small stack buffer and issues it to the SPI
+// device this many pixels at a time (4 bytes each). Larger values mean fewer
+// (but bigger) SPI transfers at the expense of stack space.
+#ifndef DOTSTAR_CHUNK_PIXELS
+#define DOTSTAR_CHUNK_PIXELS 16 ///< Pixels per SPI transfer in show()
+#endif
+
+// Default SPI clock rate, unless passed to constructor or setClockSpeed().
+// Short runs of APA102 can often go much faster; long runs may need less.
+#ifndef DOTSTAR_CLOCK_SPEED
+#define DOTSTAR_CLOCK_SPEED 8000000 ///< Default SPI clock, Hz
+#endif
 
 // These two tables are declared outside the Adafruit_DotStar class
 // because some boards may require oldschool compilers that don't
@@ -104,36 +117,152 @@ public:
 #if !defined(SPI_INTERFACES_COUNT) ||                                          \
     (defined(SPI_INTERFACES_COUNT) && (SPI_INTERFACES_COUNT > 0))
   // HW SPI available
-  Adafruit_DotStar(uint16_t n, uint8_t o = DOTSTAR_BRG, SPIClass *spi = &SPI);
+  Adafruit_DotStar(uint16_t n, uint8_t o = DOTSTAR_BRG, SPIClass *spi = &SPI,
+                   uint32_t freq = DOTSTAR_CLOCK_SPEED);
 #else
-  Adafruit_DotStar(uint16_t n, uint8_t o = DOTSTAR_BRG, SPIClass *spi = NULL);
+  Adafruit_DotStar(uint16_t n, uint8_t o = DOTSTAR_BRG, SPIClass *spi = NULL,
+                   uint32_t freq = DOTSTAR_CLOCK_SPEED);
 #endif
-  Adafruit_DotStar(uint16_t n, uint8_t d, uint8_t c, uint8_t o = DOTSTAR_BRG);
+  Adafruit_DotStar(uint16_t n, uint8_t d, uint8_t c, uint8_t o = DOTSTAR_BRG,
+                   uint32_t freq = DOTSTAR_CLOCK_SPEED);
   ~Adafruit_DotStar(void);
 
   void begin(void);
   void show(void);
+  void show(void (*source)(Adafruit_DotStar *, uint16_t, uint32_t *, uint16_t),
+            uint16_t n = 0);
+  void showEncoded(const uint8_t *frame, uint32_t len);
   void setPixelColor(uint16_t n, uint32_t c);
   void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b);
   void fill(uint32_t c = 0, uint16_t first = 0, uint16_t count = 0);
+  void setPixels(uint16_t first, const uint32_t *colors, uint16_t count);
+  uint16_t readPixels(Stream &in, uint16_t first, uint16_t count,
+                      uint8_t order = DOTSTAR_RGB);
+  void shift(int32_t n, uint32_t c = 0);
+  void rotate(int32_t n);
+  void fade(uint8_t scale, uint16_t first = 0, uint16_t count = 0);
+  void blend(const Adafruit_DotStar &a, const Adafruit_DotStar &b,
+             uint8_t amount);
+  void add(const Adafruit_DotStar &src);
+  void blur(uint8_t amount, uint16_t first = 0, uint16_t count = 0);
   void setBrightness(uint8_t);
+  void setHardwareBrightness(bool enable);
+  bool setPixelBrightness(uint16_t n, uint8_t level);
+  uint8_t getPixelBrightness(uint16_t n) const;
+  bool setGammaCorrection(bool enable);
+  bool setWhiteBalance(uint8_t r, uint8_t g, uint8_t b);
+  bool setDithering(bool enable);
+  bool setPaletteMode(uint8_t bits);
+  /*!
+    @brief   Query the pixel storage mode.
+    @return  Bits per pixel if palette-indexed (4 or 8), else 0.
+  */
+  uint8_t getPaletteMode(void) const { return paletteBits; };
+  void setPaletteColor(uint8_t i, uint32_t c);
+  uint32_t getPaletteColor(uint8_t i) const;
+  void setPixelIndex(uint16_t n, uint8_t i);
+  uint8_t getPixelIndex(uint16_t n) const;
   void clear();
   void updateLength(uint16_t n);
   void updatePins(void);
   void updatePins(uint8_t d, uint8_t c);
+  void setClockSpeed(uint32_t freq);
+  /*!
+    @brief   Query the SPI clock rate.
+    @return  Clock rate in Hz, as passed to the constructor or
+             setClockSpeed().
+  */
+  uint32_t getClockSpeed(void) const { return clockSpeed; };
+  uint32_t measureShowTime(uint32_t freq, uint16_t frames = 10);
+  bool setFrameBuffer(bool enable);
+  bool showAsync(void);
+  bool poll(void);
+  void waitForShow(void);
+  /*!
+    @brief   Check whether a frame started with showAsync() is still being
+             issued to the strip.
+    @return  true if busy, false if idle.
+  */
+  bool isBusy(void) const { return busy; };
+  /*!
+    @brief   Set a function to be called whenever a frame started with
+             showAsync() has been completely issued to the strip.
+    @param   cb  Callback function, receives a pointer to this
+                 Adafruit_DotStar object. NULL to disable.
+  */
+  void setShowCallback(void (*cb)(Adafruit_DotStar *)) { showCallback = cb; };
+  void setOutput(Print *out, bool spi = false);
+  void setDirtyTracking(bool enable);
+  void markDirty(uint16_t first = 0, uint16_t count = 0);
+  /*!
+    @brief   Check whether any pixels or the brightness setting have
+             changed since the last call to show() or showAsync().
+    @return  true if changed, false if unchanged.
+  */
+  bool isDirty(void) const { return dirtyFirst < dirtyEnd; };
+  /*!
+    @brief   Get the number of show() or showAsync() calls skipped by
+             dirty tracking because nothing had changed.
+    @return  Count of skipped frames since begin() or resetCounters().
+  */
+  uint32_t getFramesSkipped(void) const { return framesSkipped; };
+  /*!
+    @brief   Get the number of pixels encoded for issue to the strip.
+             Pixels reused from the frame buffer aren't counted, see
+             setFrameBuffer().
+    @return  Count of encoded pixels since begin() or resetCounters().
+  */
+  uint32_t getPixelsEncoded(void) const { return pixelsEncoded; };
+  void setPowerModel(uint16_t red, uint16_t green, uint16_t blue,
+                     uint16_t idle);
+  /*!
+    @brief   Set a current budget that show() keeps the strip within, by
+             lowering the brightness of any frame that would exceed it
+             (the brightness setting itself is unchanged). Requires a
+             power model, see setPowerModel(). With hardware brightness,
+             frames are dimmed in its 31 steps, rounding down.
+    @param   mA  Budget in milliamps, 0 (default) for no limit.
+  */
+  void setPowerLimit(uint32_t mA) { powerLimit = mA; };
+  uint32_t getPowerEstimate(void);
+  /*!
+    @brief   Get the estimated current of the last frame issued by show()
+             or showAsync(), after any limiting.
+    @return  Estimate in milliamps, 0 if there's no power model.
+  */
+  uint32_t getFramePower(void) const { return framePower; };
+  /*!
+    @brief   Get the brightness the last frame was issued at, which is
+             lower than getBrightness() if it was limited.
+    @return  Brightness, 0-255, as with getBrightness().
+  */
+  uint8_t getFrameBrightness(void) const { return frameBrightness - 1; };
+  /*!
+    @brief   Get the number of frames whose brightness was lowered to stay
+             within the power limit.
+    @return  Count of limited frames since begin() or resetCounters().
+  */
+  uint32_t getFramesLimited(void) const { return framesLimited; };
+  void resetCounters(void);
+  uint32_t getFrameBytes(void) const;
   /*!
     @brief   Get a pointer directly to the DotStar data buffer in RAM.
              Pixel data is stored in a device-native format (a la the
              DOTSTAR_* constants) and is not translated here. Applications
              that access this buffer will need to be aware of the specific
-             data format and handle colors appropriately.
+             data format and handle colors appropriately. In palette mode
+             (setPaletteMode()) this holds palette indices, not colors.
     @return  Pointer to DotStar buffer (uint8_t* array).
     @note    This is for high-performance applications where calling
              setPixelColor() on every single pixel would be too slow (e.g.
              POV or light-painting projects). There is no bounds checking
              on the array, creating tremendous potential for mayhem if one
              writes past the ends of the buffer. Great power, great
-             responsibility and all that.
+             responsibility and all that. If dirty tracking is enabled,
+             call markDirty() after changing pixels here, else show()
+             won't know to issue them. Pixels can also be generated on
+             the fly with no buffer at all, see show() with a source
+             function.
   */
   uint8_t *getPixels(void) const { return pixels; };
   uint8_t getBrightness(void) const;
@@ -143,6 +272,8 @@ public:
   */
   uint16_t numPixels(void) const { return numLEDs; };
   uint32_t getPixelColor(uint16_t n) const;
+  void setPixelLevel(uint16_t n, uint16_t level);
+  uint16_t getPixelLevel(uint16_t n) const;
   /*!
     @brief   An 8-bit integer sine wave function, not directly compatible
              with standard trigonometric units like radians or degrees.
@@ -187,20 +318,410 @@ public:
     return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
   }
   static uint32_t ColorHSV(uint16_t hue, uint8_t sat = 255, uint8_t val = 255);
+  static uint32_t ColorHue(uint16_t hue);
   static uint32_t gamma32(uint32_t x);
 
   void rainbow(uint16_t first_hue = 0, int8_t reps = 1,
                uint8_t saturation = 255, uint8_t brightness = 255,
                boolean gammify = true);
 
-private:
+protected:
+  void setLength(uint16_t n);
+  uint32_t bufferBytes(uint16_t n) const;
+  void rainbowSpan(uint16_t first_hue, int8_t reps, uint8_t saturation,
+                   uint8_t brightness, bool gammify, uint16_t first,
+                   uint16_t count);
+  /*!
+    @brief   Expand the dirty span to include a range of pixels, for
+             changes that leave pixel values as they were (output
+             settings) or that have already been applied to the power
+             estimate's sums.
+    @param   first  Index of first changed pixel.
+    @param   end    Index ONE AFTER the last changed pixel.
+  */
+  void touchSpan(uint16_t first, uint16_t end) {
+    if (first < dirtyFirst)
+      dirtyFirst = first;
+    if (end > dirtyEnd)
+      dirtyEnd = end;
+  }
+  /*!
+    @brief   Expand the dirty span to include a range of changed pixels,
+             and have the power estimate recounted when next needed.
+    @param   first  Index of first changed pixel.
+    @param   end    Index ONE AFTER the last changed pixel.
+  */
+  void touch(uint16_t first, uint16_t end) {
+    touchSpan(first, end);
+    powerCounted = false;
+  }
+  void encodeRGB(uint8_t *out, const uint8_t *ptr, const uint8_t *lvl,
+                 uint8_t *err, uint16_t count, uint8_t bright) const;
+  void useLUT(uint8_t bright);
+  uint8_t limitBrightness(uint64_t color, uint64_t idle);
+  void endFrame(uint8_t *buf, uint16_t size, uint32_t count);
+  void transmit(uint8_t *buf, uint32_t len);
+  void sendFrame(void);
+  void softTransfer(const uint8_t *buf, uint32_t len);
+
   Adafruit_SPIDevice *spi_dev = NULL; ///< Pointer to SPI bus interface
+  SPIClass *spiBus = NULL;            ///< Hardware SPI bus, if passed in
+  int8_t dataPin = -1;                ///< Soft SPI data pin, -1 = hardware
+  int8_t clockPin = -1;               ///< Soft SPI clock pin, -1 = hardware
+  uint32_t clockSpeed;                ///< SPI clock rate, Hz
+  bool fastSoftSPI = false;           ///< If set, use softTransfer()
+#ifdef BUSIO_USE_FAST_PINIO
+  BusIO_PortReg *dataPort;            ///< Soft SPI data pin PORT register
+  BusIO_PortMask dataMask;            ///< Soft SPI data pin bitmask
+  BusIO_PortReg *clockPort;           ///< Soft SPI clock pin PORT register
+  BusIO_PortMask clockMask;           ///< Soft SPI clock pin bitmask
+#endif
   uint16_t numLEDs;                   ///< Number of pixels
   uint8_t brightness;                 ///< Global brightness setting
   uint8_t *pixels;                    ///< LED RGB values (3 bytes ea.)
+  uint16_t fixedPixels = 0;           ///< Size of non-heap pixels, else 0
+  uint8_t *palette = NULL;            ///< Palette RGB values (3 bytes ea.)
+  uint8_t paletteBits = 0;            ///< Bits/pixel if palette, else 0
+  uint8_t *frame = NULL;              ///< Optional full wire-format frame
+  bool frameValid = false;            ///< If set, frame holds last show()
+  uint8_t *levels = NULL;             ///< Optional 5-bit per-pixel brightness
+  bool hwBrightness = false;          ///< If set, brightness -> 5-bit field
+  uint8_t *lut = NULL;                ///< Output table(s), or NULL if unused
+  uint16_t lutStride = 0;             ///< 256 if per-channel tables, else 0
+  uint8_t lutBrightness = 0;          ///< brightness lut was filled for
+  bool gammaOut = false;              ///< If set, gamma-correct on output
+  uint8_t white[3] = {255, 255, 255}; ///< White balance R, G, B
+  uint8_t *dither = NULL;             ///< Optional dither remainders
+  uint8_t *front = NULL;              ///< Copy of pixels for showAsync()
+  uint16_t sendPos = 0;               ///< Next pixel to issue in showAsync()
+  uint8_t frontBrightness = 0;        ///< brightness at time of showAsync()
+  bool busy = false;                  ///< true if showAsync() in progress
+  void (*showCallback)(Adafruit_DotStar *) = NULL; ///< Frame-done callback
+  bool dirtyTracking = false;         ///< If set, skip show() if unchanged
+  uint16_t dirtyFirst = 0;            ///< First changed pixel since show()
+  uint16_t dirtyEnd = 0;              ///< One past last changed pixel
+  uint32_t framesSkipped = 0;         ///< show() calls skipped if unchanged
+  uint32_t pixelsEncoded = 0;         ///< Pixels issued by show()
+  uint16_t powerStep[3] = {0, 0, 0};  ///< uA per step of R, G, B
+  uint16_t powerIdle = 0;             ///< uA per pixel when dark
+  bool powerModel = false;            ///< If set, estimate power
+  bool powerCounted = false;          ///< If set, powerSum is up to date
+  uint32_t powerSum[3] = {0, 0, 0};   ///< Sums of R, G, B over all pixels
+  uint32_t powerLimit = 0;            ///< Current budget, mA (0 = none)
+  uint32_t framePower = 0;            ///< Estimate for last frame, mA
+  uint8_t frameBrightness = 0;        ///< brightness last frame issued at
+  uint32_t framesLimited = 0;         ///< Frames dimmed by power limit
+  Print *output = NULL;               ///< Wire-format output, see setOutput()
+  bool outputSPI = false;             ///< If set, also issue to SPI
   uint8_t rOffset;                    ///< Index of red in 3-byte pixel
   uint8_t gOffset;                    ///< Index of green byte
   uint8_t bOffset;                    ///< Index of blue byte
+
+private:
+  void encode(uint8_t *out, const uint8_t *src, uint16_t first,
+              uint16_t count, uint8_t bright) const;
+  void newDevice(void);
+  bool updateLUT(void);
+  void fillLUT(uint8_t bright);
+  static uint16_t monoLevel(uint32_t c);
+  uint8_t paletteIndex(uint32_t c) const;
+  void reversePixels(uint16_t first, uint16_t end);
+  bool sameFormat(const Adafruit_DotStar &s) const;
+  void countPower(void);
+  uint64_t powerAt(uint16_t scale);
+  uint8_t limitBrightness(void);
+  /*!
+    @brief   Apply a pixel's change of color to the power estimate's sums,
+             if they're being kept up to date.
+    @param   p  Pixel's 3 bytes in the pixel buffer, before the change.
+    @param   r  New red value.
+    @param   g  New green value.
+    @param   b  New blue value.
+  */
+  void recount(const uint8_t *p, uint8_t r, uint8_t g, uint8_t b) {
+    if (powerCounted) {
+      powerSum[0] += r - p[rOffset];
+      powerSum[1] += g - p[gOffset];
+      powerSum[2] += b - p[bOffset];
+    }
+  }
+  // MONO pixel buffers hold the upper 8 bits of each pixel's 10-bit level
+  // in numLEDs bytes, followed by the lower 2 bits of each, packed four
+  // pixels per byte (pixel 0 in the least significant bits).
+  /*!
+    @brief   Read a 10-bit level from a MONO pixel buffer.
+    @param   buf  Pixel buffer (pixels or front).
+    @param   n    Pixel index.
+    @return  Level, 0 to 1023.
+  */
+  uint16_t monoGet(const uint8_t *buf, uint16_t n) const {
+    return ((uint16_t)buf[n] << 2) |
+           ((buf[numLEDs + (n >> 2)] >> ((n & 3) * 2)) & 3);
+  }
+  /*!
+    @brief   Store a 10-bit level in the MONO pixel buffer.
+    @param   n  Pixel index.
+    @param   v  Level, 0 to 1023.
+  */
+  void monoSet(uint16_t n, uint16_t v) {
+    uint8_t *lo = &pixels[numLEDs + (n >> 2)], s = (n & 3) * 2;
+    pixels[n] = v >> 2;
+    *lo = (*lo & ~(3 << s)) | ((v & 3) << s);
+  }
+  // Palette-indexed pixel buffers hold one index per byte (8 bits/pixel)
+  // or two (4 bits/pixel, pixel 0 in the least significant bits).
+  /*!
+    @brief   Read a palette index from a palette-indexed pixel buffer.
+    @param   buf  Pixel buffer (pixels or front).
+    @param   n    Pixel index.
+    @return  Palette index.
+  */
+  uint8_t indexGet(const uint8_t *buf, uint16_t n) const {
+    return (paletteBits == 8) ? buf[n] : (buf[n >> 1] >> ((n & 1) * 4)) & 15;
+  }
+  /*!
+    @brief   Store a palette index in the palette-indexed pixel buffer.
+    @param   n  Pixel index.
+    @param   i  Palette index, 0 to 15 or 255.
+  */
+  void indexSet(uint16_t n, uint8_t i) {
+    if (paletteBits == 8) {
+      pixels[n] = i;
+    } else {
+      uint8_t *p = &pixels[n >> 1], s = (n & 1) * 4;
+      *p = (*p & ~(15 << s)) | ((i & 15) << s);
+    }
+  }
+  /*!
+    @brief   Read a pixel's value from a MONO or 4-bit palette buffer.
+    @param   n  Pixel index.
+    @return  10-bit level or palette index.
+  */
+  uint16_t packedGet(uint16_t n) const {
+    return paletteBits ? indexGet(pixels, n) : monoGet(pixels, n);
+  }
+  /*!
+    @brief   Store a pixel's value in a MONO or 4-bit palette buffer.
+    @param   n  Pixel index.
+    @param   v  10-bit level or palette index.
+  */
+  void packedSet(uint16_t n, uint16_t v) {
+    if (paletteBits)
+      indexSet(n, v);
+    else
+      monoSet(n, v);
+  }
+
+  friend class Adafruit_DotStarGroup;
+  friend class Adafruit_DotStarLayout;
+  friend class Adafruit_DotStarRender;
+};
+
+/*!
+  @brief  A Print object that captures wire-format output from
+          Adafruit_DotStar::setOutput() in RAM, for verifying show()
+          output byte-for-byte or measuring it without DotStars attached.
+          The most recent complete frame is retained.
+*/
+class Adafruit_DotStarCapture : public Print {
+
+public:
+  Adafruit_DotStarCapture(uint32_t size);
+  ~Adafruit_DotStarCapture(void);
+
+  size_t write(uint8_t b);
+  size_t write(const uint8_t *data, size_t len);
+  void flush(void);
+  /*!
+    @brief   Get a pointer to the most recent complete frame.
+    @return  Pointer to captured bytes (NULL if buffer allocation failed).
+  */
+  const uint8_t *getFrame(void) const { return buf; };
+  /*!
+    @brief   Get the length of the most recent complete frame.
+    @return  Frame length in bytes, as stored (may be truncated).
+  */
+  uint32_t getFrameLength(void) const { return length; };
+  /*!
+    @brief   Get the number of complete frames captured.
+    @return  Frame count.
+  */
+  uint32_t getFrames(void) const { return frames; };
+  /*!
+    @brief   Get the total number of bytes written, including any that
+             didn't fit in the capture buffer.
+    @return  Byte count.
+  */
+  uint32_t getBytes(void) const { return total; };
+  /*!
+    @brief   Check whether any frame was larger than the capture buffer.
+    @return  true if data was discarded, false if not.
+  */
+  bool overflowed(void) const { return overflow; };
+
+protected:
+  uint8_t *buf;          ///< Capture buffer
+  uint32_t capacity;     ///< Size of buf
+  uint32_t pos = 0;      ///< Write position within frame in progress
+  uint32_t length = 0;   ///< Length of last complete frame
+  uint32_t frames = 0;   ///< Complete frames captured
+  uint32_t total = 0;    ///< Total bytes written
+  bool overflow = false; ///< Set if any frame exceeded capacity
+};
+
+/*!
+  @brief  Variant of Adafruit_DotStar with the color order (and optionally
+          the pixel count) fixed at compile time. Pixel writes and reads
+          then use constant byte offsets the compiler can fold, rather
+          than the rOffset/gOffset/bOffset lookups of the base class, and
+          with a nonzero pixel count the pixel buffer is a static array
+          rather than malloc'd. Constructors take the same arguments as
+          Adafruit_DotStar, so existing sketches can switch by changing
+          just the type, e.g.:
+          Adafruit_DotStarStrip<DOTSTAR_BGR, 60> strip(60, DOTSTAR_BGR);
+  @tparam ORDER  One of the DOTSTAR_* color-order constants. Not
+                 DOTSTAR_MONO, which isn't 3 bytes per pixel.
+  @tparam N      Pixel count for a static buffer, or 0 (default) to use
+                 the heap like Adafruit_DotStar.
+  @note   The color order argument to the constructors is ignored, ORDER
+          takes precedence. With nonzero N, updateLength() can only change
+          the length within 0 to N pixels (whether called through this
+          type or a base pointer). The pixel functions below hide (rather
+          than override) those of Adafruit_DotStar, so the speedup only
+          applies when calling through this type, not a base pointer.
+          Palette-indexed storage (setPaletteMode()) isn't available, as
+          these functions assume 3 bytes per pixel.
+*/
+template <uint8_t ORDER, uint16_t N = 0>
+class Adafruit_DotStarStrip : public Adafruit_DotStar {
+
+public:
+#if !defined(SPI_INTERFACES_COUNT) ||                                          \
+    (defined(SPI_INTERFACES_COUNT) && (SPI_INTERFACES_COUNT > 0))
+  /*!
+    @brief   Constructor for hardware SPI, see Adafruit_DotStar.
+    @param   n     Number of DotStars in strand (at most N if nonzero).
+    @param   o     Ignored, ORDER template parameter is used instead.
+    @param   spi   Pointer to hardware SPIClass object.
+    @param   freq  SPI clock rate, Hz.
+  */
+  Adafruit_DotStarStrip(uint16_t n = N, uint8_t o = ORDER, SPIClass *spi = &SPI,
+                        uint32_t freq = DOTSTAR_CLOCK_SPEED)
+      : Adafruit_DotStar(N ? 0 : n, ORDER, spi, freq) {
+    (void)o;
+    useStatic(n);
+  }
+#else
+  /*!
+    @brief   Constructor for hardware SPI, see Adafruit_DotStar.
+    @param   n     Number of DotStars in strand (at most N if nonzero).
+    @param   o     Ignored, ORDER template parameter is used instead.
+    @param   spi   Pointer to hardware SPIClass object.
+    @param   freq  SPI clock rate, Hz.
+  */
+  Adafruit_DotStarStrip(uint16_t n = N, uint8_t o = ORDER, SPIClass *spi = NULL,
+                        uint32_t freq = DOTSTAR_CLOCK_SPEED)
+      : Adafruit_DotStar(N ? 0 : n, ORDER, spi, freq) {
+    (void)o;
+    useStatic(n);
+  }
+#endif
+  /*!
+    @brief   Constructor for 'soft' (bitbang) SPI, see Adafruit_DotStar.
+    @param   n     Number of DotStars in strand (at most N if nonzero).
+    @param   d     Arduino pin number for data out.
+    @param   c     Arduino pin number for clock out.
+    @param   o     Ignored, ORDER template parameter is used instead.
+    @param   freq  SPI clock rate, Hz.
+  */
+  Adafruit_DotStarStrip(uint16_t n, uint8_t d, uint8_t c, uint8_t o = ORDER,
+                        uint32_t freq = DOTSTAR_CLOCK_SPEED)
+      : Adafruit_DotStar(N ? 0 : n, d, c, ORDER, freq) {
+    (void)o;
+    useStatic(n);
+  }
+  /*!
+    @brief   Set a pixel's color using separate red, green and blue
+             components.
+    @param   n  Pixel index, starting from 0.
+    @param   r  Red brightness, 0 = minimum (off), 255 = maximum.
+    @param   g  Green brightness, 0 = minimum (off), 255 = maximum.
+    @param   b  Blue brightness, 0 = minimum (off), 255 = maximum.
+  */
+  void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b) {
+    if (n < numLEDs) {
+      uint8_t *p = &pixels[n * 3];
+      touch(n, n + 1);
+      p[ORDER & 3] = r;
+      p[(ORDER >> 2) & 3] = g;
+      p[(ORDER >> 4) & 3] = b;
+    }
+  }
+  /*!
+    @brief   Set a pixel's color using a 32-bit 'packed' RGB value.
+    @param   n  Pixel index, starting from 0.
+    @param   c  32-bit color value, 0x00RRGGBB.
+  */
+  void setPixelColor(uint16_t n, uint32_t c) {
+    setPixelColor(n, (uint8_t)(c >> 16), (uint8_t)(c >> 8), (uint8_t)c);
+  }
+  /*!
+    @brief   Query the color of a previously-set pixel.
+    @param   n  Index of pixel to read (0 = first).
+    @return  'Packed' 32-bit RGB value, 0x00RRGGBB.
+  */
+  uint32_t getPixelColor(uint16_t n) const {
+    if (n >= numLEDs)
+      return 0;
+    const uint8_t *p = &pixels[n * 3];
+    return ((uint32_t)p[ORDER & 3] << 16) |
+           ((uint32_t)p[(ORDER >> 2) & 3] << 8) | p[(ORDER >> 4) & 3];
+  }
+  /*!
+    @brief   Fill all or part of the strip with a color, see
+             Adafruit_DotStar::fill(). The color is converted to
+             device-native order once, then stored as a 3-byte pattern.
+    @param   c      32-bit color value, 0x00RRGGBB.
+    @param   first  Index of first pixel to fill. 0 if unspecified.
+    @param   count  Number of pixels to fill, 0 (default) = to end.
+  */
+  void fill(uint32_t c = 0, uint16_t first = 0, uint16_t count = 0) {
+    if (first >= numLEDs)
+      return;
+    uint16_t end = (count && (count < numLEDs - first)) ? first + count
+                                                        : numLEDs;
+    uint8_t pat[3];
+    pat[ORDER & 3] = (uint8_t)(c >> 16);
+    pat[(ORDER >> 2) & 3] = (uint8_t)(c >> 8);
+    pat[(ORDER >> 4) & 3] = (uint8_t)c;
+    touch(first, end);
+    for (uint8_t *p = &pixels[first * 3], *e = &pixels[end * 3]; p < e;
+         p += 3) {
+      p[0] = pat[0];
+      p[1] = pat[1];
+      p[2] = pat[2];
+    }
+  }
+
+private:
+  using Adafruit_DotStar::setPaletteMode; // 3 bytes/pixel only
+
+  /*!
+    @brief   Point base class at the static pixel buffer (if N is nonzero).
+             It's then never freed or reallocated, and updateLength()
+             (even through a base pointer) only changes the length within
+             it.
+    @param   n  Pixel count, clipped to N.
+  */
+  void useStatic(uint16_t n) {
+    if (N) {
+      pixels = buf;
+      fixedPixels = N;
+      updateLength(n);
+    }
+  }
+
+  uint8_t buf[N ? N * 3 : 1]; ///< Static pixel buffer, if N is nonzero
 };
 
 #endif // _ADAFRUIT_DOT_STAR_H_
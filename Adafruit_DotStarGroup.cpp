@@ -0,0 +1,334 @@
+/*!
+ * @file Adafruit_DotStarGroup.cpp
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "Adafruit_DotStarGroup.h"
+
+/*!
+  @brief   Adafruit_DotStarGroup constructor.
+  @param   clock  Arduino pin number for the clock output shared by all
+                  strips in the group.
+  @return  Adafruit_DotStarGroup object. Add strips with addStrip(), then
+           call the begin() function before use.
+*/
+Adafruit_DotStarGroup::Adafruit_DotStarGroup(uint8_t clock)
+    : clockPin(clock) {}
+
+/*!
+  @brief   Deallocate Adafruit_DotStarGroup object and all of its strips.
+*/
+Adafruit_DotStarGroup::~Adafruit_DotStarGroup(void) {
+#ifdef DOTSTAR_GROUP_TASKS
+  stop();
+#endif
+  for (uint8_t i = 0; i < count; i++)
+    delete strips[i];
+}
+
+/*!
+  @brief   Add a strip to the group, on its own data pin and the group's
+           clock pin. The returned Adafruit_DotStar object is owned by the
+           group and is used for drawing as usual; call the group's show()
+           rather than the strip's to refresh it.
+  @param   n     Number of DotStars in strip.
+  @param   data  Arduino pin number for this strip's data out.
+  @param   o     Pixel type -- one of the DOTSTAR_* constants, default is
+                 DOTSTAR_BRG.
+  @return  Pointer to Adafruit_DotStar object, or NULL if the group is
+           full (DOTSTAR_GROUP_MAX) or out of memory.
+*/
+Adafruit_DotStar *Adafruit_DotStarGroup::addStrip(uint16_t n, uint8_t data,
+                                                  uint8_t o) {
+  if (count >= DOTSTAR_GROUP_MAX)
+    return NULL;
+  Adafruit_DotStar *s = new Adafruit_DotStar(n, data, clockPin, o);
+  if (s) {
+    strips[count++] = s;
+    dataPin[clockedCount] = data;
+    clocked[clockedCount++] = s;
+  }
+  return s;
+}
+
+/*!
+  @brief   Add a strip to the group, on an SPI bus of its own. It's shown
+           with its own show(), concurrently with the group's other
+           strips where tasks are available (see numTasks()), so all of
+           its options (frame buffer, dirty tracking, setOutput() and so
+           on) apply. As with addStrip() for a data pin, the group owns
+           the strip and its show() refreshes it.
+  @param   n     Number of DotStars in strip.
+  @param   spi   SPI bus, used by this strip alone.
+  @param   o     Pixel type -- one of the DOTSTAR_* constants, default is
+                 DOTSTAR_BRG.
+  @param   freq  SPI clock rate, Hz.
+  @return  Pointer to Adafruit_DotStar object, or NULL if the group is
+           full (DOTSTAR_GROUP_MAX) or out of memory.
+*/
+Adafruit_DotStar *Adafruit_DotStarGroup::addStrip(uint16_t n, SPIClass *spi,
+                                                  uint8_t o, uint32_t freq) {
+  if (count >= DOTSTAR_GROUP_MAX)
+    return NULL;
+  Adafruit_DotStar *s = new Adafruit_DotStar(n, o, spi, freq);
+  if (s) {
+    strips[count++] = s;
+    buses[busCount++] = s;
+  }
+  return s;
+}
+
+/*!
+  @brief   Initialize Adafruit_DotStarGroup object -- sets the clock and
+           all data pins to outputs, begins the SPI strips and starts a
+           task for each where available. Call after all strips are added.
+*/
+void Adafruit_DotStarGroup::begin(void) {
+  uint8_t i;
+  pinMode(clockPin, OUTPUT);
+  digitalWrite(clockPin, LOW);
+  for (i = 0; i < clockedCount; i++) {
+    pinMode(dataPin[i], OUTPUT);
+    digitalWrite(dataPin[i], LOW);
+  }
+  for (i = 0; i < busCount; i++)
+    buses[i]->begin();
+#ifdef BUSIO_USE_FAST_PINIO
+  clockPort = (BusIO_PortReg *)portOutputRegister(digitalPinToPort(clockPin));
+  clockMask = digitalPinToBitMask(clockPin);
+  allMask = 0;
+  samePort = true;
+  for (i = 0; i < clockedCount; i++) {
+    dataPort[i] =
+        (BusIO_PortReg *)portOutputRegister(digitalPinToPort(dataPin[i]));
+    dataMask[i] = digitalPinToBitMask(dataPin[i]);
+    allMask |= dataMask[i];
+    if (dataPort[i] != clockPort)
+      samePort = false;
+  }
+#endif
+#ifdef DOTSTAR_GROUP_TASKS
+  stop();
+  if (!busCount || !(done = xSemaphoreCreateCounting(busCount, 0)))
+    return;
+  UBaseType_t priority = uxTaskPriorityGet(NULL);
+  for (; taskCount < busCount; taskCount++) {
+    Task *t = &tasks[taskCount];
+    t->strip = buses[taskCount];
+    t->done = done;
+    if (!(t->start = xSemaphoreCreateBinary()))
+      break;
+    if (xTaskCreatePinnedToCore(task, "DotStarBus", DOTSTAR_GROUP_STACK, t,
+                                priority, &t->task,
+                                tskNO_AFFINITY) != pdPASS) {
+      vSemaphoreDelete(t->start);
+      break;
+    }
+  }
+  if (!taskCount)
+    stop();
+#endif
+}
+
+#ifdef DOTSTAR_GROUP_TASKS
+
+/*!
+  @brief   Stop all bus tasks and release their resources. Tasks are only
+           ever idle (waiting on their semaphore) outside of show(), so
+           they're deleted as-is.
+*/
+void Adafruit_DotStarGroup::stop(void) {
+  while (taskCount) {
+    Task *t = &tasks[--taskCount];
+    vTaskDelete(t->task);
+    vSemaphoreDelete(t->start);
+  }
+  if (done) {
+    vSemaphoreDelete(done);
+    done = NULL;
+  }
+}
+
+/*!
+  @brief   Bus task: wait to be started, show its strip, signal it's done,
+           repeat.
+  @param   arg  Pointer to this task's Task state.
+*/
+void Adafruit_DotStarGroup::task(void *arg) {
+  Task *t = (Task *)arg;
+  for (;;) {
+    xSemaphoreTake(t->start, portMAX_DELAY);
+    t->strip->show();
+    xSemaphoreGive(t->done);
+  }
+}
+
+#endif // DOTSTAR_GROUP_TASKS
+
+/*!
+  @brief   Return the number of bytes of the longest frame issued by
+           show(), which sets the time it takes. Strips on the shared
+           clock are padded to the longest of them, a multiple of 4 bytes.
+  @return  Frame size in bytes.
+*/
+uint32_t Adafruit_DotStarGroup::getFrameBytes(void) const {
+  uint32_t len = 0, n;
+  uint8_t i;
+  for (i = 0; i < clockedCount; i++) {
+    if ((n = clocked[i]->getFrameBytes()) > len)
+      len = n;
+  }
+  len = (len + 3) & ~3; // Issued 4 bytes at a time
+  for (i = 0; i < busCount; i++) {
+    if ((n = buses[i]->getFrameBytes()) > len)
+      len = n;
+  }
+  return len;
+}
+
+/*!
+  @brief   Transmit pixel data in RAM to all strips in the group
+           concurrently: strips on SPI buses with their own show() (on
+           their own tasks, if available), while the calling task clocks
+           out the strips sharing the clock pin.
+  @note    On the shared clock, strips shorter than the longest are padded
+           with additional end-frame (0xFF) bytes, which is harmless. Each
+           strip's brightness, power limit (setPowerLimit()), hardware
+           brightness and output (setOutput()) apply as with its own
+           show(); a strip whose output replaces SPI has its data pin
+           held low, which it reads as more start frame. Its frame buffer
+           and dirty tracking are not used, though a pending showAsync()
+           frame is completed first.
+*/
+void Adafruit_DotStarGroup::show(void) {
+  uint8_t i = 0;
+#ifdef DOTSTAR_GROUP_TASKS
+  for (; i < taskCount; i++)
+    xSemaphoreGive(tasks[i].start);
+#endif
+  for (; i < busCount; i++) // Any without tasks
+    buses[i]->show();
+
+  if (clockedCount)
+    showClocked();
+
+#ifdef DOTSTAR_GROUP_TASKS
+  for (i = 0; i < taskCount; i++)
+    xSemaphoreTake(done, portMAX_DELAY);
+#endif
+}
+
+/*!
+  @brief   Clock out the strips sharing the clock pin, bit-parallel.
+*/
+void Adafruit_DotStarGroup::showClocked(void) {
+  uint8_t buf[DOTSTAR_GROUP_MAX][4], bright[DOTSTAR_GROUP_MAX], i, b;
+  uint32_t pos, px, len = 0, n;
+
+  for (i = 0; i < clockedCount; i++) {
+    clocked[i]->waitForShow();
+    bright[i] = clocked[i]->limitBrightness();
+    if ((n = clocked[i]->getFrameBytes()) > len)
+      len = n;
+  }
+
+  for (pos = 0; pos < len; pos += 4) {
+    // Encode the next 4 wire bytes of each strip: 0 = start frame,
+    // 1 to numLEDs = pixel data, beyond that = end frame.
+    px = pos / 4;
+    for (i = 0; i < clockedCount; i++) {
+      Adafruit_DotStar *s = clocked[i];
+      if (!px)
+        memset(buf[i], 0x00, 4);
+      else if ((px <= s->numLEDs) && s->pixels)
+        s->encode(buf[i], s->pixels, px - 1, 1, bright[i]);
+      else
+        memset(buf[i], 0xFF, 4);
+      if (s->output) {
+        n = s->getFrameBytes();
+        if (pos < n)
+          s->output->write(buf[i], (n - pos < 4) ? n - pos : 4);
+        if (!s->outputSPI)
+          memset(buf[i], 0x00, 4);
+      }
+    }
+    for (b = 0; b < 4; b++)
+      writeByte(buf, b);
+  }
+
+  for (i = 0; i < clockedCount; i++) {
+    Adafruit_DotStar *s = clocked[i];
+    s->dirtyFirst = s->numLEDs; // Mark clean
+    s->dirtyEnd = 0;
+    s->frameValid = false; // Changes since the last show() aren't in frame
+    s->pixelsEncoded += s->numLEDs;
+    if (s->output)
+      s->output->flush(); // Mark end of frame
+  }
+}
+
+/*!
+  @brief   Clock out one byte (MSB first) to every strip on the shared
+           clock concurrently.
+  @param   buf  Per-strip 4-byte encode buffers.
+  @param   b    Index of byte within each buffer.
+*/
+void Adafruit_DotStarGroup::writeByte(uint8_t buf[][4], uint8_t b) {
+  uint8_t bit, i;
+#ifdef BUSIO_USE_FAST_PINIO
+  if (samePort) {
+    // One write sets every data bit for this clock cycle, a second
+    // raises the clock. Port state is sampled once per byte, with
+    // interrupts held off until the byte is out so an interrupt handler
+    // changing other pins on the port isn't undone by the stale copy.
+    noInterrupts();
+    BusIO_PortMask lo = *clockPort & ~(allMask | clockMask), bits;
+    for (bit = 0x80; bit; bit >>= 1) {
+      bits = lo;
+      for (i = 0; i < clockedCount; i++) {
+        if (buf[i][b] & bit)
+          bits |= dataMask[i];
+      }
+      *clockPort = bits;
+      *clockPort = bits | clockMask;
+    }
+    *clockPort = lo;
+    interrupts();
+    return;
+  }
+#endif
+  for (bit = 0x80; bit; bit >>= 1) {
+    for (i = 0; i < clockedCount; i++) {
+#ifdef BUSIO_USE_FAST_PINIO
+      if (buf[i][b] & bit)
+        *dataPort[i] |= dataMask[i];
+      else
+        *dataPort[i] &= ~dataMask[i];
+#else
+      digitalWrite(dataPin[i], (buf[i][b] & bit) ? HIGH : LOW);
+#endif
+    }
+#ifdef BUSIO_USE_FAST_PINIO
+    *clockPort |= clockMask;
+    *clockPort &= ~clockMask;
+#else
+    digitalWrite(clockPin, HIGH);
+    digitalWrite(clockPin, LOW);
+#endif
+  }
+}
@@ -0,0 +1,131 @@
+/*!
+ * @file Adafruit_DotStarGroup.h
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _ADAFRUIT_DOT_STAR_GROUP_H_
+#define _ADAFRUIT_DOT_STAR_GROUP_H_
+
+#include "Adafruit_DotStar.h"
+
+// Strips on their own SPI buses are shown on one task each where there's
+// FreeRTOS: ESP32, or the native build on Linux (extras/host), which runs
+// tasks on threads. Elsewhere they're shown one after another.
+#if defined(ESP32) || (defined(__linux__) && !defined(ARDUINO))
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#define DOTSTAR_GROUP_TASKS ///< Bus strips are shown on tasks
+#endif
+
+#ifndef DOTSTAR_GROUP_MAX
+#define DOTSTAR_GROUP_MAX 16 ///< Max strips per Adafruit_DotStarGroup
+#endif
+
+#ifndef DOTSTAR_GROUP_STACK
+#define DOTSTAR_GROUP_STACK 4096 ///< Bus task stack size, bytes
+#endif
+
+/*!
+  @brief  Class that drives several DotStar strips at once, so the time to
+          refresh the group is set by the longest strip rather than the
+          sum of all. Strips added with a data pin share one clock pin:
+          every clock pulse shifts one bit into ALL of them. If the clock
+          and all data pins are on the same GPIO port (and the board
+          supports direct port access), each bit is issued with a single
+          port write. Strips added with an SPI bus each have that bus to
+          themselves, and are shown concurrently on one task per bus
+          (ESP32, or the Linux host build), alongside the clocked strips.
+*/
+class Adafruit_DotStarGroup {
+
+public:
+  Adafruit_DotStarGroup(uint8_t clock);
+  ~Adafruit_DotStarGroup(void);
+
+  Adafruit_DotStar *addStrip(uint16_t n, uint8_t data,
+                             uint8_t o = DOTSTAR_BRG);
+  Adafruit_DotStar *addStrip(uint16_t n, SPIClass *spi,
+                             uint8_t o = DOTSTAR_BRG,
+                             uint32_t freq = DOTSTAR_CLOCK_SPEED);
+  void begin(void);
+  void show(void);
+  uint32_t getFrameBytes(void) const;
+  /*!
+    @brief   Return the number of strips in the group.
+    @return  Strip count, 0 to DOTSTAR_GROUP_MAX.
+  */
+  uint8_t numStrips(void) const { return count; };
+  /*!
+    @brief   Get one of the strips in the group, for use with
+             setPixelColor() and other drawing functions.
+    @param   i  Index of strip, in the order added (0 = first).
+    @return  Pointer to Adafruit_DotStar object, or NULL if out of range.
+  */
+  Adafruit_DotStar *getStrip(uint8_t i) const {
+    return (i < count) ? strips[i] : NULL;
+  };
+  /*!
+    @brief   Get the number of tasks started by begin() to show strips on
+             their own SPI buses.
+    @return  Task count, 0 if bus strips are shown one after another.
+  */
+  uint8_t numTasks(void) const { return taskCount; };
+
+private:
+  void showClocked(void);
+  void writeByte(uint8_t buf[][4], uint8_t b);
+
+  Adafruit_DotStar *strips[DOTSTAR_GROUP_MAX];  ///< Strips, in order added
+  Adafruit_DotStar *clocked[DOTSTAR_GROUP_MAX]; ///< Strips on clockPin
+  Adafruit_DotStar *buses[DOTSTAR_GROUP_MAX];   ///< Strips on SPI buses
+  uint8_t dataPin[DOTSTAR_GROUP_MAX];           ///< Data pin, clocked[]
+  uint8_t clockPin;                             ///< Shared clock pin
+  uint8_t count = 0;                            ///< Number of strips
+  uint8_t clockedCount = 0;                     ///< Number in clocked[]
+  uint8_t busCount = 0;                         ///< Number in buses[]
+  uint8_t taskCount = 0;                        ///< Tasks for buses[]
+#ifdef BUSIO_USE_FAST_PINIO
+  BusIO_PortReg *dataPort[DOTSTAR_GROUP_MAX]; ///< Data pin PORT registers
+  BusIO_PortMask dataMask[DOTSTAR_GROUP_MAX]; ///< Data pin bitmasks
+  BusIO_PortReg *clockPort;                   ///< Clock pin PORT register
+  BusIO_PortMask clockMask;                   ///< Clock pin bitmask
+  BusIO_PortMask allMask;                     ///< All data pins if samePort
+  bool samePort;                              ///< All pins on clockPort?
+#endif
+
+#ifdef DOTSTAR_GROUP_TASKS
+  /*!
+    @brief  State of one bus task: the strip it shows, and the semaphores
+            it waits on and signals.
+  */
+  struct Task {
+    Adafruit_DotStar *strip; ///< Strip shown by this task
+    TaskHandle_t task;       ///< Task handle
+    SemaphoreHandle_t start; ///< Given to start a show()
+    SemaphoreHandle_t done;  ///< Given by task when show() is done
+  } tasks[DOTSTAR_GROUP_MAX]; ///< Bus task states
+
+  static void task(void *arg);
+  void stop(void);
+
+  SemaphoreHandle_t done = NULL; ///< Counts bus strips shown
+#endif
+};
+
+#endif // _ADAFRUIT_DOT_STAR_GROUP_H_
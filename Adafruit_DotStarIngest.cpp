@@ -0,0 +1,146 @@
+/*!
+ * @file Adafruit_DotStarIngest.cpp
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "Adafruit_DotStarIngest.h"
+
+/*!
+  @brief   Adafruit_DotStarIngest constructor.
+  @param   strip   Pointer to Adafruit_DotStar object to receive frames.
+                   Call its begin() function as usual.
+  @param   in      Pointer to Stream to read from.
+  @param   format  DOTSTAR_INGEST_ADALIGHT (default) or DOTSTAR_INGEST_RAW.
+  @param   order   Color order of incoming data, one of the DOTSTAR_*
+                   color-order constants. Default is DOTSTAR_RGB, as used
+                   by Adalight.
+  @return  Adafruit_DotStarIngest object. Call run() from loop().
+  @note    DOTSTAR_INGEST_RAW frames are sized by the strip, so nothing is
+           read while it has no pixels (e.g. before updateLength()).
+*/
+Adafruit_DotStarIngest::Adafruit_DotStarIngest(Adafruit_DotStar *strip,
+                                               Stream *in, uint8_t format,
+                                               uint8_t order)
+    : strip(strip), in(in), format(format), order(order) {
+  reset();
+}
+
+/*!
+  @brief   Discard any partial frame and reset counters. With
+           DOTSTAR_INGEST_RAW, the next byte read is taken as the start of
+           a frame.
+*/
+void Adafruit_DotStarIngest::reset(void) {
+  frames = bytes = errors = 0;
+  state = 0;
+  if (format == DOTSTAR_INGEST_RAW)
+    startFrame();
+}
+
+/*!
+  @brief   Begin receiving pixel data for a frame.
+*/
+void Adafruit_DotStarIngest::startFrame(void) {
+  if (format == DOTSTAR_INGEST_RAW)
+    count = strip->numPixels();
+  pos = 0;
+  state = 6;
+}
+
+/*!
+  @brief   Consume any data available from the stream. Call this from
+           loop() as often as possible. Returns as soon as a frame is
+           complete, or when no more data is available (never waiting for
+           more), so the sketch stays responsive.
+  @return  true if a frame was completed (and, unless disabled with
+           setAutoShow(), shown), else false.
+*/
+bool Adafruit_DotStarIngest::run(void) {
+  static const char magic[] = "Ada";
+  int avail, c;
+  uint32_t n, k;
+
+  if ((format == DOTSTAR_INGEST_RAW) && !count) {
+    // Empty frames can't be told apart in a raw stream; pick up the strip
+    // length again in case it's changed, else leave the data be.
+    startFrame();
+    if (!count)
+      return false;
+  }
+
+  while ((avail = in->available()) > 0) {
+    if (state < 3) { // Looking for "Ada"
+      c = in->read();
+      bytes++;
+      if (c == magic[state])
+        state++;
+      else
+        state = (c == magic[0]); // Might be start of a new header
+      continue;
+    }
+
+    if (state < 6) { // Count & checksum
+      header[state - 3] = in->read();
+      bytes++;
+      if (++state == 6) {
+        if (header[2] == (header[0] ^ header[1] ^ 0x55)) {
+          count = (((uint32_t)header[0] << 8) | header[1]) + 1;
+          startFrame();
+        } else {
+          errors++;
+          // Resync: a real header may start within the rejected bytes
+          state = 0;
+          for (k = 0; k < 3; k++)
+            state = (header[k] == magic[state]) ? state + 1
+                                                : (header[k] == magic[0]);
+        }
+      }
+      continue;
+    }
+
+    // Pixel data, whole pixels only (anything less stays in the stream)
+    n = avail / 3;
+    if (n > count - pos)
+      n = count - pos;
+    if (n > 0xFFFF) // e.g. File::available() is the whole remaining file
+      n = 0xFFFF;
+    if (!n)
+      break;
+    if (pos < strip->numPixels()) { // Into the strip (clipped at its end)
+      if (!(n = strip->readPixels(*in, pos, n, order)))
+        break; // Timed out (shouldn't happen, data was available)
+    } else { // Past the end of the strip, discard
+      for (k = n * 3; k--;)
+        in->read();
+    }
+    pos += n;
+    bytes += n * 3;
+
+    if (pos >= count) {
+      frames++;
+      if (format == DOTSTAR_INGEST_RAW)
+        startFrame();
+      else
+        state = 0;
+      if (autoShow)
+        strip->show();
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,98 @@
+/*!
+ * @file Adafruit_DotStarIngest.h
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _ADAFRUIT_DOT_STAR_INGEST_H_
+#define _ADAFRUIT_DOT_STAR_INGEST_H_
+
+#include "Adafruit_DotStar.h"
+
+// Frame formats accepted by Adafruit_DotStarIngest:
+#define DOTSTAR_INGEST_RAW 0 ///< numPixels() * 3 bytes per frame, no header
+#define DOTSTAR_INGEST_ADALIGHT 1 ///< "Ada", count-1 (2 bytes), checksum
+
+/*!
+  @brief  Class that receives frames of pixel data from a Stream (Serial,
+          a file, network client or UDP packet, etc.) into a DotStar
+          strip, calling show() as each frame completes. Data goes
+          straight into the strip's pixel buffer (see
+          Adafruit_DotStar::readPixels()), and reading is non-blocking: each
+          call to run() consumes whatever has arrived so far.
+
+          Two formats are supported. DOTSTAR_INGEST_RAW frames are just
+          numPixels() * 3 color bytes, back to back, e.g. a file of
+          pre-rendered frames. DOTSTAR_INGEST_ADALIGHT is the Adalight
+          protocol used by many PC ambient-lighting and media-server
+          programs: the bytes 'A', 'd', 'a', then the pixel count minus 1
+          (high byte, low byte), a checksum (those two bytes XOR 0x55),
+          and the pixel data. The header lets a receiver resynchronize
+          after lost or corrupted data, and frames may be shorter or
+          longer than the strip (excess pixels are discarded).
+*/
+class Adafruit_DotStarIngest {
+
+public:
+  Adafruit_DotStarIngest(Adafruit_DotStar *strip, Stream *in,
+                         uint8_t format = DOTSTAR_INGEST_ADALIGHT,
+                         uint8_t order = DOTSTAR_RGB);
+
+  bool run(void);
+  void reset(void);
+  /*!
+    @brief   Enable or disable calling the strip's show() as each frame
+             completes. Enabled by default. When disabled, call show()
+             (or showAsync() etc.) when run() returns true.
+    @param   enable  true to show automatically, false to not.
+  */
+  void setAutoShow(bool enable) { autoShow = enable; };
+  /*!
+    @brief   Get the number of complete frames received.
+    @return  Frame count since construction or reset().
+  */
+  uint32_t getFrames(void) const { return frames; };
+  /*!
+    @brief   Get the number of bytes consumed from the stream.
+    @return  Byte count since construction or reset().
+  */
+  uint32_t getBytes(void) const { return bytes; };
+  /*!
+    @brief   Get the number of Adalight headers rejected due to a bad
+             checksum.
+    @return  Error count since construction or reset().
+  */
+  uint32_t getErrors(void) const { return errors; };
+
+private:
+  void startFrame(void);
+
+  Adafruit_DotStar *strip;  ///< Strip receiving data
+  Stream *in;               ///< Data source
+  uint8_t format;           ///< DOTSTAR_INGEST_* frame format
+  uint8_t order;            ///< Color order of incoming data
+  uint8_t state;            ///< 0-2 = magic, 3-5 = header, 6 = pixel data
+  uint8_t header[3];        ///< Adalight count (2 bytes) and checksum
+  bool autoShow = true;     ///< If set, call show() after each frame
+  uint32_t count;           ///< Pixels in current frame
+  uint32_t pos;             ///< Next pixel in current frame
+  uint32_t frames;          ///< Frames received
+  uint32_t bytes;           ///< Bytes consumed
+  uint32_t errors;          ///< Bad headers
+};
+
+#endif // _ADAFRUIT_DOT_STAR_INGEST_H_
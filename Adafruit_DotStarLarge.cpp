@@ -0,0 +1,280 @@
+/*!
+ * @file Adafruit_DotStarLarge.cpp
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "Adafruit_DotStarLarge.h"
+
+/*!
+  @brief   Adafruit_DotStarLarge constructor for hardware SPI. Must be
+           connected to MOSI, SCK pins.
+  @param   n     Number of DotStars in strand.
+  @param   o     Pixel type, one of the DOTSTAR_* color-order constants
+                 (not DOTSTAR_MONO). Default is DOTSTAR_BRG.
+  @param   spi   Pointer to hardware SPIClass object.
+  @param   freq  SPI clock rate in Hz, default is DOTSTAR_CLOCK_SPEED.
+  @return  Adafruit_DotStarLarge object. Call the begin() function before
+           use.
+*/
+Adafruit_DotStarLarge::Adafruit_DotStarLarge(uint32_t n, uint8_t o,
+                                             SPIClass *spi, uint32_t freq)
+    : Adafruit_DotStar(0, o, spi, freq) {
+  updateLength(n);
+}
+
+/*!
+  @brief   Adafruit_DotStarLarge constructor for 'soft' (bitbang) SPI. Any
+           two pins can be used.
+  @param   n     Number of DotStars in strand.
+  @param   d     Arduino pin number for data out.
+  @param   c     Arduino pin number for clock out.
+  @param   o     Pixel type, one of the DOTSTAR_* color-order constants
+                 (not DOTSTAR_MONO). Default is DOTSTAR_BRG.
+  @param   freq  SPI clock rate in Hz, default is DOTSTAR_CLOCK_SPEED.
+  @return  Adafruit_DotStarLarge object. Call the begin() function before
+           use.
+*/
+Adafruit_DotStarLarge::Adafruit_DotStarLarge(uint32_t n, uint8_t d, uint8_t c,
+                                             uint8_t o, uint32_t freq)
+    : Adafruit_DotStar(0, d, c, o, freq) {
+  updateLength(n);
+}
+
+/*!
+  @brief   Deallocate Adafruit_DotStarLarge object.
+*/
+Adafruit_DotStarLarge::~Adafruit_DotStarLarge(void) { freeSegments(); }
+
+/*!
+  @brief   Free all buffer segments, leaving the strip 0 pixels long.
+*/
+void Adafruit_DotStarLarge::freeSegments(void) {
+  if (segments) {
+    for (uint16_t i = 0; i < segmentCount; i++)
+      free(segments[i]);
+    free(segments);
+    segments = NULL;
+  }
+  segmentCount = 0;
+  length = 0;
+}
+
+/*!
+  @brief   Change the length of the strip. All pixels are cleared.
+  @param   n  New length of strip, in pixels. Check numPixels() afterward,
+              it's 0 if the buffer could not be allocated (or the strip is
+              DOTSTAR_MONO).
+*/
+void Adafruit_DotStarLarge::updateLength(uint32_t n) {
+  uint32_t count = (n + DOTSTAR_SEGMENT_PIXELS - 1) / DOTSTAR_SEGMENT_PIXELS,
+           bytes;
+  freeSegments();
+  if (!n || (rOffset == gOffset) || (count > 0xFFFF))
+    return;
+  if (!(segments = (uint8_t **)calloc(count, sizeof(uint8_t *))))
+    return;
+  for (segmentCount = 0; segmentCount < count; segmentCount++) {
+    bytes = (segmentCount < count - 1)
+                ? DOTSTAR_SEGMENT_PIXELS * 3
+                : (n - (count - 1) * DOTSTAR_SEGMENT_PIXELS) * 3;
+    if (!(segments[segmentCount] = (uint8_t *)calloc(bytes, 1))) {
+      freeSegments(); // Frees the segments allocated so far
+      return;
+    }
+  }
+  length = n;
+}
+
+/*!
+  @brief   Transmit pixel data in RAM to DotStars, one segment after
+           another, as a single frame. With a power limit set, brightness
+           is lowered for the frame as by Adafruit_DotStar::show().
+*/
+void Adafruit_DotStarLarge::show(void) {
+  uint8_t buf[DOTSTAR_CHUNK_PIXELS * 4];
+  uint32_t left = length;
+  uint16_t i, n, s, len;
+  uint8_t bright = limitBrightness(powerModel ? colorPower() : 0,
+                                   (uint64_t)length * powerIdle);
+
+  spi_dev->beginTransaction();
+
+  // [START FRAME]
+  memset(buf, 0x00, 4);
+  transmit(buf, 4);
+
+  // [PIXEL DATA]
+  for (s = 0; s < segmentCount; s++) {
+    len = (left > DOTSTAR_SEGMENT_PIXELS) ? DOTSTAR_SEGMENT_PIXELS : left;
+    for (i = 0; i < len; i += n) {
+      n = len - i;
+      if (n > DOTSTAR_CHUNK_PIXELS)
+        n = DOTSTAR_CHUNK_PIXELS;
+      encodeRGB(buf, &segments[s][i * 3], NULL, NULL, n, bright);
+      transmit(buf, n * 4);
+    }
+    left -= len;
+  }
+
+  // [END FRAME]
+  endFrame(buf, sizeof(buf), length);
+
+  spi_dev->endTransaction();
+  pixelsEncoded += length;
+  if (output)
+    output->flush(); // Mark end of frame
+}
+
+/*!
+  @brief   Set a pixel's color using a 32-bit 'packed' RGB value.
+  @param   n  Pixel index, starting from 0.
+  @param   c  32-bit color value, e.g. 0x00RRGGBB.
+*/
+void Adafruit_DotStarLarge::setPixelColor(uint32_t n, uint32_t c) {
+  if (n < length) {
+    uint8_t *p = &segments[n / DOTSTAR_SEGMENT_PIXELS]
+                          [(n % DOTSTAR_SEGMENT_PIXELS) * 3];
+    p[rOffset] = (uint8_t)(c >> 16);
+    p[gOffset] = (uint8_t)(c >> 8);
+    p[bOffset] = (uint8_t)c;
+  }
+}
+
+/*!
+  @brief   Set a pixel's color using separate red, green and blue
+           components.
+  @param   n  Pixel index, starting from 0.
+  @param   r  Red brightness, 0 = minimum (off), 255 = maximum.
+  @param   g  Green brightness, 0 = minimum (off), 255 = maximum.
+  @param   b  Blue brightness, 0 = minimum (off), 255 = maximum.
+*/
+void Adafruit_DotStarLarge::setPixelColor(uint32_t n, uint8_t r, uint8_t g,
+                                          uint8_t b) {
+  if (n < length) {
+    uint8_t *p = &segments[n / DOTSTAR_SEGMENT_PIXELS]
+                          [(n % DOTSTAR_SEGMENT_PIXELS) * 3];
+    p[rOffset] = r;
+    p[gOffset] = g;
+    p[bOffset] = b;
+  }
+}
+
+/*!
+  @brief   Query the color of a previously-set pixel.
+  @param   n  Index of pixel to read (0 = first).
+  @return  'Packed' 32-bit RGB value (0 if out of range).
+*/
+uint32_t Adafruit_DotStarLarge::getPixelColor(uint32_t n) const {
+  if (n >= length)
+    return 0;
+  const uint8_t *p = &segments[n / DOTSTAR_SEGMENT_PIXELS]
+                              [(n % DOTSTAR_SEGMENT_PIXELS) * 3];
+  return ((uint32_t)p[rOffset] << 16) | ((uint32_t)p[gOffset] << 8) |
+         p[bOffset];
+}
+
+/*!
+  @brief   Fill all or part of the strip with a color.
+  @param   c      32-bit color value, e.g. 0x00RRGGBB. 0 (off) if
+                  unspecified.
+  @param   first  Index of first pixel to fill, starting from 0. 0 if
+                  unspecified.
+  @param   count  Number of pixels to fill. Passing 0 or leaving
+                  unspecified will fill to end of strip. Clipped at end of
+                  strip.
+*/
+void Adafruit_DotStarLarge::fill(uint32_t c, uint32_t first, uint32_t count) {
+  if (first >= length)
+    return;
+  if ((count == 0) || (count > length - first))
+    count = length - first;
+
+  uint8_t px[3];
+  px[rOffset] = (uint8_t)(c >> 16);
+  px[gOffset] = (uint8_t)(c >> 8);
+  px[bOffset] = (uint8_t)c;
+
+  // Within each segment, store the first pixel then replicate it by
+  // doubling the filled region, as Adafruit_DotStar::fill() does.
+  uint32_t s = first / DOTSTAR_SEGMENT_PIXELS, done, bytes, n;
+  uint16_t i = first % DOTSTAR_SEGMENT_PIXELS;
+  while (count) {
+    n = DOTSTAR_SEGMENT_PIXELS - i; // Pixels to fill in this segment
+    if (n > count)
+      n = count;
+    count -= n;
+    uint8_t *p = &segments[s++][i * 3];
+    memcpy(p, px, 3);
+    for (done = 3, bytes = n * 3; done < bytes; done += n) {
+      n = (done < bytes - done) ? done : bytes - done;
+      memcpy(p + done, p, n);
+    }
+    i = 0;
+  }
+}
+
+/*!
+  @brief   Get the number of bytes show() issues per frame.
+  @return  Start frame, pixel data and end frame length in bytes.
+*/
+uint32_t Adafruit_DotStarLarge::getFrameBytes(void) const {
+  return 4 + length * 4 + (length + 15) / 16;
+}
+
+/*!
+  @brief   Sum the current of the color channels at full brightness, per
+           the power model, by scanning the segments. (Unlike
+           Adafruit_DotStar, sums aren't kept up to date as pixels
+           change: a scan is cheap next to encoding the frame.)
+  @return  Current in microamps.
+*/
+uint64_t Adafruit_DotStarLarge::colorPower(void) const {
+  uint64_t sum[3] = {0, 0, 0};
+  uint32_t left = length, k;
+  for (uint16_t s = 0; s < segmentCount; s++) {
+    const uint8_t *p = segments[s];
+    k = (left > DOTSTAR_SEGMENT_PIXELS) ? DOTSTAR_SEGMENT_PIXELS : left;
+    left -= k;
+    // Per segment, sums fit 32 bits
+    uint32_t r = 0, g = 0, b = 0;
+    for (; k--; p += 3) {
+      r += p[rOffset];
+      g += p[gOffset];
+      b += p[bOffset];
+    }
+    sum[0] += r;
+    sum[1] += g;
+    sum[2] += b;
+  }
+  return sum[0] * powerStep[0] + sum[1] * powerStep[1] +
+         sum[2] * powerStep[2];
+}
+
+/*!
+  @brief   Estimate the strip's current draw with its present pixels and
+           brightness setting (before any power limit), see
+           Adafruit_DotStar::setPowerModel().
+  @return  Estimate in milliamps, rounded up; 0 if there's no power model.
+*/
+uint32_t Adafruit_DotStarLarge::getPowerEstimate(void) const {
+  if (!powerModel)
+    return 0;
+  uint16_t scale = brightness ? brightness : 256;
+  uint64_t ua = ((colorPower() * scale) >> 8) + (uint64_t)length * powerIdle;
+  return (ua + 999) / 1000;
+}
@@ -0,0 +1,136 @@
+/*!
+ * @file Adafruit_DotStarLarge.h
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _ADAFRUIT_DOT_STAR_LARGE_H_
+#define _ADAFRUIT_DOT_STAR_LARGE_H_
+
+#include "Adafruit_DotStar.h"
+
+#ifndef DOTSTAR_SEGMENT_PIXELS
+#define DOTSTAR_SEGMENT_PIXELS 4096 ///< Pixels per buffer segment
+#endif
+
+/*!
+  @brief  Variant of Adafruit_DotStar for very long chains, beyond the
+          65,535 pixels a 16-bit index can address. Pixel indices and
+          counts are 32-bit, and the pixel buffer is allocated in
+          segments of DOTSTAR_SEGMENT_PIXELS (3 bytes each) rather than
+          one block, so it can fit in a fragmented heap (or one split
+          across internal and external RAM); show() issues the segments
+          back-to-back as one frame.
+  @note   Supports color strips with the functions below: global
+          brightness (including setHardwareBrightness()), gamma
+          correction, white balance, the power model and limit,
+          setClockSpeed(), updatePins() and setOutput(). Other
+          Adafruit_DotStar features that work on the regular pixel buffer
+          (DOTSTAR_MONO, palette mode, per-pixel brightness, dithering,
+          showAsync(), dirty tracking, bulk and effect functions) are not
+          available. Adafruit_DotStar is a private base, used for its SPI
+          transport and encoder only, so a Large strip can't be passed
+          where an Adafruit_DotStar is expected (Adafruit_DotStarScheduler,
+          Adafruit_DotStarIngest and so on, which would see no pixels).
+*/
+class Adafruit_DotStarLarge : private Adafruit_DotStar {
+
+public:
+#if !defined(SPI_INTERFACES_COUNT) ||                                          \
+    (defined(SPI_INTERFACES_COUNT) && (SPI_INTERFACES_COUNT > 0))
+  Adafruit_DotStarLarge(uint32_t n, uint8_t o = DOTSTAR_BRG,
+                        SPIClass *spi = &SPI,
+                        uint32_t freq = DOTSTAR_CLOCK_SPEED);
+#else
+  Adafruit_DotStarLarge(uint32_t n, uint8_t o = DOTSTAR_BRG,
+                        SPIClass *spi = NULL,
+                        uint32_t freq = DOTSTAR_CLOCK_SPEED);
+#endif
+  Adafruit_DotStarLarge(uint32_t n, uint8_t d, uint8_t c,
+                        uint8_t o = DOTSTAR_BRG,
+                        uint32_t freq = DOTSTAR_CLOCK_SPEED);
+  ~Adafruit_DotStarLarge(void);
+
+  // Adafruit_DotStar functions that apply as they are
+  using Adafruit_DotStar::begin;
+  using Adafruit_DotStar::Color;
+  using Adafruit_DotStar::ColorHSV;
+  using Adafruit_DotStar::ColorHue;
+  using Adafruit_DotStar::gamma32;
+  using Adafruit_DotStar::gamma8;
+  using Adafruit_DotStar::getBrightness;
+  using Adafruit_DotStar::getClockSpeed;
+  using Adafruit_DotStar::getFrameBrightness;
+  using Adafruit_DotStar::getFramePower;
+  using Adafruit_DotStar::getFramesLimited;
+  using Adafruit_DotStar::getPixelsEncoded;
+  using Adafruit_DotStar::resetCounters;
+  using Adafruit_DotStar::setBrightness;
+  using Adafruit_DotStar::setClockSpeed;
+  using Adafruit_DotStar::setGammaCorrection;
+  using Adafruit_DotStar::setHardwareBrightness;
+  using Adafruit_DotStar::setOutput;
+  using Adafruit_DotStar::setPowerLimit;
+  using Adafruit_DotStar::setPowerModel;
+  using Adafruit_DotStar::setWhiteBalance;
+  using Adafruit_DotStar::sine8;
+  using Adafruit_DotStar::updatePins;
+
+  void updateLength(uint32_t n);
+  void show(void);
+  void setPixelColor(uint32_t n, uint32_t c);
+  void setPixelColor(uint32_t n, uint8_t r, uint8_t g, uint8_t b);
+  uint32_t getPixelColor(uint32_t n) const;
+  void fill(uint32_t c = 0, uint32_t first = 0, uint32_t count = 0);
+  /*!
+    @brief   Set all pixels to 'off' (black).
+  */
+  void clear(void) { fill(0); };
+  /*!
+    @brief   Return the number of pixels in the strip.
+    @return  Pixel count (0 if not set, or if allocation failed).
+  */
+  uint32_t numPixels(void) const { return length; };
+  uint32_t getFrameBytes(void) const;
+  uint32_t getPowerEstimate(void) const;
+  /*!
+    @brief   Return the number of buffer segments.
+    @return  Segment count, numPixels() / DOTSTAR_SEGMENT_PIXELS rounded up.
+  */
+  uint16_t numSegments(void) const { return segmentCount; };
+  /*!
+    @brief   Get a pointer directly to one segment of the pixel buffer, see
+             Adafruit_DotStar::getPixels(). Segment i holds pixels
+             i * DOTSTAR_SEGMENT_PIXELS onward, 3 bytes each in
+             device-native order.
+    @param   i  Segment index.
+    @return  Pointer to segment, or NULL if out of range.
+  */
+  uint8_t *getSegment(uint16_t i) const {
+    return (i < segmentCount) ? segments[i] : NULL;
+  };
+
+private:
+  void freeSegments(void);
+  uint64_t colorPower(void) const;
+
+  uint8_t **segments = NULL; ///< Pixel buffer segments
+  uint16_t segmentCount = 0; ///< Number of segments
+  uint32_t length = 0;       ///< Number of pixels
+};
+
+#endif // _ADAFRUIT_DOT_STAR_LARGE_H_
@@ -0,0 +1,396 @@
+/*!
+ * @file Adafruit_DotStarLayout.cpp
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "Adafruit_DotStarLayout.h"
+
+/*!
+  @brief   Adafruit_DotStarLayout constructor. The layout is empty (0x0)
+           until setMatrix(), setMap() or loadMap() is called.
+  @param   strip  Pointer to Adafruit_DotStar object to draw to.
+*/
+Adafruit_DotStarLayout::Adafruit_DotStarLayout(Adafruit_DotStar *strip)
+    : strip(strip) {}
+
+/*!
+  @brief   Deallocate Adafruit_DotStarLayout object.
+*/
+Adafruit_DotStarLayout::~Adafruit_DotStarLayout(void) { free(map); }
+
+/*!
+  @brief   (Re)allocate the lookup table, with no pixels placed.
+  @param   w  Layout width.
+  @param   h  Layout height.
+  @return  true on success, false if allocation failed (layout is then
+           0x0).
+*/
+bool Adafruit_DotStarLayout::alloc(uint16_t w, uint16_t h) {
+  uint32_t n = (uint32_t)w * h;
+  free(map);
+  map = NULL;
+  if ((n <= SIZE_MAX / sizeof(uint16_t)) && // Else size_t would wrap
+      (map = (uint16_t *)malloc(n * sizeof(uint16_t)))) {
+    memset(map, 0xFF, n * sizeof(uint16_t)); // All DOTSTAR_LAYOUT_NONE
+    this->w = w;
+    this->h = h;
+    return true;
+  }
+  this->w = this->h = 0;
+  return false;
+}
+
+/*!
+  @brief   Index of a position along a matrix (or grid of tiles) wired as
+           given by flags.
+  @param   x      Column.
+  @param   y      Row.
+  @param   w      Width.
+  @param   h      Height.
+  @param   flags  DOTSTAR_LAYOUT_* flags (not TILE_ variants).
+  @return  Position along the wiring, 0 to w*h-1.
+*/
+static uint32_t wiringIndex(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                            uint8_t flags) {
+  uint16_t major, minor, len;
+  if (flags & DOTSTAR_LAYOUT_RIGHT)
+    x = w - 1 - x;
+  if (flags & DOTSTAR_LAYOUT_BOTTOM)
+    y = h - 1 - y;
+  if (flags & DOTSTAR_LAYOUT_COLUMNS) {
+    major = x;
+    minor = y;
+    len = h;
+  } else {
+    major = y;
+    minor = x;
+    len = w;
+  }
+  if ((flags & DOTSTAR_LAYOUT_ZIGZAG) && (major & 1))
+    minor = len - 1 - minor;
+  return (uint32_t)major * len + minor;
+}
+
+/*!
+  @brief   Set up the layout as a matrix, or a grid of identical matrix
+           tiles (panels).
+  @param   w         Width of matrix (or of each tile), before rotation.
+  @param   h         Height of matrix (or of each tile), before rotation.
+  @param   flags     Sum of DOTSTAR_LAYOUT_* flags giving the position of
+                     the first pixel, whether pixels run along rows or
+                     columns, and progressive or zigzag (serpentine)
+                     wiring. For tiled matrices, also DOTSTAR_LAYOUT_TILE_*
+                     flags describing the order of tiles, the same way.
+                     e.g. DOTSTAR_LAYOUT_TOP + DOTSTAR_LAYOUT_LEFT +
+                     DOTSTAR_LAYOUT_ROWS + DOTSTAR_LAYOUT_ZIGZAG.
+  @param   rotation  Clockwise rotation of the whole matrix, 0-3 (x90
+                     degrees). With 1 or 3, width and height are swapped.
+  @param   tilesX    Number of tiles across, default 1.
+  @param   tilesY    Number of tiles down, default 1.
+  @return  true on success, false if the matrix would be more than 65535
+           pixels across or down, or the lookup table could not be
+           allocated.
+  @note    Positions past the end of the strip are mapped but ignored when
+           drawing. Strip pixels past the end of the matrix are
+           unaffected.
+*/
+bool Adafruit_DotStarLayout::setMatrix(uint16_t w, uint16_t h, uint8_t flags,
+                                       uint8_t rotation, uint8_t tilesX,
+                                       uint8_t tilesY) {
+  uint32_t uw = (uint32_t)w * tilesX, uh = (uint32_t)h * tilesY, i;
+  uint16_t x, y, ux, uy;
+
+  if (!uw || !uh || (uw > 0xFFFF) || (uh > 0xFFFF))
+    return false;
+  rotation &= 3;
+  if (!alloc((rotation & 1) ? uh : uw, (rotation & 1) ? uw : uh))
+    return false;
+
+  for (y = 0; y < this->h; y++) {
+    for (x = 0; x < this->w; x++) {
+      switch (rotation) { // Position in unrotated matrix
+      case 1:
+        ux = uw - 1 - y;
+        uy = x;
+        break;
+      case 2:
+        ux = uw - 1 - x;
+        uy = uh - 1 - y;
+        break;
+      case 3:
+        ux = y;
+        uy = uh - 1 - x;
+        break;
+      default:
+        ux = x;
+        uy = y;
+        break;
+      }
+      i = wiringIndex(ux / w, uy / h, tilesX, tilesY, flags >> 4) * w * h +
+          wiringIndex(ux % w, uy % h, w, h, flags);
+      if (i > DOTSTAR_LAYOUT_NONE)
+        i = DOTSTAR_LAYOUT_NONE; // Past any possible strip length
+      map[(uint32_t)y * this->w + x] = i;
+    }
+  }
+  return true;
+}
+
+/*!
+  @brief   Set up an empty layout for arbitrary pixel positions, to be
+           filled in with setPosition().
+  @param   w  Width of layout.
+  @param   h  Height of layout.
+  @return  true on success, false if the lookup table could not be
+           allocated.
+*/
+bool Adafruit_DotStarLayout::setMap(uint16_t w, uint16_t h) {
+  return alloc(w, h);
+}
+
+/*!
+  @brief   Place a strip pixel at a position in the layout. Positions may
+           be left empty (gaps in a sculpture, etc.).
+  @param   n  Pixel index along strip.
+  @param   x  Column, 0 = left. Ignored if out of range.
+  @param   y  Row, 0 = top. Ignored if out of range.
+*/
+void Adafruit_DotStarLayout::setPosition(uint16_t n, int16_t x, int16_t y) {
+  if (((uint16_t)x < w) && ((uint16_t)y < h))
+    map[(uint32_t)y * w + x] = n;
+}
+
+/*!
+  @brief   Load a layout from a Stream, typically a text file listing the
+           x and y position of each strip pixel in turn, e.g. "0,0 1,0
+           1,1 ...". Any non-numeric characters separate numbers. Pixels
+           with negative or out-of-range positions aren't placed.
+  @param   in  Stream to read from.
+  @param   w   Width of layout.
+  @param   h   Height of layout.
+  @return  Number of pixel positions read, up to numPixels() of the
+           strip. 0 if the lookup table could not be allocated.
+*/
+uint16_t Adafruit_DotStarLayout::loadMap(Stream &in, uint16_t w, uint16_t h) {
+  uint16_t n, count = strip->numPixels();
+  int16_t x, y;
+  int c;
+
+  if (!alloc(w, h))
+    return 0;
+
+  for (n = 0; n < count; n++) {
+    // Skip to next number, so trailing whitespace isn't read as a pixel
+    while (((c = in.peek()) >= 0) && (c != '-') && ((c < '0') || (c > '9')))
+      in.read();
+    if (c < 0)
+      break;
+    x = in.parseInt();
+    y = in.parseInt();
+    setPosition(n, x, y);
+  }
+  return n;
+}
+
+/*!
+  @brief   Set or fill pixels along a line through the lookup table.
+  @param   m       Index of first table entry.
+  @param   step    Distance between entries (1 = along a row, w = down a
+                   column).
+  @param   n       Number of entries.
+  @param   colors  Array of n 32-bit 'packed' RGB values, or NULL to use c.
+  @param   c       Color for all pixels if colors is NULL.
+*/
+void Adafruit_DotStarLayout::span(uint32_t m, uint16_t step, uint16_t n,
+                                  const uint32_t *colors, uint32_t c) {
+  uint16_t i, count = strip->numLEDs, lo = 0xFFFF, hi = 0;
+  const uint16_t *t = &map[m];
+
+  if (strip->paletteBits || (strip->rOffset == strip->gOffset)) {
+    for (; n--; t += step) { // PALETTE or MONO, let the strip handle it
+      if ((i = *t) < count)
+        strip->setPixelColor(i, colors ? *colors : c);
+      if (colors)
+        colors++;
+    }
+    return;
+  }
+
+  uint8_t *pixels = strip->pixels, *p, r = strip->rOffset, g = strip->gOffset,
+          b = strip->bOffset;
+  if (colors) {
+    for (; n--; t += step, colors++) {
+      if ((i = *t) < count) { // Skips DOTSTAR_LAYOUT_NONE too
+        p = &pixels[i * 3];
+        p[r] = (uint8_t)(*colors >> 16);
+        p[g] = (uint8_t)(*colors >> 8);
+        p[b] = (uint8_t)*colors;
+        if (i < lo)
+          lo = i;
+        if (i > hi)
+          hi = i;
+      }
+    }
+  } else {
+    uint8_t cr = (uint8_t)(c >> 16), cg = (uint8_t)(c >> 8), cb = (uint8_t)c;
+    for (; n--; t += step) {
+      if ((i = *t) < count) {
+        p = &pixels[i * 3];
+        p[r] = cr;
+        p[g] = cg;
+        p[b] = cb;
+        if (i < lo)
+          lo = i;
+        if (i > hi)
+          hi = i;
+      }
+    }
+  }
+  if (lo <= hi)
+    strip->touch(lo, hi + 1);
+}
+
+/*!
+  @brief   Set the color of the pixel at a position.
+  @param   x  Column, 0 = left.
+  @param   y  Row, 0 = top.
+  @param   c  32-bit color value, e.g. 0x00RRGGBB.
+  @note    Positions out of range or without a pixel are ignored.
+*/
+void Adafruit_DotStarLayout::drawPixel(int16_t x, int16_t y, uint32_t c) {
+  uint16_t i = getIndex(x, y);
+  if (i < strip->numLEDs) {
+    if (strip->paletteBits || (strip->rOffset == strip->gOffset)) {
+      strip->setPixelColor(i, c);
+      return;
+    }
+    uint8_t *p = &strip->pixels[i * 3];
+    strip->touch(i, i + 1);
+    p[strip->rOffset] = (uint8_t)(c >> 16);
+    p[strip->gOffset] = (uint8_t)(c >> 8);
+    p[strip->bOffset] = (uint8_t)c;
+  }
+}
+
+/*!
+  @brief   Query the color of the pixel at a position.
+  @param   x  Column, 0 = left.
+  @param   y  Row, 0 = top.
+  @return  32-bit color value, e.g. 0x00RRGGBB. 0 if out of range or
+           there's no pixel there.
+*/
+uint32_t Adafruit_DotStarLayout::getPixel(int16_t x, int16_t y) const {
+  uint16_t i = getIndex(x, y);
+  return (i < strip->numLEDs) ? strip->getPixelColor(i) : 0;
+}
+
+/*!
+  @brief   Set the colors of a horizontal run of pixels from an array.
+  @param   x       Column of leftmost pixel, 0 = left. May be negative.
+  @param   y       Row, 0 = top.
+  @param   colors  Array of 32-bit color values, e.g. 0x00RRGGBB, left to
+                   right.
+  @param   n       Number of pixels. Clipped at the edges of the layout.
+*/
+void Adafruit_DotStarLayout::drawRow(int16_t x, int16_t y,
+                                     const uint32_t *colors, uint16_t n) {
+  drawImage(x, y, n, 1, colors);
+}
+
+/*!
+  @brief   Set the colors of a vertical run of pixels from an array.
+  @param   x       Column, 0 = left.
+  @param   y       Row of topmost pixel, 0 = top. May be negative.
+  @param   colors  Array of 32-bit color values, e.g. 0x00RRGGBB, top to
+                   bottom.
+  @param   n       Number of pixels. Clipped at the edges of the layout.
+*/
+void Adafruit_DotStarLayout::drawColumn(int16_t x, int16_t y,
+                                        const uint32_t *colors, uint16_t n) {
+  if ((uint16_t)x >= w)
+    return;
+  if (y < 0) {
+    if (n <= -y)
+      return;
+    colors -= y;
+    n += y;
+    y = 0;
+  }
+  if (y >= (int32_t)h)
+    return;
+  if (n > h - y)
+    n = h - y;
+  span((uint32_t)y * w + x, w, n, colors, 0);
+}
+
+/*!
+  @brief   Set the colors of a rectangle of pixels from an image.
+  @param   x       Column of left edge, 0 = left. May be negative.
+  @param   y       Row of top edge, 0 = top. May be negative.
+  @param   iw      Image width.
+  @param   ih      Image height.
+  @param   colors  Array of iw*ih 32-bit color values, e.g. 0x00RRGGBB,
+                   row by row from top left. The image is clipped at the
+                   edges of the layout.
+*/
+void Adafruit_DotStarLayout::drawImage(int16_t x, int16_t y, uint16_t iw,
+                                       uint16_t ih, const uint32_t *colors) {
+  int32_t x1 = x + (int32_t)iw, y1 = y + (int32_t)ih;
+  if (x < 0) {
+    colors -= x;
+    x = 0;
+  }
+  if (y < 0) {
+    colors -= (int32_t)y * iw;
+    y = 0;
+  }
+  if (x1 > w)
+    x1 = w;
+  if (y1 > h)
+    y1 = h;
+  if (x >= x1)
+    return;
+  for (; y < y1; y++, colors += iw)
+    span((uint32_t)y * w + x, 1, x1 - x, colors, 0);
+}
+
+/*!
+  @brief   Fill a rectangle with a color.
+  @param   x   Column of left edge, 0 = left. May be negative.
+  @param   y   Row of top edge, 0 = top. May be negative.
+  @param   rw  Rectangle width.
+  @param   rh  Rectangle height.
+  @param   c   32-bit color value, e.g. 0x00RRGGBB. Clipped at the edges
+               of the layout.
+*/
+void Adafruit_DotStarLayout::fillRect(int16_t x, int16_t y, uint16_t rw,
+                                      uint16_t rh, uint32_t c) {
+  int32_t x1 = x + (int32_t)rw, y1 = y + (int32_t)rh;
+  if (x < 0)
+    x = 0;
+  if (y < 0)
+    y = 0;
+  if (x1 > w)
+    x1 = w;
+  if (y1 > h)
+    y1 = h;
+  if (x >= x1)
+    return;
+  for (; y < y1; y++)
+    span((uint32_t)y * w + x, 1, x1 - x, NULL, c);
+}
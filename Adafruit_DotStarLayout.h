@@ -0,0 +1,112 @@
+/*!
+ * @file Adafruit_DotStarLayout.h
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _ADAFRUIT_DOT_STAR_LAYOUT_H_
+#define _ADAFRUIT_DOT_STAR_LAYOUT_H_
+
+#include "Adafruit_DotStar.h"
+
+// Matrix wiring flags for setMatrix(), add together as needed. First
+// pixel position, e.g. DOTSTAR_LAYOUT_TOP + DOTSTAR_LAYOUT_LEFT:
+#define DOTSTAR_LAYOUT_TOP 0x00    ///< First pixel at top
+#define DOTSTAR_LAYOUT_BOTTOM 0x01 ///< First pixel at bottom
+#define DOTSTAR_LAYOUT_LEFT 0x00   ///< First pixel at left
+#define DOTSTAR_LAYOUT_RIGHT 0x02  ///< First pixel at right
+// Arrangement of pixels:
+#define DOTSTAR_LAYOUT_ROWS 0x00    ///< Pixels run along rows
+#define DOTSTAR_LAYOUT_COLUMNS 0x04 ///< Pixels run along columns
+// Direction of successive rows (or columns):
+#define DOTSTAR_LAYOUT_PROGRESSIVE 0x00 ///< All run the same direction
+#define DOTSTAR_LAYOUT_ZIGZAG 0x08      ///< Alternate directions (serpentine)
+// Equivalents for arrangement of tiles, if the matrix is tiled panels:
+#define DOTSTAR_LAYOUT_TILE_TOP 0x00         ///< First tile at top
+#define DOTSTAR_LAYOUT_TILE_BOTTOM 0x10      ///< First tile at bottom
+#define DOTSTAR_LAYOUT_TILE_LEFT 0x00        ///< First tile at left
+#define DOTSTAR_LAYOUT_TILE_RIGHT 0x20       ///< First tile at right
+#define DOTSTAR_LAYOUT_TILE_ROWS 0x00        ///< Tiles run along rows
+#define DOTSTAR_LAYOUT_TILE_COLUMNS 0x40     ///< Tiles run along columns
+#define DOTSTAR_LAYOUT_TILE_PROGRESSIVE 0x00 ///< All run the same direction
+#define DOTSTAR_LAYOUT_TILE_ZIGZAG 0x80      ///< Alternate directions
+
+#define DOTSTAR_LAYOUT_NONE 0xFFFF ///< Table entry for a spot with no pixel
+
+/*!
+  @brief  Class that maps 2D coordinates onto the pixels of a DotStar
+          strip: matrices wired in rows or columns, progressive or
+          serpentine, from any corner, rotated, or made of tiled panels;
+          or arbitrary layouts (sculptures etc.) from a table of pixel
+          positions. The mapping is computed once into a lookup table
+          (2 bytes per x/y position), so drawing doesn't recompute it per
+          pixel, and the drawing functions write straight into the
+          strip's pixel buffer.
+*/
+class Adafruit_DotStarLayout {
+
+public:
+  Adafruit_DotStarLayout(Adafruit_DotStar *strip);
+  ~Adafruit_DotStarLayout(void);
+
+  bool setMatrix(uint16_t w, uint16_t h, uint8_t flags, uint8_t rotation = 0,
+                 uint8_t tilesX = 1, uint8_t tilesY = 1);
+  bool setMap(uint16_t w, uint16_t h);
+  void setPosition(uint16_t n, int16_t x, int16_t y);
+  uint16_t loadMap(Stream &in, uint16_t w, uint16_t h);
+  /*!
+    @brief   Get the strip pixel at a position.
+    @param   x  Column, 0 = left.
+    @param   y  Row, 0 = top.
+    @return  Pixel index, or DOTSTAR_LAYOUT_NONE if there's no pixel there
+             (or x or y is out of range).
+  */
+  uint16_t getIndex(int16_t x, int16_t y) const {
+    return ((uint16_t)x < w && (uint16_t)y < h) ? map[(uint32_t)y * w + x]
+                                                : DOTSTAR_LAYOUT_NONE;
+  }
+  /*!
+    @brief   Get the width of the layout.
+    @return  Width in pixels, after any rotation.
+  */
+  uint16_t width(void) const { return w; };
+  /*!
+    @brief   Get the height of the layout.
+    @return  Height in pixels, after any rotation.
+  */
+  uint16_t height(void) const { return h; };
+
+  void drawPixel(int16_t x, int16_t y, uint32_t c);
+  uint32_t getPixel(int16_t x, int16_t y) const;
+  void drawRow(int16_t x, int16_t y, const uint32_t *colors, uint16_t n);
+  void drawColumn(int16_t x, int16_t y, const uint32_t *colors, uint16_t n);
+  void drawImage(int16_t x, int16_t y, uint16_t iw, uint16_t ih,
+                 const uint32_t *colors);
+  void fillRect(int16_t x, int16_t y, uint16_t rw, uint16_t rh, uint32_t c);
+
+private:
+  bool alloc(uint16_t w, uint16_t h);
+  void span(uint32_t m, uint16_t step, uint16_t n, const uint32_t *colors,
+            uint32_t c);
+
+  Adafruit_DotStar *strip; ///< Strip being drawn to
+  uint16_t *map = NULL;    ///< Pixel index for each x/y, row-major
+  uint16_t w = 0;          ///< Layout width
+  uint16_t h = 0;          ///< Layout height
+};
+
+#endif // _ADAFRUIT_DOT_STAR_LAYOUT_H_
@@ -0,0 +1,170 @@
+/*!
+ * @file Adafruit_DotStarPlayer.cpp
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "Adafruit_DotStarPlayer.h"
+
+/*!
+  @brief   Adafruit_DotStarMemoryStream constructor.
+  @param   data     Pointer to data, e.g. a PROGMEM array holding an
+                    animation asset. On AVR, PROGMEM data must be within
+                    the first 64K of flash.
+  @param   len      Length of data in bytes.
+  @param   progmem  true (default) if data is in PROGMEM, false if in RAM
+                    (or memory-mapped). Only matters on AVR, where flash
+                    has a separate address space.
+*/
+Adafruit_DotStarMemoryStream::Adafruit_DotStarMemoryStream(const uint8_t *data,
+                                                           uint32_t len,
+                                                           bool progmem)
+    : data(data), length(len), pos(0), progmem(progmem) {
+  setTimeout(0); // Data that's not there won't arrive later
+}
+
+/*!
+  @brief   Get the number of bytes left to read.
+  @return  Byte count (limited to the range of int).
+*/
+int Adafruit_DotStarMemoryStream::available(void) {
+  uint32_t n = length - pos;
+  return (n > 0x7FFF) ? 0x7FFF : n;
+}
+
+/*!
+  @brief   Read the next byte.
+  @return  Byte value, or -1 at the end of the data.
+*/
+int Adafruit_DotStarMemoryStream::read(void) {
+  int c = peek();
+  if (c >= 0)
+    pos++;
+  return c;
+}
+
+/*!
+  @brief   Get the next byte without advancing past it.
+  @return  Byte value, or -1 at the end of the data.
+*/
+int Adafruit_DotStarMemoryStream::peek(void) {
+  if (pos >= length)
+    return -1;
+  return progmem ? pgm_read_byte(&data[pos]) : data[pos];
+}
+
+/*!
+  @brief   Read bytes from the stream, in one copy rather than one byte at
+           a time.
+  @param   buffer  Destination.
+  @param   length  Maximum number of bytes to read.
+  @return  Number of bytes read, fewer than length at the end.
+*/
+size_t Adafruit_DotStarMemoryStream::readBytes(char *buffer, size_t length) {
+  uint32_t n = this->length - pos;
+  if (length < n)
+    n = length;
+  if (progmem)
+    memcpy_P(buffer, &data[pos], n);
+  else
+    memcpy(buffer, &data[pos], n);
+  pos += n;
+  return n;
+}
+
+/*!
+  @brief   Adafruit_DotStarPlayer constructor.
+  @param   strip  Pointer to strip to play to. It must be begun, and its
+                  hardware or soft SPI pins are used; its pixel buffer and
+                  settings are not.
+  @param   in     Pointer to Stream holding the animation, positioned at
+                  its start.
+  @param   size   Capacity of frame buffer in bytes, at least the largest
+                  frame in the animation. 0 (default) to use the strip's
+                  getFrameBytes(), right for animations baked on a strip
+                  of the same length.
+*/
+Adafruit_DotStarPlayer::Adafruit_DotStarPlayer(Adafruit_DotStar *strip,
+                                               Stream *in, uint32_t size)
+    : Adafruit_DotStarReplay(in, size ? size : strip->getFrameBytes()),
+      strip(strip), lastShow(0), pending(false) {}
+
+/*!
+  @brief   Adafruit_DotStarPlayer constructor for an animation in memory,
+           e.g. a PROGMEM array. Frame data is block-copied from the
+           stream, see Adafruit_DotStarReplay.
+  @param   strip  Pointer to strip to play to, as above.
+  @param   in     Pointer to Adafruit_DotStarMemoryStream holding the
+                  animation, positioned at its start.
+  @param   size   Capacity of frame buffer in bytes, as above.
+*/
+Adafruit_DotStarPlayer::Adafruit_DotStarPlayer(
+    Adafruit_DotStar *strip, Adafruit_DotStarMemoryStream *in, uint32_t size)
+    : Adafruit_DotStarReplay(in, size ? size : strip->getFrameBytes()),
+      strip(strip), lastShow(0), pending(false) {}
+
+/*!
+  @brief   Read the next frame of the animation and issue it to the strip
+           right away, regardless of its timing.
+  @return  true if a frame was shown, false at the end of the animation or
+           on error (see error()).
+*/
+bool Adafruit_DotStarPlayer::show(void) {
+  if (!pending && !read())
+    return false;
+  pending = false;
+  strip->showEncoded(getFrame(), getFrameLength());
+  return true;
+}
+
+/*!
+  @brief   Show the next frame of the animation once it's due, keeping the
+           timing it was recorded with. Call this often, e.g. every time
+           through loop(). The first frame is shown immediately.
+  @return  true while the animation is playing, false once it has ended
+           (the last frame has been shown for the interval before it) or
+           on error. To loop, rewind the stream then call reset().
+*/
+bool Adafruit_DotStarPlayer::update(void) {
+  uint32_t now = micros();
+  if (!pending) {
+    if (!read()) {
+      // Hold the last frame as long as the one before it, so an animation
+      // that's looped keeps its pace across the seam.
+      return !error() && (getFrames() > 1) && (now - lastShow < getInterval());
+    }
+    pending = true;
+  }
+  if (getFrames() == 1) {
+    lastShow = now; // Time from here on
+  } else if (now - lastShow >= getInterval()) {
+    lastShow += getInterval(); // Doesn't drift if update() is late
+  } else {
+    return true; // Not due yet
+  }
+  show();
+  return true;
+}
+
+/*!
+  @brief   Prepare to play the animation from the start, e.g. after
+           rewinding the stream.
+*/
+void Adafruit_DotStarPlayer::reset(void) {
+  Adafruit_DotStarReplay::reset();
+  pending = false;
+}
@@ -0,0 +1,103 @@
+/*!
+ * @file Adafruit_DotStarPlayer.h
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _ADAFRUIT_DOT_STAR_PLAYER_H_
+#define _ADAFRUIT_DOT_STAR_PLAYER_H_
+
+#include "Adafruit_DotStarRecorder.h"
+
+/*!
+  @brief  A read-only Stream over a block of memory, so that animation
+          assets compiled into the sketch (PROGMEM arrays) or otherwise
+          mapped into memory can be played by Adafruit_DotStarPlayer (or
+          Adafruit_DotStarReplay) the same as a file.
+*/
+class Adafruit_DotStarMemoryStream : public Stream {
+
+public:
+  Adafruit_DotStarMemoryStream(const uint8_t *data, uint32_t len,
+                               bool progmem = true);
+
+  int available(void);
+  int read(void);
+  int peek(void);
+  size_t readBytes(char *buffer, size_t length);
+  /*!
+    @brief   Read bytes from the stream.
+    @param   buffer  Destination.
+    @param   length  Maximum number of bytes to read.
+    @return  Number of bytes read, fewer than length at the end.
+  */
+  size_t readBytes(uint8_t *buffer, size_t length) {
+    return readBytes((char *)buffer, length);
+  }
+  /*!
+    @brief   Write a byte. The stream is read-only, so this does nothing.
+    @return  0, always.
+  */
+  size_t write(uint8_t) { return 0; }
+  /*!
+    @brief   Go back to the start of the data.
+  */
+  void rewind(void) { pos = 0; };
+  /*!
+    @brief   Get the current read position.
+    @return  Offset of next byte to read from start of data.
+  */
+  uint32_t position(void) const { return pos; };
+
+private:
+  const uint8_t *data; ///< Data being read
+  uint32_t length;     ///< Length of data
+  uint32_t pos;        ///< Offset of next byte
+  bool progmem;        ///< If set, data is in PROGMEM
+};
+
+/*!
+  @brief  Class that plays pre-encoded animations straight to a DotStar
+          strip. An animation is baked ahead of time by recording show()
+          output with Adafruit_DotStarRecorder (see the bake example), so
+          its frames are already in wire format, with the strip's color
+          order, brightness and gamma applied, and stored as changes from
+          the previous frame. Playback applies each frame's changes and
+          issues it with Adafruit_DotStar::showEncoded(): no rendering or
+          encoding, and nothing is decoded ahead, so playback starts
+          immediately. Assets can come from any Stream, e.g. a file on an
+          SD card, or an Adafruit_DotStarMemoryStream over a PROGMEM array.
+*/
+class Adafruit_DotStarPlayer : public Adafruit_DotStarReplay {
+
+public:
+  Adafruit_DotStarPlayer(Adafruit_DotStar *strip, Stream *in,
+                         uint32_t size = 0);
+  Adafruit_DotStarPlayer(Adafruit_DotStar *strip,
+                         Adafruit_DotStarMemoryStream *in, uint32_t size = 0);
+
+  bool show(void);
+  bool update(void);
+  void reset(void);
+
+private:
+  Adafruit_DotStar *strip; ///< Strip being played to
+  uint32_t lastShow;       ///< Time previous frame was due, micros()
+  bool pending;            ///< Set if a frame is read but not yet shown
+};
+
+#endif // _ADAFRUIT_DOT_STAR_PLAYER_H_
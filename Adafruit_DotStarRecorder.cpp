@@ -0,0 +1,262 @@
+/*!
+ * @file Adafruit_DotStarRecorder.cpp
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "Adafruit_DotStarRecorder.h"
+#include "Adafruit_DotStarPlayer.h" // For Adafruit_DotStarMemoryStream
+
+static const uint8_t recordHeader[] = {'D', 'S', 'R', DOTSTAR_RECORD_VERSION};
+
+/*!
+  @brief   Adafruit_DotStarRecorder constructor. Pass to a strip's
+           setOutput() function to begin recording.
+  @param   dest  Pointer to Print object receiving the recording, e.g. an
+                 open File. Nothing is written until the first frame.
+  @param   size  Capacity of frame buffers in bytes. Frames larger than
+                 this are truncated (see overflowed()). Use
+                 Adafruit_DotStar::getFrameBytes() for the exact size.
+*/
+Adafruit_DotStarRecorder::Adafruit_DotStarRecorder(Print *dest, uint32_t size)
+    : Adafruit_DotStarCapture(size), dest(dest),
+      prev((uint8_t *)calloc(size, 1)) {
+  reset();
+}
+
+/*!
+  @brief   Deallocate Adafruit_DotStarRecorder object.
+*/
+Adafruit_DotStarRecorder::~Adafruit_DotStarRecorder(void) { free(prev); }
+
+/*!
+  @brief   Start a new recording: the next frame is preceded by a header,
+           is timed from now, and is stored whole rather than as changes.
+           Any partial frame is discarded and frame and byte counts are
+           cleared.
+*/
+void Adafruit_DotStarRecorder::reset(void) {
+  if (prev)
+    memset(prev, 0, capacity);
+  pos = length = frames = total = 0;
+  lastTime = micros();
+  recorded = 0;
+  started = false;
+}
+
+/*!
+  @brief   Write an unsigned varint to the recording.
+  @param   n  Value to write.
+*/
+void Adafruit_DotStarRecorder::writeNumber(uint32_t n) {
+  for (; n >= 0x80; n >>= 7) {
+    dest->write((uint8_t)(n | 0x80));
+    recorded++;
+  }
+  dest->write((uint8_t)n);
+  recorded++;
+}
+
+/*!
+  @brief   Mark the end of a frame (called by Adafruit_DotStar) and record
+           it as changes from the previous frame.
+*/
+void Adafruit_DotStarRecorder::flush(void) {
+  uint32_t now = micros(), i, j, k, u;
+
+  Adafruit_DotStarCapture::flush();
+  if (!prev)
+    return;
+
+  if (!started) {
+    dest->write(recordHeader, sizeof(recordHeader));
+    recorded += sizeof(recordHeader);
+    started = true;
+  }
+  writeNumber(now - lastTime);
+  lastTime = now;
+  writeNumber(length);
+
+  for (i = 0; i < length; i = k) {
+    for (j = i; (j < length) && (buf[j] == prev[j]); j++)
+      ; // Unchanged bytes
+    for (k = j; k < length;) {
+      if (buf[k] != prev[k]) {
+        k++;
+      } else {
+        // A run of fewer than 3 unchanged bytes costs less to repeat
+        // than to end this op and start another (2+ bytes)
+        for (u = k; (u < length) && (u - k < 3) && (buf[u] == prev[u]); u++)
+          ;
+        if ((u - k >= 3) || (u == length))
+          break;
+        k = u;
+      }
+    }
+    writeNumber(j - i);
+    writeNumber(k - j);
+    if (k > j) {
+      dest->write(&buf[j], k - j);
+      recorded += k - j;
+    }
+  }
+  memcpy(prev, buf, length);
+}
+
+/*!
+  @brief   Adafruit_DotStarReplay constructor.
+  @param   in    Pointer to Stream to read the recording from, positioned
+                 at its start, e.g. an open File.
+  @param   size  Capacity of frame buffer in bytes. Must be at least the
+                 largest frame in the recording.
+*/
+Adafruit_DotStarReplay::Adafruit_DotStarReplay(Stream *in, uint32_t size)
+    : in(in), buf((uint8_t *)malloc(size)), capacity(buf ? size : 0) {
+  reset();
+}
+
+/*!
+  @brief   Adafruit_DotStarReplay constructor for a recording in memory.
+           Frame data is block-copied from the stream rather than read a
+           byte at a time, which Stream::readBytes() would do on platforms
+           where it isn't virtual (e.g. AVR).
+  @param   in    Pointer to Adafruit_DotStarMemoryStream holding the
+                 recording, positioned at its start.
+  @param   size  Capacity of frame buffer in bytes. Must be at least the
+                 largest frame in the recording.
+*/
+Adafruit_DotStarReplay::Adafruit_DotStarReplay(
+    Adafruit_DotStarMemoryStream *in, uint32_t size)
+    : Adafruit_DotStarReplay((Stream *)in, size) {
+  memIn = in;
+}
+
+/*!
+  @brief   Deallocate Adafruit_DotStarReplay object.
+*/
+Adafruit_DotStarReplay::~Adafruit_DotStarReplay(void) { free(buf); }
+
+/*!
+  @brief   Prepare to play a recording from the start, e.g. after seeking
+           the stream back to the beginning of a file.
+*/
+void Adafruit_DotStarReplay::reset(void) {
+  if (buf)
+    memset(buf, 0, capacity);
+  length = interval = time = frames = 0;
+  started = false;
+  failed = !buf;
+}
+
+/*!
+  @brief   Read bytes from the recording, through the memory stream's own
+           readBytes() if there is one (see constructor).
+  @param   dest  Destination.
+  @param   len   Number of bytes to read.
+  @return  Number of bytes read, fewer than len at the end.
+*/
+size_t Adafruit_DotStarReplay::readIn(uint8_t *dest, size_t len) {
+  return memIn ? memIn->readBytes(dest, len) : in->readBytes(dest, len);
+}
+
+/*!
+  @brief   Read an unsigned varint from the recording.
+  @param   n  Pointer to value to fill in.
+  @return  true on success, false if the stream ended (error() is set if
+           this was partway through the number).
+*/
+bool Adafruit_DotStarReplay::readNumber(uint32_t *n) {
+  uint8_t b, shift = 0;
+  *n = 0;
+  do {
+    if (readIn(&b, 1) != 1) {
+      if (shift)
+        failed = true;
+      return false;
+    }
+    if (shift < 32)
+      *n |= (uint32_t)(b & 0x7F) << shift;
+    shift += 7;
+  } while (b & 0x80);
+  return true;
+}
+
+/*!
+  @brief   Read the next frame of the recording into RAM.
+  @return  true if a frame was read, false at the end of the recording or
+           on error (see error()).
+*/
+bool Adafruit_DotStarReplay::read(void) {
+  uint32_t dt, len, pos, skip, count;
+
+  if (failed)
+    return false;
+
+  if (!started) {
+    uint8_t header[sizeof(recordHeader)];
+    if (readIn(header, sizeof(header)) != sizeof(header))
+      return false; // Empty recording
+    if (memcmp(header, recordHeader, sizeof(header))) {
+      failed = true;
+      return false;
+    }
+    started = true;
+  }
+
+  if (!readNumber(&dt))
+    return false; // End of recording (or truncated number)
+  if (!readNumber(&len) || (len > capacity)) {
+    failed = true;
+    return false;
+  }
+
+  for (pos = 0; pos < len; pos += count) {
+    if (!readNumber(&skip) || !readNumber(&count) || (skip > len - pos) ||
+        (count > len - pos - skip)) {
+      failed = true;
+      return false;
+    }
+    pos += skip;
+    if (count && (readIn(&buf[pos], count) != count)) {
+      failed = true;
+      return false;
+    }
+  }
+
+  length = len;
+  interval = dt;
+  time += dt;
+  frames++;
+  return true;
+}
+
+/*!
+  @brief   Read the next frame of the recording and issue it to a Print
+           object standing in for the SPI device, e.g. an
+           Adafruit_DotStarCapture. Its flush() function is called after
+           the frame, as Adafruit_DotStar does with setOutput().
+  @param   out  Pointer to Print object.
+  @return  true if a frame was issued, false at the end of the recording or
+           on error (see error()).
+*/
+bool Adafruit_DotStarReplay::play(Print *out) {
+  if (!read())
+    return false;
+  out->write(buf, length);
+  out->flush();
+  return true;
+}
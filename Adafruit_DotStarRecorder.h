@@ -0,0 +1,146 @@
+/*!
+ * @file Adafruit_DotStarRecorder.h
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _ADAFRUIT_DOT_STAR_RECORDER_H_
+#define _ADAFRUIT_DOT_STAR_RECORDER_H_
+
+#include "Adafruit_DotStar.h"
+
+// Recording format. A recording is the 4-byte header 'D', 'S', 'R',
+// DOTSTAR_RECORD_VERSION, followed by one record per frame:
+//   time     Microseconds since the previous frame (or start of recording)
+//   length   Frame length in bytes
+//   ops...   Pairs of (skip, count), each followed by count literal bytes:
+//            skip bytes are unchanged from the previous frame, the next
+//            count bytes are as given. Pairs continue until length bytes
+//            are accounted for.
+// All numbers are unsigned LEB128 varints (7 bits per byte, least
+// significant first, high bit set on all but the last byte). Bytes of the
+// "previous frame" that were never written are 0.
+#define DOTSTAR_RECORD_VERSION 1 ///< Recording format version
+
+class Adafruit_DotStarMemoryStream;
+
+/*!
+  @brief  A Print object that records wire-format output from
+          Adafruit_DotStar::setOutput() -- exactly what show() issues,
+          start frame to end frame -- to another Print (a file on an SD
+          card, Serial etc.), frame by frame with timestamps. Each frame is
+          stored as the differences from the previous one, so animations
+          where only some pixels change record compactly. Recordings can
+          be played back with Adafruit_DotStarReplay for offline profiling,
+          or compared across library versions and settings.
+  @note   Uses two buffers of the given size (the frame in progress and
+          the previous frame). The most recent complete frame is also
+          available via Adafruit_DotStarCapture functions.
+*/
+class Adafruit_DotStarRecorder : public Adafruit_DotStarCapture {
+
+public:
+  Adafruit_DotStarRecorder(Print *dest, uint32_t size);
+  ~Adafruit_DotStarRecorder(void);
+
+  void flush(void);
+  void reset(void);
+  /*!
+    @brief   Get the number of bytes written to the destination, including
+             the recording header.
+    @return  Recorded byte count since construction or reset().
+  */
+  uint32_t getRecordedBytes(void) const { return recorded; };
+
+private:
+  void writeNumber(uint32_t n);
+
+  Print *dest;       ///< Where the recording goes
+  uint8_t *prev;     ///< Previous frame
+  uint32_t lastTime; ///< micros() at previous frame
+  uint32_t recorded; ///< Bytes written to dest
+  bool started;      ///< Set once header is written
+};
+
+/*!
+  @brief  Class that plays back recordings made by Adafruit_DotStarRecorder,
+          reconstructing each frame byte-for-byte as show() originally
+          issued it. Frames can be examined in RAM (getFrame()) or written
+          to a Print object standing in for the SPI device (e.g. an
+          Adafruit_DotStarCapture, or another Adafruit_DotStarRecorder),
+          for benchmarking, diffing wire output, etc. without hardware.
+*/
+class Adafruit_DotStarReplay {
+
+public:
+  Adafruit_DotStarReplay(Stream *in, uint32_t size);
+  Adafruit_DotStarReplay(Adafruit_DotStarMemoryStream *in, uint32_t size);
+  ~Adafruit_DotStarReplay(void);
+
+  bool read(void);
+  bool play(Print *out);
+  void reset(void);
+  /*!
+    @brief   Get a pointer to the most recently read frame.
+    @return  Pointer to frame bytes (NULL if buffer allocation failed).
+  */
+  const uint8_t *getFrame(void) const { return buf; };
+  /*!
+    @brief   Get the length of the most recently read frame.
+    @return  Frame length in bytes.
+  */
+  uint32_t getFrameLength(void) const { return length; };
+  /*!
+    @brief   Get the time between the most recently read frame and the one
+             before it, as recorded.
+    @return  Interval in microseconds.
+  */
+  uint32_t getInterval(void) const { return interval; };
+  /*!
+    @brief   Get the time of the most recently read frame, as recorded.
+    @return  Microseconds since start of recording.
+  */
+  uint32_t getTime(void) const { return time; };
+  /*!
+    @brief   Get the number of frames read.
+    @return  Frame count since construction or reset().
+  */
+  uint32_t getFrames(void) const { return frames; };
+  /*!
+    @brief   Check whether the recording was malformed, truncated, or had
+             frames larger than the replay buffer.
+    @return  true if an error occurred, false if not.
+  */
+  bool error(void) const { return failed; };
+
+private:
+  bool readNumber(uint32_t *n);
+  size_t readIn(uint8_t *dest, size_t len);
+
+  Stream *in;                                 ///< Recording being played
+  Adafruit_DotStarMemoryStream *memIn = NULL; ///< in, if a memory stream
+  uint8_t *buf;      ///< Current frame
+  uint32_t capacity; ///< Size of buf
+  uint32_t length;   ///< Length of current frame
+  uint32_t interval; ///< Current frame time minus previous
+  uint32_t time;     ///< Current frame time
+  uint32_t frames;   ///< Frames read
+  bool started;      ///< Set once header is read
+  bool failed;       ///< Set on error
+};
+
+#endif // _ADAFRUIT_DOT_STAR_RECORDER_H_
@@ -0,0 +1,388 @@
+/*!
+ * @file Adafruit_DotStarRender.cpp
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "Adafruit_DotStarRender.h"
+
+/*!
+  @brief   Adafruit_DotStarRender constructor. Call begin() to start the
+           worker tasks.
+  @param   strip  Pointer to strip to render. Its length should not change
+                  while run() or show() are in use.
+*/
+Adafruit_DotStarRender::Adafruit_DotStarRender(Adafruit_DotStar *strip)
+    : strip(strip) {}
+
+/*!
+  @brief   Deallocate Adafruit_DotStarRender object, stopping any worker
+           tasks.
+*/
+Adafruit_DotStarRender::~Adafruit_DotStarRender(void) { stop(); }
+
+/*!
+  @brief   Start one worker task for each CPU core other than the calling
+           task's.
+  @return  true if workers were started, false if running serially (one
+           core, or out of memory).
+*/
+bool Adafruit_DotStarRender::begin(void) {
+#ifdef DOTSTAR_RENDER_PARALLEL
+  return begin(portNUM_PROCESSORS - 1);
+#else
+  return begin(0);
+#endif
+}
+
+/*!
+  @brief   Start a given number of worker tasks, spread across the CPU
+           cores other than the calling task's. Any previously started are
+           stopped first.
+  @param   n  Number of worker tasks, up to DOTSTAR_RENDER_WORKERS; 0 to
+              run serially. More workers than cores gives no speedup.
+  @return  true if workers were started, false if running serially (0
+           requested, one core, or out of memory).
+*/
+bool Adafruit_DotStarRender::begin(uint8_t n) {
+  stop();
+#ifdef DOTSTAR_RENDER_PARALLEL
+  if (n > DOTSTAR_RENDER_WORKERS)
+    n = DOTSTAR_RENDER_WORKERS;
+  if (!n || !(done = xSemaphoreCreateCounting(n, 0)))
+    return false;
+  chunks = (uint8_t *)malloc(DOTSTAR_RENDER_CHUNK * 4 * 2);
+  BaseType_t core = xPortGetCoreID();
+  UBaseType_t priority = uxTaskPriorityGet(NULL);
+  for (; workerCount < n; workerCount++) {
+    Worker *w = &workers[workerCount];
+    w->strip = strip;
+    w->done = done;
+    if (!(w->start = xSemaphoreCreateBinary()))
+      break;
+    core = (core + 1) % portNUM_PROCESSORS;
+    if (xTaskCreatePinnedToCore(task, "DotStar", DOTSTAR_RENDER_STACK, w,
+                                priority, &w->task, core) != pdPASS) {
+      vSemaphoreDelete(w->start);
+      break;
+    }
+  }
+  if (!workerCount)
+    stop();
+#else
+  (void)n; // No workers to start
+#endif
+  return workerCount > 0;
+}
+
+/*!
+  @brief   Stop all worker tasks and release their resources. Tasks are
+           only ever idle (waiting on their semaphore) outside of run()
+           and show(), so they're deleted as-is.
+*/
+void Adafruit_DotStarRender::stop(void) {
+#ifdef DOTSTAR_RENDER_PARALLEL
+  while (workerCount) {
+    Worker *w = &workers[--workerCount];
+    vTaskDelete(w->task);
+    vSemaphoreDelete(w->start);
+  }
+  if (done) {
+    vSemaphoreDelete(done);
+    done = NULL;
+  }
+  free(chunks);
+  chunks = NULL;
+#endif
+}
+
+#ifdef DOTSTAR_RENDER_PARALLEL
+
+/*!
+  @brief   Worker task: wait for a job, run it, signal it's done, repeat.
+  @param   arg  Pointer to this task's Worker state.
+*/
+void Adafruit_DotStarRender::task(void *arg) {
+  Worker *w = (Worker *)arg;
+  for (;;) {
+    xSemaphoreTake(w->start, portMAX_DELAY);
+    w->kernel(w->strip, w->first, w->count, w->arg);
+    xSemaphoreGive(w->done);
+  }
+}
+
+/*!
+  @brief   Hand a job to a worker task. It starts right away; call wait()
+           before handing it another.
+  @param   i       Worker index.
+  @param   kernel  Function to call, see run().
+  @param   arg     Argument passed to kernel.
+  @param   first   Index of first pixel.
+  @param   count   Number of pixels.
+*/
+void Adafruit_DotStarRender::post(
+    uint8_t i, void (*kernel)(Adafruit_DotStar *, uint16_t, uint16_t, void *),
+    void *arg, uint16_t first, uint16_t count) {
+  Worker *w = &workers[i];
+  w->kernel = kernel;
+  w->arg = arg;
+  w->first = first;
+  w->count = count;
+  xSemaphoreGive(w->start);
+}
+
+/*!
+  @brief   Wait for jobs handed to workers with post() to finish.
+  @param   n  Number of jobs outstanding.
+*/
+void Adafruit_DotStarRender::wait(uint8_t n) {
+  while (n--)
+    xSemaphoreTake(done, portMAX_DELAY);
+}
+
+#endif // DOTSTAR_RENDER_PARALLEL
+
+/*!
+  @brief   Call a kernel on one tile per task, returning once all are done.
+           Tiles are a multiple of 4 pixels long, so that no two tiles
+           share a byte of a packed (DOTSTAR_MONO or 4-bit palette) buffer.
+  @param   kernel  Function to call, see run().
+  @param   arg     Argument passed to kernel.
+*/
+void Adafruit_DotStarRender::split(
+    void (*kernel)(Adafruit_DotStar *, uint16_t, uint16_t, void *),
+    void *arg) {
+  uint16_t n = strip->numLEDs;
+  if (!n)
+    return;
+  uint32_t tile = ((uint32_t)n + workerCount) / (workerCount + 1);
+  tile = (tile + 3) & ~3UL;
+#ifdef DOTSTAR_RENDER_PARALLEL
+  uint8_t posted = 0;
+  for (uint32_t first = tile; (posted < workerCount) && (first < n);
+       first += tile) {
+    post(posted++, kernel, arg, first, (n - first < tile) ? n - first : tile);
+  }
+#endif
+  kernel(strip, 0, (n < tile) ? n : tile, arg);
+#ifdef DOTSTAR_RENDER_PARALLEL
+  wait(posted); // All tiles are complete past this point
+#endif
+}
+
+/*!
+  @brief   Render the strip's pixel buffer in parallel. The strip is split
+           into one tile per task (calling task plus workers), the kernel
+           is called once for each tile, and this returns once all have
+           finished, so show() can follow right away.
+  @param   kernel  Function called with the strip, the index of the first
+                   pixel in the tile, the number of pixels in the tile,
+                   and arg. It may call Adafruit_DotStar functions that
+                   change only pixels in its tile (e.g. setPixelColor(),
+                   or fill() and fade() given the same range), but must
+                   not read or write pixels outside of it, as another core
+                   may be changing those.
+  @param   arg     Argument passed to kernel, e.g. pointer to effect state.
+  @note    All pixels are marked dirty, see setDirtyTracking().
+*/
+void Adafruit_DotStarRender::run(
+    void (*kernel)(Adafruit_DotStar *, uint16_t, uint16_t, void *),
+    void *arg) {
+  // Marking the whole strip dirty (and the power estimate stale) first
+  // means the kernels' own calls to touch() never change either, so cores
+  // don't race to update them.
+  strip->touch(0, strip->numLEDs);
+  split(kernel, arg);
+}
+
+/*!
+  @brief   run() kernel for fill().
+  @param   s      Strip.
+  @param   first  Index of first pixel.
+  @param   count  Number of pixels.
+  @param   arg    Pointer to 32-bit color.
+*/
+static void fillKernel(Adafruit_DotStar *s, uint16_t first, uint16_t count,
+                       void *arg) {
+  s->fill(*(uint32_t *)arg, first, count);
+}
+
+/*!
+  @brief   Fill the whole strip with a color, in parallel. Same result as
+           Adafruit_DotStar::fill().
+  @param   c  32-bit color value, e.g. 0x00RRGGBB. 0 (off) if unspecified.
+*/
+void Adafruit_DotStarRender::fill(uint32_t c) { run(fillKernel, &c); }
+
+/*!
+  @brief   run() kernel for fade().
+  @param   s      Strip.
+  @param   first  Index of first pixel.
+  @param   count  Number of pixels.
+  @param   arg    Pointer to 8-bit scale.
+*/
+static void fadeKernel(Adafruit_DotStar *s, uint16_t first, uint16_t count,
+                       void *arg) {
+  s->fade(*(uint8_t *)arg, first, count);
+}
+
+/*!
+  @brief   Scale all pixels toward black, in parallel. Same result as
+           Adafruit_DotStar::fade().
+  @param   scale  Multiplier, 0-255 = black to unchanged.
+*/
+void Adafruit_DotStarRender::fade(uint8_t scale) { run(fadeKernel, &scale); }
+
+/*!
+  @brief   Arguments for rainbowKernel(), as passed to rainbow().
+*/
+struct RainbowArgs {
+  uint16_t first_hue; ///< Hue of first pixel
+  int8_t reps;        ///< Cycles of the color wheel over the strip
+  uint8_t saturation; ///< Saturation, 0-255
+  uint8_t brightness; ///< Brightness/value, 0-255
+  bool gammify;       ///< If set, gamma-correct colors
+};
+
+/*!
+  @brief   run() kernel for rainbow().
+  @param   s      Strip.
+  @param   first  Index of first pixel.
+  @param   count  Number of pixels.
+  @param   arg    Pointer to RainbowArgs.
+*/
+void Adafruit_DotStarRender::rainbowKernel(Adafruit_DotStar *s,
+                                           uint16_t first, uint16_t count,
+                                           void *arg) {
+  RainbowArgs *a = (RainbowArgs *)arg;
+  s->rainbowSpan(a->first_hue, a->reps, a->saturation, a->brightness,
+                 a->gammify, first, count);
+}
+
+/*!
+  @brief   Fill the strip with one or more cycles of hues, in parallel.
+           Same result as Adafruit_DotStar::rainbow(); see there for
+           arguments.
+  @param   first_hue   Hue of first pixel, 0-65535.
+  @param   reps        Number of cycles of the color wheel over the length
+                       of the strip, negative to reverse.
+  @param   saturation  Saturation, 0-255.
+  @param   brightness  Brightness/value, 0-255.
+  @param   gammify     If true (default), apply gamma correction.
+*/
+void Adafruit_DotStarRender::rainbow(uint16_t first_hue, int8_t reps,
+                                     uint8_t saturation, uint8_t brightness,
+                                     bool gammify) {
+  RainbowArgs a = {first_hue, reps, saturation, brightness, gammify};
+  run(rainbowKernel, &a);
+}
+
+/*!
+  @brief   split() kernel for show() with a whole-frame buffer: encode a
+           tile into its place in the frame.
+  @param   s      Strip.
+  @param   first  Index of first pixel.
+  @param   count  Number of pixels.
+  @param   arg    Pointer to pixel data in frame (after start frame).
+*/
+void Adafruit_DotStarRender::encodeTile(Adafruit_DotStar *s, uint16_t first,
+                                        uint16_t count, void *arg) {
+  s->encode((uint8_t *)arg + (uint32_t)first * 4, s->pixels, first, count,
+            s->frameBrightness);
+}
+
+/*!
+  @brief   Worker job for show(): encode a chunk into a buffer.
+  @param   s      Strip.
+  @param   first  Index of first pixel.
+  @param   count  Number of pixels, up to DOTSTAR_RENDER_CHUNK.
+  @param   arg    Pointer to chunk buffer.
+*/
+void Adafruit_DotStarRender::encodeChunk(Adafruit_DotStar *s, uint16_t first,
+                                         uint16_t count, void *arg) {
+  s->encode((uint8_t *)arg, s->pixels, first, count, s->frameBrightness);
+}
+
+/*!
+  @brief   Transmit the strip's pixel data to DotStars, as
+           Adafruit_DotStar::show() (and producing the same output), with
+           encoding moved off the calling task: if the strip has a
+           whole-frame buffer (setFrameBuffer()), tiles of it are encoded
+           in parallel before the one bulk transfer; otherwise a worker
+           encodes each chunk while the calling task issues the previous
+           one. Runs Adafruit_DotStar::show() if there are no workers.
+*/
+void Adafruit_DotStarRender::show(void) {
+#ifdef DOTSTAR_RENDER_PARALLEL
+  Adafruit_DotStar *s = strip;
+  if (workerCount && s->pixels && (s->frame || chunks)) {
+    s->waitForShow();
+
+    if (s->dirtyTracking && !s->dither && !s->isDirty()) {
+      s->framesSkipped++;
+      return;
+    }
+    uint16_t n = s->numLEDs;
+    s->dirtyFirst = n; // Mark clean
+    s->dirtyEnd = 0;
+    s->pixelsEncoded += n;
+    uint8_t bright = s->limitBrightness(); // Also sets frameBrightness
+
+    if (s->frame) {
+      memset(s->frame, 0x00, 4); // [START FRAME]
+      split(encodeTile, s->frame + 4); // [PIXEL DATA]
+      memset(s->frame + 4 + (uint32_t)n * 4, 0xFF,
+             ((uint32_t)n + 15) / 16); // [END FRAME]
+      s->frameValid = true;
+      s->sendFrame();
+    } else {
+      s->spi_dev->beginTransaction();
+      uint8_t *buf[2] = {chunks, chunks + DOTSTAR_RENDER_CHUNK * 4};
+      uint16_t i, len, next;
+      uint8_t b = 0;
+
+      // [START FRAME]
+      memset(buf[0], 0x00, 4);
+      s->transmit(buf[0], 4);
+
+      // [PIXEL DATA] Worker 0 encodes chunk k+1 while this task issues
+      // chunk k (transmit() may overwrite its buffer, hence two).
+      len = (n > DOTSTAR_RENDER_CHUNK) ? DOTSTAR_RENDER_CHUNK : n;
+      s->encode(buf[0], s->pixels, 0, len, bright);
+      for (i = 0; len; i += len, len = next, b ^= 1) {
+        next = n - i - len;
+        if (next > DOTSTAR_RENDER_CHUNK)
+          next = DOTSTAR_RENDER_CHUNK;
+        if (next)
+          post(0, encodeChunk, buf[b ^ 1], i + len, next);
+        s->transmit(buf[b], len * 4);
+        if (next)
+          wait(1);
+      }
+
+      // [END FRAME]
+      s->endFrame(buf[0], DOTSTAR_RENDER_CHUNK * 4, n);
+      s->spi_dev->endTransaction();
+    }
+
+    if (s->output)
+      s->output->flush(); // Mark end of frame
+    return;
+  }
+#endif
+  strip->show();
+}
@@ -0,0 +1,127 @@
+/*!
+ * @file Adafruit_DotStarRender.h
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _ADAFRUIT_DOT_STAR_RENDER_H_
+#define _ADAFRUIT_DOT_STAR_RENDER_H_
+
+#include "Adafruit_DotStar.h"
+
+// Worker tasks need FreeRTOS and more than one core, i.e. ESP32 (but not
+// single-core variants such as ESP32-S2 and -C3). Elsewhere, everything
+// runs on the calling task.
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#if !defined(CONFIG_FREERTOS_UNICORE)
+#define DOTSTAR_RENDER_PARALLEL ///< Worker tasks are available
+#endif
+#endif
+
+#ifndef DOTSTAR_RENDER_WORKERS
+#define DOTSTAR_RENDER_WORKERS 3 ///< Max worker tasks (besides the caller)
+#endif
+
+// show() encodes this many pixels on a worker while the calling task
+// issues the previous chunk (2 chunks of 4 bytes per pixel are allocated).
+#ifndef DOTSTAR_RENDER_CHUNK
+#define DOTSTAR_RENDER_CHUNK 128 ///< Pixels per chunk in show()
+#endif
+
+#ifndef DOTSTAR_RENDER_STACK
+#define DOTSTAR_RENDER_STACK 4096 ///< Worker task stack size, bytes
+#endif
+
+/*!
+  @brief  Class that spreads work on a DotStar strip's pixel buffer across
+          CPU cores. The strip is split into one tile (contiguous run of
+          pixels) per core; a kernel function is called for each tile,
+          one on the calling task and the rest on worker tasks pinned to
+          the other cores, and run() returns once all tiles are done, so
+          the buffer is complete before show(). show() itself overlaps
+          encoding of each chunk with transmission of the one before.
+          Where there's only one core (or no FreeRTOS), begin() starts no
+          workers and the same calls run serially on the calling task.
+*/
+class Adafruit_DotStarRender {
+
+public:
+  Adafruit_DotStarRender(Adafruit_DotStar *strip);
+  ~Adafruit_DotStarRender(void);
+
+  bool begin(void);
+  bool begin(uint8_t n);
+  /*!
+    @brief   Get the number of worker tasks started by begin().
+    @return  Worker count, 0 if running serially.
+  */
+  uint8_t numWorkers(void) const { return workerCount; };
+
+  void run(void (*kernel)(Adafruit_DotStar *, uint16_t, uint16_t, void *),
+           void *arg = NULL);
+  void fill(uint32_t c = 0);
+  void fade(uint8_t scale);
+  void rainbow(uint16_t first_hue = 0, int8_t reps = 1,
+               uint8_t saturation = 255, uint8_t brightness = 255,
+               bool gammify = true);
+  void show(void);
+
+private:
+  void stop(void);
+  void split(void (*kernel)(Adafruit_DotStar *, uint16_t, uint16_t, void *),
+             void *arg);
+  static void rainbowKernel(Adafruit_DotStar *s, uint16_t first,
+                            uint16_t count, void *arg);
+  static void encodeTile(Adafruit_DotStar *s, uint16_t first, uint16_t count,
+                         void *arg);
+  static void encodeChunk(Adafruit_DotStar *s, uint16_t first,
+                          uint16_t count, void *arg);
+
+  Adafruit_DotStar *strip; ///< Strip being rendered
+  uint8_t workerCount = 0; ///< Worker tasks running
+
+#ifdef DOTSTAR_RENDER_PARALLEL
+  /*!
+    @brief  State of one worker task: the job it's been handed, and the
+            semaphores it waits on and signals.
+  */
+  struct Worker {
+    void (*kernel)(Adafruit_DotStar *, uint16_t, uint16_t, void *); ///< Job
+    void *arg;                     ///< Argument passed to kernel
+    uint16_t first;                ///< First pixel of tile
+    uint16_t count;                ///< Pixels in tile
+    Adafruit_DotStar *strip;       ///< Strip being rendered
+    TaskHandle_t task;             ///< Worker task
+    SemaphoreHandle_t start;       ///< Given to start the job
+    SemaphoreHandle_t done;        ///< Given by worker when job is done
+  } workers[DOTSTAR_RENDER_WORKERS]; ///< Worker task states
+
+  static void task(void *arg);
+  void post(uint8_t i,
+            void (*kernel)(Adafruit_DotStar *, uint16_t, uint16_t, void *),
+            void *arg, uint16_t first, uint16_t count);
+  void wait(uint8_t n);
+
+  SemaphoreHandle_t done = NULL; ///< Counts jobs finished
+  uint8_t *chunks = NULL;        ///< Two chunk buffers for show()
+#endif
+};
+
+#endif // _ADAFRUIT_DOT_STAR_RENDER_H_
@@ -0,0 +1,130 @@
+/*!
+ * @file Adafruit_DotStarScheduler.cpp
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "Adafruit_DotStarScheduler.h"
+
+/*!
+  @brief   Adafruit_DotStarScheduler constructor.
+  @param   strip   Pointer to Adafruit_DotStar object to animate. Call its
+                   begin() function as usual.
+  @param   fps     Target frame rate, in frames per second (default 60).
+  @param   render  Function to draw each frame, receiving the strip and
+                   frame number. Optional, see setRenderCallback().
+  @return  Adafruit_DotStarScheduler object. Call run() from loop().
+*/
+Adafruit_DotStarScheduler::Adafruit_DotStarScheduler(
+    Adafruit_DotStar *strip, uint16_t fps,
+    void (*render)(Adafruit_DotStar *, uint32_t))
+    : strip(strip), renderFunc(render) {
+  setFPS(fps);
+}
+
+/*!
+  @brief   Set the target frame rate. Restarts the frame count at 0 and
+           resets statistics.
+  @param   fps  Frames per second, 1 or higher.
+*/
+void Adafruit_DotStarScheduler::setFPS(uint16_t fps) {
+  this->fps = fps ? fps : 1;
+  period = 1000000UL / this->fps;
+  next = micros();
+  frame = 0;
+  resetStats();
+}
+
+/*!
+  @brief   Reset all statistics (times, byte and frame counts).
+*/
+void Adafruit_DotStarScheduler::resetStats(void) {
+  renderAvg = renderMax = 0;
+  showAvg = showMax = 0;
+  intervalAvg = 0;
+  bytesSent = 0;
+  framesShown = framesDropped = 0;
+}
+
+/*!
+  @brief   Render and show the next frame if it's due. Call this from
+           loop() as often as possible; it returns immediately if it's not
+           yet time for a frame, leaving time for other tasks.
+  @return  true if a frame was rendered and shown, false if not yet due.
+  @note    If one or more frame times have passed entirely (rendering or
+           show() took too long, or run() wasn't called often enough),
+           those frames are counted as dropped and the frame number skips
+           ahead, so that animation keeps to real time rather than slowing
+           down.
+*/
+bool Adafruit_DotStarScheduler::run(void) {
+  uint32_t now = micros(), late = now - next, t, skipped;
+
+  if ((int32_t)late < 0)
+    return false; // Not yet
+
+  if (late >= period) { // Fell behind by one or more frames
+    t = late / period;
+    framesDropped += t;
+    frame += t;
+    next += t * period;
+  }
+  next += period;
+
+  t = micros();
+  if (renderFunc)
+    (*renderFunc)(strip, frame);
+  uint32_t render = micros() - t;
+
+  skipped = strip->getFramesSkipped();
+  t = micros();
+  strip->show();
+  uint32_t show = micros() - t;
+  if (strip->getFramesSkipped() == skipped) // Not skipped by dirty tracking
+    bytesSent += strip->getFrameBytes();
+
+  // Rolling averages are kept at 8X, each new sample weighted 1/8
+  if (framesShown) {
+    renderAvg += render - (renderAvg >> 3);
+    showAvg += show - (showAvg >> 3);
+    if (framesShown > 1)
+      intervalAvg += (t - lastShow) - (intervalAvg >> 3);
+    else
+      intervalAvg = (t - lastShow) << 3;
+  } else {
+    renderAvg = render << 3;
+    showAvg = show << 3;
+  }
+  if (render > renderMax)
+    renderMax = render;
+  if (show > showMax)
+    showMax = show;
+  lastShow = t;
+  framesShown++;
+  frame++;
+  return true;
+}
+
+/*!
+  @brief   Get the frame rate actually achieved, averaged over recent
+           frames.
+  @return  Frames per second, or 0 if fewer than two frames have been
+           shown since the last resetStats().
+*/
+float Adafruit_DotStarScheduler::getActualFPS(void) const {
+  return intervalAvg ? 8000000.0 / intervalAvg : 0.0;
+}
@@ -0,0 +1,128 @@
+/*!
+ * @file Adafruit_DotStarScheduler.h
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _ADAFRUIT_DOT_STAR_SCHEDULER_H_
+#define _ADAFRUIT_DOT_STAR_SCHEDULER_H_
+
+#include "Adafruit_DotStar.h"
+
+/*!
+  @brief  Class that paces animation on a DotStar strip at a fixed frame
+          rate, in place of delay() in loop(). A render function is called
+          once per frame with a frame number that advances at exactly the
+          target rate (skipping ahead if frames are missed), so animation
+          speed doesn't depend on how long rendering and show() take.
+          Render time, show() time, bytes issued, dropped frames and the
+          achieved frame rate are recorded, for tuning strip length,
+          brightness, SPI clock etc. against a target rate.
+*/
+class Adafruit_DotStarScheduler {
+
+public:
+  Adafruit_DotStarScheduler(Adafruit_DotStar *strip, uint16_t fps = 60,
+                            void (*render)(Adafruit_DotStar *,
+                                           uint32_t) = NULL);
+
+  void setFPS(uint16_t fps);
+  /*!
+    @brief   Query the target frame rate.
+    @return  Frames per second, as set with the constructor or setFPS().
+  */
+  uint16_t getFPS(void) const { return fps; };
+  /*!
+    @brief   Set the function called to draw each frame.
+    @param   render  Function receiving the strip and frame number (which
+                     advances by 1 each 1/fps seconds), or NULL to only
+                     call show().
+  */
+  void setRenderCallback(void (*render)(Adafruit_DotStar *, uint32_t)) {
+    renderFunc = render;
+  };
+  bool run(void);
+  void resetStats(void);
+
+  /*!
+    @brief   Get the frame number to be passed to the render function
+             next, if run() is on time.
+    @return  Frame number, 0 = first frame after construction or
+             setFPS().
+  */
+  uint32_t getFrame(void) const { return frame; };
+  /*!
+    @brief   Get the average time spent in the render function.
+    @return  Rolling average render time in microseconds.
+  */
+  uint32_t getRenderTime(void) const { return renderAvg >> 3; };
+  /*!
+    @brief   Get the longest time spent in the render function since the
+             last resetStats().
+    @return  Maximum render time in microseconds.
+  */
+  uint32_t getRenderTimeMax(void) const { return renderMax; };
+  /*!
+    @brief   Get the average time spent in show().
+    @return  Rolling average show() time in microseconds.
+  */
+  uint32_t getShowTime(void) const { return showAvg >> 3; };
+  /*!
+    @brief   Get the longest time spent in show() since the last
+             resetStats().
+    @return  Maximum show() time in microseconds.
+  */
+  uint32_t getShowTimeMax(void) const { return showMax; };
+  /*!
+    @brief   Get the number of bytes issued to the strip since the last
+             resetStats(). Frames skipped by dirty tracking don't count.
+    @return  Total bytes.
+  */
+  uint32_t getBytesSent(void) const { return bytesSent; };
+  /*!
+    @brief   Get the number of frames shown since the last resetStats().
+    @return  Frame count.
+  */
+  uint32_t getFramesShown(void) const { return framesShown; };
+  /*!
+    @brief   Get the number of frames dropped (frame times that passed
+             entirely while the previous frame was still being rendered
+             or shown) since the last resetStats().
+    @return  Frame count.
+  */
+  uint32_t getFramesDropped(void) const { return framesDropped; };
+  float getActualFPS(void) const;
+
+private:
+  Adafruit_DotStar *strip;                          ///< Strip being animated
+  void (*renderFunc)(Adafruit_DotStar *, uint32_t); ///< Draws each frame
+  uint16_t fps;                                     ///< Target frame rate
+  uint32_t period;                                  ///< 1/fps in microseconds
+  uint32_t next;                                    ///< micros() of next frame
+  uint32_t frame;                                   ///< Next frame number
+  uint32_t lastShow;                                ///< micros() at last show
+  uint32_t renderAvg;                               ///< Render time avg * 8
+  uint32_t renderMax;                               ///< Longest render time
+  uint32_t showAvg;                                 ///< show() time avg * 8
+  uint32_t showMax;                                 ///< Longest show() time
+  uint32_t intervalAvg;                             ///< Frame interval avg * 8
+  uint32_t bytesSent;                               ///< Bytes issued
+  uint32_t framesShown;                             ///< Frames issued
+  uint32_t framesDropped;                           ///< Frame times missed
+};
+
+#endif // _ADAFRUIT_DOT_STAR_SCHEDULER_H_
@@ -0,0 +1,80 @@
+// Bakes an animation into a pre-encoded asset for Adafruit_DotStarPlayer
+// (see the player example). The animation is rendered once here, the
+// usual way, and every frame show() issues is recorded with
+// Adafruit_DotStarRecorder: already in wire format, with this strip's
+// color order and brightness applied, and stored as changes from the
+// previous frame. The recording is printed to the Serial console (115200
+// baud) as a C array; paste it into a header file and play it back with
+// next to no CPU time per frame. To bake to an SD card instead, pass an
+// open File in place of &cArray. Nothing needs to be connected to the
+// data/clock pins, and any board will do: the asset depends only on the
+// strip settings below, which the playing strip should match in length.
+
+#include <Adafruit_DotStarRecorder.h>
+#include <SPI.h>
+
+#define NUMPIXELS 30   // Number of LEDs in strip
+#define FRAME_US 33333 // Time per frame (30 frames/second)
+
+// Hardware SPI (MOSI, SCK pins), see strandtest example for soft SPI.
+Adafruit_DotStar strip(NUMPIXELS, DOTSTAR_BRG);
+
+// Output that prints bytes as the body of a C array.
+class CArrayPrint : public Print {
+public:
+  size_t write(uint8_t b) {
+    Serial.print(F("0x"));
+    if (b < 0x10)
+      Serial.print('0');
+    Serial.print(b, HEX);
+    Serial.print((++count % 12) ? F(", ") : F(",\n  "));
+    return 1;
+  }
+  uint32_t count = 0; // Bytes printed
+} cArray;
+
+// The animation: a comet chasing along the strip, its tail fading behind
+// it, so only a few pixels change per frame and the asset is compact.
+void drawFrame(uint16_t f) {
+  strip.fade(160);
+  strip.setPixelColor(f % NUMPIXELS, strip.ColorHSV(f * 65536L / NUMPIXELS));
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10);
+
+  strip.begin();
+  strip.setBrightness(64); // Baked in, as is the color order
+
+  // Run one lap first so the tail is already there when recording starts,
+  // and the recorded lap loops seamlessly.
+  for (uint16_t f = 0; f < NUMPIXELS; f++)
+    drawFrame(f);
+
+  Adafruit_DotStarRecorder recorder(&cArray, strip.getFrameBytes());
+  strip.setOutput(&recorder); // Record only, nothing goes to SPI
+
+  Serial.println(F("// Baked by the Adafruit_DotStar bake example"));
+  Serial.println(F("const uint8_t animation[] PROGMEM = {"));
+  Serial.print(F("  "));
+  uint32_t next = micros();
+  for (uint16_t f = 0; f < NUMPIXELS; f++) {
+    while ((int32_t)(micros() - next) < 0)
+      ; // Wait for this frame's time; the recording keeps the timing
+    next += FRAME_US;
+    drawFrame(f);
+    strip.show();
+  }
+  Serial.println(F("};"));
+  strip.setOutput(NULL);
+
+  Serial.print(F("// "));
+  Serial.print(cArray.count);
+  Serial.print(F(" bytes, vs. "));
+  Serial.print(strip.getFrameBytes() * NUMPIXELS);
+  Serial.println(F(" as raw frames"));
+}
+
+void loop() {}
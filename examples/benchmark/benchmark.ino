@@ -0,0 +1,265 @@
+// Timing benchmark for Adafruit DotStar library. Reports how long show()
+// takes and how many bytes go out over SPI per frame, and compares bulk
+// pixel operations against per-pixel setPixelColor() loops, so the effect
+// of library options, strip length and SPI clock rate can be compared on
+// real hardware. Results are printed to the Serial console at 115200 baud.
+// Nothing needs to be connected to the data/clock pins for this to run.
+// This is an optional demo: correctness of the output (and SPI transfer
+// counts) is checked automatically by the host tests in extras/host.
+
+#include <Adafruit_DotStar.h>
+#include <SPI.h>
+
+#define NUMPIXELS 144 // Number of LEDs in strip
+#define FRAMES 100    // Number of frames to average over
+#define DATAPIN 4     // Pins for soft SPI timing
+#define CLOCKPIN 5
+
+// Hardware SPI (MOSI, SCK pins), see strandtest example for soft SPI.
+Adafruit_DotStar strip(NUMPIXELS, DOTSTAR_BRG);
+
+// Output that discards everything, so show() can be timed without SPI,
+// i.e. just the cost of encoding pixels.
+class NullOutput : public Print {
+public:
+  size_t write(uint8_t) { return 1; }
+  size_t write(const uint8_t *, size_t len) { return len; }
+} nullOutput;
+
+// Stand-in for a network or serial sender: an endless stream of bytes
+// generated on the spot, so readPixels() can be timed without the
+// transport.
+class FakeSender : public Stream {
+public:
+  int available() { return 30000; }
+  int read() { return n++; }
+  int peek() { return n; }
+  size_t write(uint8_t) { return 1; }
+
+private:
+  uint8_t n = 0;
+} fakeSender;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10);
+
+  strip.begin();
+  strip.rainbow();
+  strip.setBrightness(100);
+
+  Serial.print(F("Pixels: "));
+  Serial.println(strip.numPixels());
+  Serial.print(F("Bytes/frame: "));
+  Serial.println(strip.getFrameBytes());
+
+  Serial.print(F("show(), chunked (uS/frame): "));
+  Serial.println(timeShow());
+
+  if (strip.setFrameBuffer(true)) {
+    Serial.print(F("show(), frame buffer (uS/frame): "));
+    Serial.println(timeShow());
+    strip.setFrameBuffer(false);
+  } else {
+    Serial.println(F("Not enough RAM for frame buffer"));
+  }
+
+  // Same again with soft (bitbang) SPI on two other pins
+  strip.updatePins(DATAPIN, CLOCKPIN);
+  Serial.print(F("show(), soft SPI (uS/frame): "));
+  Serial.println(timeShow());
+  strip.updatePins(); // Back to hardware SPI
+
+  // Encoding cost alone, with and without temporal dithering
+  strip.setOutput(&nullOutput);
+  Serial.print(F("Encode (cycles/pixel): "));
+  Serial.println(cyclesPerPixel(timeShow()));
+  if (strip.setDithering(true)) {
+    Serial.print(F("Encode, dithered (cycles/pixel): "));
+    Serial.println(cyclesPerPixel(timeShow()));
+    strip.setDithering(false);
+  } else {
+    Serial.println(F("Not enough RAM for dithering"));
+  }
+  strip.setOutput(NULL);
+
+  // Frame ingest throughput, incoming color order matching the strip's
+  // (read straight into pixel buffer) and not (remapped in place)
+  Serial.print(F("readPixels(), same order (KB/s): "));
+  Serial.println(timeReadPixels(DOTSTAR_BRG));
+  Serial.print(F("readPixels(), remapped (KB/s): "));
+  Serial.println(timeReadPixels(DOTSTAR_RGB));
+
+  // Compare fill operations at a few strip lengths; lengths that don't
+  // fit in RAM on this board are skipped.
+  uint16_t lengths[] = {100, 1000, 10000};
+  for (uint8_t i = 0; i < 3; i++) {
+    strip.updateLength(lengths[i]);
+    if (strip.numPixels() != lengths[i]) {
+      Serial.print(F("Not enough RAM for "));
+      Serial.println(lengths[i]);
+      break;
+    }
+    Serial.print(lengths[i]);
+    Serial.println(F(" pixels (uS/frame):"));
+    Serial.print(F("  setPixelColor() loop: "));
+    Serial.println(timeSetPixelColor());
+    Serial.print(F("  fill(): "));
+    Serial.println(timeFill());
+    Serial.print(F("  rotate(1): "));
+    Serial.println(timeRotate());
+    Serial.print(F("  ColorHSV() loop: "));
+    Serial.println(timeColorHSV());
+    Serial.print(F("  rainbow(): "));
+    Serial.println(timeRainbow());
+    Serial.print(F("  rainbow() matches ColorHSV(): "));
+    Serial.println(rainbowMatches() ? F("yes") : F("NO"));
+    Serial.print(F("  getPixelColor()/setPixelColor() fade loop: "));
+    Serial.println(timeFadeLoop());
+    Serial.print(F("  fade(): "));
+    Serial.println(timeFade());
+    Serial.print(F("  blend(): "));
+    Serial.println(timeBlend());
+    Serial.print(F("  add(): "));
+    Serial.println(timeAdd());
+    Serial.print(F("  blur(): "));
+    Serial.println(timeBlur());
+  }
+  strip.updateLength(NUMPIXELS);
+}
+
+void loop() {}
+
+// Average time for one call to show(), in microseconds
+uint32_t timeShow() {
+  uint32_t t = micros();
+  for (int i = 0; i < FRAMES; i++)
+    strip.show();
+  return (micros() - t) / FRAMES;
+}
+
+// Convert per-frame time in microseconds to CPU cycles per pixel
+uint32_t cyclesPerPixel(uint32_t us) {
+  return (uint64_t)us * (F_CPU / 1000000) / strip.numPixels();
+}
+
+// Throughput reading whole frames from fakeSender, in bytes/millisecond
+uint32_t timeReadPixels(uint8_t order) {
+  uint16_t n = strip.numPixels();
+  uint32_t t = micros();
+  for (int i = 0; i < FRAMES; i++)
+    strip.readPixels(fakeSender, 0, n, order);
+  t = micros() - t;
+  return (uint64_t)n * 3 * FRAMES * 1000 / (t ? t : 1);
+}
+
+// Average time to set every pixel one at a time, in microseconds
+uint32_t timeSetPixelColor() {
+  uint16_t n = strip.numPixels();
+  uint32_t t = micros();
+  for (int i = 0; i < FRAMES; i++) {
+    for (uint16_t j = 0; j < n; j++)
+      strip.setPixelColor(j, 0x102030);
+  }
+  return (micros() - t) / FRAMES;
+}
+
+// Average time to set every pixel with fill(), in microseconds
+uint32_t timeFill() {
+  uint32_t t = micros();
+  for (int i = 0; i < FRAMES; i++)
+    strip.fill(0x102030);
+  return (micros() - t) / FRAMES;
+}
+
+// Average time to scroll the whole strip by one pixel, in microseconds
+uint32_t timeRotate() {
+  uint32_t t = micros();
+  for (int i = 0; i < FRAMES; i++)
+    strip.rotate(1);
+  return (micros() - t) / FRAMES;
+}
+
+// Average time to fill strip with a rainbow by calling ColorHSV() and
+// gamma32() for each pixel, in microseconds
+uint32_t timeColorHSV() {
+  uint16_t n = strip.numPixels();
+  uint32_t t = micros();
+  for (int i = 0; i < FRAMES; i++) {
+    for (uint16_t j = 0; j < n; j++) {
+      uint16_t hue = (uint32_t)j * 65536 / n;
+      strip.setPixelColor(j, strip.gamma32(strip.ColorHSV(hue, 200, 150)));
+    }
+  }
+  return (micros() - t) / FRAMES;
+}
+
+// Average time to fill strip with the equivalent rainbow(), in microseconds
+uint32_t timeRainbow() {
+  uint32_t t = micros();
+  for (int i = 0; i < FRAMES; i++)
+    strip.rainbow(0, 1, 200, 150);
+  return (micros() - t) / FRAMES;
+}
+
+// Check that rainbow() produces the same colors as ColorHSV() + gamma32()
+bool rainbowMatches() {
+  uint16_t n = strip.numPixels();
+  strip.rainbow(12345, 3, 200, 150);
+  for (uint16_t j = 0; j < n; j++) {
+    uint16_t hue = 12345 + (uint32_t)j * 3 * 65536 / n;
+    if (strip.getPixelColor(j) != strip.gamma32(strip.ColorHSV(hue, 200, 150)))
+      return false;
+  }
+  return true;
+}
+
+// Average time to fade every pixel by unpacking, scaling and repacking
+// its color, in microseconds
+uint32_t timeFadeLoop() {
+  uint16_t n = strip.numPixels();
+  uint32_t t = micros();
+  for (int i = 0; i < FRAMES; i++) {
+    for (uint16_t j = 0; j < n; j++) {
+      uint32_t c = strip.getPixelColor(j);
+      uint8_t r = c >> 16, g = c >> 8, b = c;
+      strip.setPixelColor(j, (r * 200) >> 8, (g * 200) >> 8, (b * 200) >> 8);
+    }
+  }
+  return (micros() - t) / FRAMES;
+}
+
+// Average time for the equivalent fade(), in microseconds
+uint32_t timeFade() {
+  uint32_t t = micros();
+  for (int i = 0; i < FRAMES; i++)
+    strip.fade(199);
+  return (micros() - t) / FRAMES;
+}
+
+// Average time to crossfade the whole strip, in microseconds. The strip
+// is blended with itself, to avoid needing RAM for another, but the work
+// is the same.
+uint32_t timeBlend() {
+  uint32_t t = micros();
+  for (int i = 0; i < FRAMES; i++)
+    strip.blend(strip, strip, 100);
+  return (micros() - t) / FRAMES;
+}
+
+// Average time to add a strip's pixels (itself, as above), in microseconds
+uint32_t timeAdd() {
+  uint32_t t = micros();
+  for (int i = 0; i < FRAMES; i++)
+    strip.add(strip);
+  return (micros() - t) / FRAMES;
+}
+
+// Average time to blur the whole strip, in microseconds
+uint32_t timeBlur() {
+  uint32_t t = micros();
+  for (int i = 0; i < FRAMES; i++)
+    strip.blur(128);
+  return (micros() - t) / FRAMES;
+}
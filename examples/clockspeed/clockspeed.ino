@@ -0,0 +1,54 @@
+// Helps pick the fastest SPI clock rate that works reliably with a given
+// strip and wiring. Steps through a range of clock rates, reporting the
+// time per frame at each to the Serial console (115200 baud), then shows
+// a test pattern at that rate for a few seconds. Watch the strip: the
+// fastest rate at which the pattern is still clean (no flicker, wrong
+// colors or dead pixels past some point) is the one to use, e.g. pass it
+// to the constructor or setClockSpeed(). Leave some margin if possible.
+
+#include <Adafruit_DotStar.h>
+#include <SPI.h>
+
+#define NUMPIXELS 144 // Number of LEDs in strip
+
+// Hardware SPI (MOSI, SCK pins), see strandtest example for soft SPI.
+Adafruit_DotStar strip(NUMPIXELS, DOTSTAR_BRG);
+
+// Clock rates to try, in Hz
+const uint32_t rates[] = {1000000,  2000000,  4000000,  8000000,
+                          12000000, 16000000, 20000000, 24000000,
+                          32000000};
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10);
+
+  strip.begin();
+  strip.setBrightness(32);
+  strip.rainbow();
+
+  Serial.print(F("Bytes/frame: "));
+  Serial.println(strip.getFrameBytes());
+}
+
+void loop() {
+  for (uint8_t i = 0; i < sizeof rates / sizeof rates[0]; i++) {
+    uint32_t us = strip.measureShowTime(rates[i]);
+    Serial.print(rates[i] / 1000);
+    Serial.print(F(" kHz: "));
+    Serial.print(us);
+    Serial.print(F(" uS/frame, "));
+    Serial.print(strip.getFrameBytes() * 1000UL / (us ? us : 1));
+    Serial.println(F(" KB/s"));
+
+    // Animate the test pattern at this rate for a while
+    strip.setClockSpeed(rates[i]);
+    for (uint16_t hue = 0; hue < 65536 - 512; hue += 512) {
+      strip.rainbow(hue);
+      strip.show();
+      delay(20);
+    }
+  }
+  Serial.println();
+}
@@ -0,0 +1,27 @@
+// Receives frames over USB serial using the Adalight protocol, as sent by
+// many PC ambient-lighting and media-server programs (Prismatik, Hyperion,
+// etc.), and shows them on a DotStar strip. Set the program's LED count
+// to match NUMPIXELS and its baud rate to match below. Any other Stream
+// (a file, network client, UDP packet...) can be used in place of Serial.
+
+#include <Adafruit_DotStarIngest.h>
+#include <SPI.h>
+
+#define NUMPIXELS 144 // Number of LEDs in strip
+#define BAUDRATE 1000000
+
+// Hardware SPI (MOSI, SCK pins), see strandtest example for soft SPI.
+Adafruit_DotStar strip(NUMPIXELS, DOTSTAR_BRG);
+
+Adafruit_DotStarIngest ingest(&strip, &Serial, DOTSTAR_INGEST_ADALIGHT);
+
+void setup() {
+  Serial.begin(BAUDRATE);
+  strip.begin();
+  strip.show(); // Turn all LEDs off ASAP
+  Serial.print("Ada\n"); // Some senders wait for this greeting
+}
+
+void loop() {
+  ingest.run(); // Shows each frame as soon as it's complete
+}
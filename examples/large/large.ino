@@ -0,0 +1,68 @@
+// Scaling benchmark for Adafruit_DotStarLarge, the variant for chains
+// longer than 65,535 pixels. For strip lengths up to 1 million pixels,
+// reports the time to fill(), set every pixel with setPixelColor(), and
+// encode a frame with show() (output discarded, so this is the CPU cost
+// alone; actually issuing it takes getFrameBytes() * 8 / clock rate
+// seconds on top). Lengths that don't fit in RAM on this board are
+// skipped; the pixel buffer is allocated in segments, so boards with
+// external RAM (e.g. ESP32 with PSRAM) can go further than a single
+// allocation would allow. Results are printed to the Serial console at
+// 115200 baud. Nothing needs to be connected to the data/clock pins.
+// This is an optional demo: output of long strips (including the end
+// frame past 65,535 pixels) is checked automatically by the host tests
+// in extras/host.
+
+#include <Adafruit_DotStarLarge.h>
+#include <SPI.h>
+
+// Hardware SPI (MOSI, SCK pins), see strandtest example for soft SPI.
+Adafruit_DotStarLarge strip(0, DOTSTAR_BRG);
+
+// Output that discards everything, so show() can be timed without SPI.
+class NullOutput : public Print {
+public:
+  size_t write(uint8_t) { return 1; }
+  size_t write(const uint8_t *, size_t len) { return len; }
+} nullOutput;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10);
+
+  strip.begin();
+  strip.setOutput(&nullOutput);
+
+  static const uint32_t lengths[] = {10000, 100000, 1000000};
+  for (uint8_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+    strip.updateLength(lengths[i]);
+    if (strip.numPixels() != lengths[i]) {
+      Serial.print(F("Not enough RAM for "));
+      Serial.println(lengths[i]);
+      break;
+    }
+    Serial.print(lengths[i]);
+    Serial.print(F(" pixels, "));
+    Serial.print(strip.numSegments());
+    Serial.println(F(" segments (uS):"));
+
+    uint32_t t = micros();
+    strip.fill(0x102030);
+    Serial.print(F("  fill(): "));
+    Serial.println(micros() - t);
+
+    t = micros();
+    for (uint32_t j = 0; j < lengths[i]; j++)
+      strip.setPixelColor(j, j * 0x010203);
+    Serial.print(F("  setPixelColor() loop: "));
+    Serial.println(micros() - t);
+
+    t = micros();
+    strip.show();
+    Serial.print(F("  show(), encode only: "));
+    Serial.println(micros() - t);
+  }
+  strip.updateLength(0);
+}
+
+void loop() {}
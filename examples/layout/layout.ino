@@ -0,0 +1,79 @@
+// Benchmark for Adafruit_DotStarLayout: times full-frame 2D drawing on a
+// 64x64 serpentine matrix three ways -- computing each pixel's strip
+// index by hand and calling setPixelColor(), drawPixel() through the
+// layout's lookup table, and blitting a whole image with drawImage().
+// The matrix is 'virtual': nothing is shown, so no LEDs are needed.
+// Needs about 36K of RAM (strip, lookup table and image), e.g. SAMD51,
+// ESP32 or RP2040. Results are printed to the Serial console at 115200.
+
+#include <Adafruit_DotStarLayout.h>
+#include <SPI.h>
+
+#define WIDTH 64
+#define HEIGHT 64
+#define FRAMES 20 // Number of frames to average over
+
+// Hardware SPI (MOSI, SCK pins), see strandtest example for soft SPI.
+Adafruit_DotStar strip(WIDTH * HEIGHT, DOTSTAR_BRG);
+
+// Maps x/y to strip pixels, set up in setup()
+Adafruit_DotStarLayout layout(&strip);
+
+uint32_t *image;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10);
+
+  strip.begin();
+  image = (uint32_t *)malloc(WIDTH * HEIGHT * sizeof(uint32_t));
+  if (!image || !strip.numPixels() ||
+      !layout.setMatrix(WIDTH, HEIGHT,
+                        DOTSTAR_LAYOUT_TOP + DOTSTAR_LAYOUT_LEFT +
+                            DOTSTAR_LAYOUT_ROWS + DOTSTAR_LAYOUT_ZIGZAG)) {
+    Serial.println(F("Not enough RAM"));
+    return;
+  }
+  for (uint16_t i = 0; i < WIDTH * HEIGHT; i++)
+    image[i] = strip.ColorHSV(i * 16);
+
+  uint32_t t, f;
+  uint16_t x, y;
+
+  t = micros();
+  for (f = 0; f < FRAMES; f++) {
+    for (y = 0; y < HEIGHT; y++) {
+      for (x = 0; x < WIDTH; x++) {
+        uint16_t i = (y & 1) ? (y * WIDTH + WIDTH - 1 - x) : (y * WIDTH + x);
+        strip.setPixelColor(i, image[y * WIDTH + x]);
+      }
+    }
+  }
+  Serial.print(F("setPixelColor(), index computed (uS/frame): "));
+  Serial.println((micros() - t) / FRAMES);
+
+  t = micros();
+  for (f = 0; f < FRAMES; f++) {
+    for (y = 0; y < HEIGHT; y++) {
+      for (x = 0; x < WIDTH; x++)
+        layout.drawPixel(x, y, image[y * WIDTH + x]);
+    }
+  }
+  Serial.print(F("drawPixel() (uS/frame): "));
+  Serial.println((micros() - t) / FRAMES);
+
+  t = micros();
+  for (f = 0; f < FRAMES; f++)
+    layout.drawImage(0, 0, WIDTH, HEIGHT, image);
+  Serial.print(F("drawImage() (uS/frame): "));
+  Serial.println((micros() - t) / FRAMES);
+
+  t = micros();
+  for (f = 0; f < FRAMES; f++)
+    layout.fillRect(0, 0, WIDTH, HEIGHT, f);
+  Serial.print(F("fillRect() (uS/frame): "));
+  Serial.println((micros() - t) / FRAMES);
+}
+
+void loop() {}
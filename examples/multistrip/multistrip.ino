@@ -0,0 +1,32 @@
+// Drives several DotStar strips at once from one clock pin, each with its
+// own data pin. All strips are refreshed concurrently, so adding strips
+// doesn't multiply the time spent in show(). For best speed, put the
+// clock and data pins on the same GPIO port (e.g. Uno pins 2-7 = PORTD).
+
+#include <Adafruit_DotStarGroup.h>
+
+#define NUMPIXELS 30 // Number of LEDs in each strip
+#define CLOCKPIN 7   // Clock pin shared by all strips
+
+Adafruit_DotStarGroup group(CLOCKPIN);
+
+void setup() {
+  group.addStrip(NUMPIXELS, 2, DOTSTAR_BRG); // Data pins 2, 3, 4
+  group.addStrip(NUMPIXELS, 3, DOTSTAR_BRG);
+  group.addStrip(NUMPIXELS, 4, DOTSTAR_BRG);
+  group.begin();
+  group.show(); // Turn all LEDs off ASAP
+}
+
+uint16_t hue = 0;
+
+void loop() {
+  // Same rainbow on every strip, each one offset a little further
+  for (uint8_t i = 0; i < group.numStrips(); i++) {
+    Adafruit_DotStar *strip = group.getStrip(i);
+    strip->setBrightness(32);
+    strip->rainbow(hue + i * 8192);
+  }
+  group.show();
+  hue += 256;
+}
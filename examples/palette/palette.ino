@@ -0,0 +1,36 @@
+// Palette-indexed storage: each pixel is a 4-bit index into a 16-color
+// palette (half a byte per pixel instead of 3 bytes), so very long strips
+// fit in much less RAM. Animation here is done purely by rotating the
+// palette colors; the pixels themselves are set once and never change,
+// so each frame costs the same however long the strip is.
+
+#include <Adafruit_DotStar.h>
+#include <SPI.h>
+
+#define NUMPIXELS 1000 // Number of LEDs in strip
+
+// Hardware SPI (MOSI, SCK pins), see strandtest example for soft SPI.
+// Length starts at 0 so a full 3-byte-per-pixel buffer is never allocated.
+Adafruit_DotStar strip(0, DOTSTAR_BRG);
+
+void setup() {
+  strip.begin();
+  strip.setBrightness(32);
+  strip.setPaletteMode(4); // 4 bits/pixel, 16 colors
+  strip.updateLength(NUMPIXELS);
+
+  // Repeating 0-15 pattern of palette indices along the strip
+  for (uint16_t i = 0; i < strip.numPixels(); i++)
+    strip.setPixelIndex(i, i & 15);
+}
+
+uint16_t hue = 0;
+
+void loop() {
+  // Recolor the whole strip by changing just 16 palette entries
+  for (uint8_t i = 0; i < 16; i++)
+    strip.setPaletteColor(i, strip.gamma32(strip.ColorHSV(hue + i * 4096)));
+  strip.show();
+  hue += 256;
+  delay(10);
+}
@@ -0,0 +1,119 @@
+// Animation asset for the player example, baked by the bake example: a
+// comet on 30 pixels, DOTSTAR_BRG, brightness 64, 30 frames at 30 frames
+// per second.
+
+const uint8_t animation[] PROGMEM = {
+  0x44, 0x53, 0x52, 0x01, 0x18, 0x7E, 0x04, 0x05, 0xFF, 0x00, 0x40, 0x00,
+  0xFF, 0x03, 0x01, 0xFF, 0x03, 0x01, 0xFF, 0x03, 0x01, 0xFF, 0x03, 0x01,
+  0xFF, 0x03, 0x01, 0xFF, 0x03, 0x01, 0xFF, 0x03, 0x01, 0xFF, 0x03, 0x01,
+  0xFF, 0x03, 0x01, 0xFF, 0x03, 0x01, 0xFF, 0x03, 0x01, 0xFF, 0x03, 0x01,
+  0xFF, 0x03, 0x01, 0xFF, 0x03, 0x01, 0xFF, 0x03, 0x01, 0xFF, 0x03, 0x01,
+  0xFF, 0x03, 0x01, 0xFF, 0x03, 0x01, 0xFF, 0x03, 0x01, 0xFF, 0x03, 0x01,
+  0xFF, 0x03, 0x22, 0xFF, 0x01, 0x00, 0x00, 0xFF, 0x02, 0x01, 0x00, 0xFF,
+  0x03, 0x02, 0x00, 0xFF, 0x05, 0x05, 0x00, 0xFF, 0x07, 0x09, 0x00, 0xFF,
+  0x09, 0x0F, 0x00, 0xFF, 0x0A, 0x19, 0x00, 0xFF, 0x08, 0x28, 0x00, 0xFF,
+  0xFF, 0xB6, 0x84, 0x02, 0x7E, 0x06, 0x01, 0x28, 0x03, 0x02, 0x40, 0x0C,
+  0x51, 0x01, 0x00, 0x03, 0x1A, 0x01, 0x00, 0x00, 0xFF, 0x02, 0x01, 0x00,
+  0xFF, 0x03, 0x03, 0x00, 0xFF, 0x04, 0x05, 0x00, 0xFF, 0x05, 0x09, 0x00,
+  0xFF, 0x06, 0x0F, 0x00, 0xFF, 0x05, 0x19, 0x03, 0x00, 0xB8, 0x84, 0x02,
+  0x7E, 0x06, 0x01, 0x19, 0x03, 0x06, 0x28, 0x08, 0xFF, 0x00, 0x40, 0x19,
+  0x51, 0x01, 0x00, 0x03, 0x16, 0x01, 0x00, 0x00, 0xFF, 0x02, 0x02, 0x00,
+  0xFF, 0x02, 0x03, 0x00, 0xFF, 0x03, 0x05, 0x00, 0xFF, 0x03, 0x09, 0x00,
+  0xFF, 0x03, 0x0F, 0x03, 0x00, 0xB3, 0x84, 0x02, 0x7E, 0x06, 0x01, 0x0F,
+  0x03, 0x0A, 0x19, 0x05, 0xFF, 0x00, 0x28, 0x10, 0xFF, 0x00, 0x40, 0x26,
+  0x51, 0x01, 0x00, 0x03, 0x12, 0x01, 0x01, 0x00, 0xFF, 0x01, 0x02, 0x00,
+  0xFF, 0x02, 0x03, 0x00, 0xFF, 0x02, 0x05, 0x00, 0xFF, 0x01, 0x09, 0x03,
+  0x00, 0xB4, 0x84, 0x02, 0x7E, 0x06, 0x01, 0x09, 0x03, 0x0E, 0x0F, 0x03,
+  0xFF, 0x00, 0x19, 0x0A, 0xFF, 0x00, 0x28, 0x18, 0xFF, 0x00, 0x40, 0x33,
+  0x51, 0x0E, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x01, 0x00, 0xFF, 0x01, 0x02,
+  0x00, 0xFF, 0x01, 0x03, 0x03, 0x01, 0x05, 0x03, 0x00, 0xB9, 0x84, 0x02,
+  0x7E, 0x06, 0x01, 0x05, 0x03, 0x12, 0x09, 0x01, 0xFF, 0x00, 0x0F, 0x06,
+  0xFF, 0x00, 0x19, 0x0F, 0xFF, 0x00, 0x28, 0x20, 0xFF, 0x00, 0x40, 0x40,
+  0x52, 0x0D, 0x00, 0x00, 0xFF, 0x00, 0x01, 0x00, 0xFF, 0x00, 0x02, 0x00,
+  0xFF, 0x00, 0x03, 0x03, 0x00, 0xB1, 0x84, 0x02, 0x7E, 0x06, 0x01, 0x03,
+  0x03, 0x01, 0x05, 0x03, 0x12, 0x09, 0x03, 0xFF, 0x00, 0x0F, 0x09, 0xFF,
+  0x00, 0x19, 0x14, 0xFF, 0x00, 0x28, 0x28, 0xFF, 0x00, 0x33, 0x40, 0x52,
+  0x01, 0x00, 0x03, 0x01, 0x01, 0x03, 0x01, 0x02, 0x03, 0x00, 0xB5, 0x84,
+  0x02, 0x7E, 0x06, 0x01, 0x02, 0x03, 0x1A, 0x03, 0x00, 0xFF, 0x00, 0x05,
+  0x02, 0xFF, 0x00, 0x09, 0x05, 0xFF, 0x00, 0x0F, 0x0C, 0xFF, 0x00, 0x19,
+  0x19, 0xFF, 0x00, 0x20, 0x28, 0xFF, 0x00, 0x26, 0x40, 0x52, 0x01, 0x00,
+  0x03, 0x01, 0x01, 0x03, 0x00, 0xB5, 0x84, 0x02, 0x7E, 0x06, 0x01, 0x01,
+  0x03, 0x01, 0x02, 0x03, 0x1A, 0x03, 0x01, 0xFF, 0x00, 0x05, 0x03, 0xFF,
+  0x00, 0x09, 0x07, 0xFF, 0x00, 0x0F, 0x0F, 0xFF, 0x00, 0x14, 0x19, 0xFF,
+  0x00, 0x18, 0x28, 0xFF, 0x00, 0x19, 0x40, 0x52, 0x01, 0x00, 0x03, 0x00,
+  0xB5, 0x84, 0x02, 0x7E, 0x06, 0x01, 0x00, 0x03, 0x01, 0x01, 0x03, 0x1E,
+  0x02, 0x00, 0xFF, 0x00, 0x03, 0x02, 0xFF, 0x00, 0x05, 0x04, 0xFF, 0x00,
+  0x09, 0x09, 0xFF, 0x00, 0x0C, 0x0F, 0xFF, 0x00, 0x0F, 0x19, 0xFF, 0x00,
+  0x10, 0x28, 0xFF, 0x00, 0x0C, 0x40, 0x52, 0x00, 0xB6, 0x84, 0x02, 0x7E,
+  0x0A, 0x01, 0x00, 0x03, 0x01, 0x01, 0x03, 0x1A, 0x02, 0x01, 0xFF, 0x00,
+  0x03, 0x02, 0xFF, 0x00, 0x05, 0x05, 0xFF, 0x00, 0x07, 0x09, 0xFF, 0x00,
+  0x09, 0x0F, 0xFF, 0x00, 0x0A, 0x19, 0xFF, 0x00, 0x08, 0x28, 0x03, 0x01,
+  0x40, 0x4E, 0x00, 0xB5, 0x84, 0x02, 0x7E, 0x0E, 0x01, 0x00, 0x03, 0x1A,
+  0x01, 0x00, 0xFF, 0x00, 0x02, 0x01, 0xFF, 0x00, 0x03, 0x03, 0xFF, 0x00,
+  0x04, 0x05, 0xFF, 0x00, 0x05, 0x09, 0xFF, 0x00, 0x06, 0x0F, 0xFF, 0x00,
+  0x05, 0x19, 0x03, 0x05, 0x28, 0xFF, 0x0C, 0x00, 0x40, 0x4A, 0x00, 0xB5,
+  0x84, 0x02, 0x7E, 0x12, 0x01, 0x00, 0x03, 0x16, 0x01, 0x00, 0xFF, 0x00,
+  0x02, 0x02, 0xFF, 0x00, 0x02, 0x03, 0xFF, 0x00, 0x03, 0x05, 0xFF, 0x00,
+  0x03, 0x09, 0xFF, 0x00, 0x03, 0x0F, 0x03, 0x09, 0x19, 0xFF, 0x08, 0x00,
+  0x28, 0xFF, 0x19, 0x00, 0x40, 0x46, 0x00, 0xB4, 0x84, 0x02, 0x7E, 0x16,
+  0x01, 0x00, 0x03, 0x12, 0x01, 0x01, 0xFF, 0x00, 0x01, 0x02, 0xFF, 0x00,
+  0x02, 0x03, 0xFF, 0x00, 0x02, 0x05, 0xFF, 0x00, 0x01, 0x09, 0x03, 0x0D,
+  0x0F, 0xFF, 0x05, 0x00, 0x19, 0xFF, 0x10, 0x00, 0x28, 0xFF, 0x26, 0x00,
+  0x40, 0x42, 0x00, 0xB5, 0x84, 0x02, 0x7E, 0x1A, 0x0E, 0x00, 0x00, 0xFF,
+  0x00, 0x00, 0x01, 0xFF, 0x00, 0x01, 0x02, 0xFF, 0x00, 0x01, 0x03, 0x03,
+  0x01, 0x05, 0x03, 0x11, 0x09, 0xFF, 0x03, 0x00, 0x0F, 0xFF, 0x0A, 0x00,
+  0x19, 0xFF, 0x18, 0x00, 0x28, 0xFF, 0x33, 0x00, 0x40, 0x3E, 0x00, 0xB5,
+  0x84, 0x02, 0x7E, 0x1F, 0x0D, 0x00, 0xFF, 0x00, 0x00, 0x01, 0xFF, 0x00,
+  0x00, 0x02, 0xFF, 0x00, 0x00, 0x03, 0x03, 0x15, 0x05, 0xFF, 0x01, 0x00,
+  0x09, 0xFF, 0x06, 0x00, 0x0F, 0xFF, 0x0F, 0x00, 0x19, 0xFF, 0x20, 0x00,
+  0x28, 0xFF, 0x40, 0x00, 0x40, 0x3A, 0x00, 0xB6, 0x84, 0x02, 0x7E, 0x23,
+  0x01, 0x00, 0x03, 0x01, 0x01, 0x03, 0x01, 0x02, 0x03, 0x01, 0x03, 0x03,
+  0x15, 0x05, 0xFF, 0x03, 0x00, 0x09, 0xFF, 0x09, 0x00, 0x0F, 0xFF, 0x14,
+  0x00, 0x19, 0xFF, 0x28, 0x00, 0x28, 0xFF, 0x40, 0x00, 0x33, 0x36, 0x00,
+  0xB5, 0x84, 0x02, 0x7E, 0x27, 0x01, 0x00, 0x03, 0x01, 0x01, 0x03, 0x1D,
+  0x02, 0xFF, 0x00, 0x00, 0x03, 0xFF, 0x02, 0x00, 0x05, 0xFF, 0x05, 0x00,
+  0x09, 0xFF, 0x0C, 0x00, 0x0F, 0xFF, 0x19, 0x00, 0x19, 0xFF, 0x28, 0x00,
+  0x20, 0xFF, 0x40, 0x00, 0x26, 0x32, 0x00, 0xB5, 0x84, 0x02, 0x7E, 0x2B,
+  0x01, 0x00, 0x03, 0x01, 0x01, 0x03, 0x1D, 0x02, 0xFF, 0x01, 0x00, 0x03,
+  0xFF, 0x03, 0x00, 0x05, 0xFF, 0x07, 0x00, 0x09, 0xFF, 0x0F, 0x00, 0x0F,
+  0xFF, 0x19, 0x00, 0x14, 0xFF, 0x28, 0x00, 0x18, 0xFF, 0x40, 0x00, 0x19,
+  0x2E, 0x00, 0xB4, 0x84, 0x02, 0x7E, 0x2F, 0x01, 0x00, 0x03, 0x21, 0x01,
+  0xFF, 0x00, 0x00, 0x02, 0xFF, 0x02, 0x00, 0x03, 0xFF, 0x04, 0x00, 0x05,
+  0xFF, 0x09, 0x00, 0x09, 0xFF, 0x0F, 0x00, 0x0C, 0xFF, 0x19, 0x00, 0x0F,
+  0xFF, 0x28, 0x00, 0x10, 0xFF, 0x40, 0x00, 0x0C, 0x2A, 0x00, 0xB5, 0x84,
+  0x02, 0x7E, 0x33, 0x01, 0x00, 0x03, 0x1F, 0x01, 0xFF, 0x01, 0x00, 0x02,
+  0xFF, 0x02, 0x00, 0x03, 0xFF, 0x05, 0x00, 0x05, 0xFF, 0x09, 0x00, 0x07,
+  0xFF, 0x0F, 0x00, 0x09, 0xFF, 0x19, 0x00, 0x0A, 0xFF, 0x28, 0x00, 0x08,
+  0xFF, 0x40, 0x28, 0x00, 0xB5, 0x84, 0x02, 0x7E, 0x37, 0x1F, 0x00, 0xFF,
+  0x00, 0x00, 0x01, 0xFF, 0x01, 0x00, 0x02, 0xFF, 0x03, 0x00, 0x03, 0xFF,
+  0x05, 0x00, 0x04, 0xFF, 0x09, 0x00, 0x05, 0xFF, 0x0F, 0x00, 0x06, 0xFF,
+  0x19, 0x00, 0x05, 0xFF, 0x28, 0x03, 0x02, 0x40, 0x0C, 0x23, 0x00, 0xB5,
+  0x84, 0x02, 0x7E, 0x3B, 0x1B, 0x00, 0xFF, 0x00, 0x00, 0x01, 0xFF, 0x02,
+  0x00, 0x02, 0xFF, 0x03, 0x00, 0x02, 0xFF, 0x05, 0x00, 0x03, 0xFF, 0x09,
+  0x00, 0x03, 0xFF, 0x0F, 0x00, 0x03, 0xFF, 0x19, 0x03, 0x06, 0x28, 0x08,
+  0x00, 0xFF, 0x40, 0x19, 0x1F, 0x00, 0xB5, 0x84, 0x02, 0x7E, 0x3F, 0x17,
+  0x00, 0xFF, 0x01, 0x00, 0x01, 0xFF, 0x02, 0x00, 0x01, 0xFF, 0x03, 0x00,
+  0x02, 0xFF, 0x05, 0x00, 0x02, 0xFF, 0x09, 0x00, 0x01, 0xFF, 0x0F, 0x03,
+  0x0A, 0x19, 0x05, 0x00, 0xFF, 0x28, 0x10, 0x00, 0xFF, 0x40, 0x26, 0x1B,
+  0x00, 0xB6, 0x84, 0x02, 0x7E, 0x41, 0x11, 0x00, 0x00, 0x00, 0xFF, 0x01,
+  0x00, 0x00, 0xFF, 0x02, 0x00, 0x01, 0xFF, 0x03, 0x00, 0x01, 0xFF, 0x05,
+  0x03, 0x01, 0x09, 0x03, 0x0E, 0x0F, 0x03, 0x00, 0xFF, 0x19, 0x0A, 0x00,
+  0xFF, 0x28, 0x18, 0x00, 0xFF, 0x40, 0x33, 0x17, 0x00, 0xB8, 0x84, 0x02,
+  0x7E, 0x45, 0x01, 0x00, 0x03, 0x0D, 0x01, 0x00, 0x00, 0xFF, 0x02, 0x00,
+  0x00, 0xFF, 0x03, 0x00, 0x00, 0xFF, 0x05, 0x03, 0x12, 0x09, 0x01, 0x00,
+  0xFF, 0x0F, 0x06, 0x00, 0xFF, 0x19, 0x0F, 0x00, 0xFF, 0x28, 0x20, 0x00,
+  0xFF, 0x40, 0x40, 0x13, 0x00, 0xB2, 0x84, 0x02, 0x7E, 0x49, 0x01, 0x00,
+  0x03, 0x01, 0x01, 0x03, 0x01, 0x02, 0x03, 0x01, 0x03, 0x03, 0x01, 0x05,
+  0x03, 0x12, 0x09, 0x03, 0x00, 0xFF, 0x0F, 0x09, 0x00, 0xFF, 0x19, 0x14,
+  0x00, 0xFF, 0x28, 0x28, 0x00, 0xFF, 0x33, 0x40, 0x0F, 0x00, 0xB8, 0x84,
+  0x02, 0x7E, 0x4D, 0x01, 0x00, 0x03, 0x01, 0x01, 0x03, 0x01, 0x02, 0x03,
+  0x1A, 0x03, 0x00, 0x00, 0xFF, 0x05, 0x02, 0x00, 0xFF, 0x09, 0x05, 0x00,
+  0xFF, 0x0F, 0x0C, 0x00, 0xFF, 0x19, 0x19, 0x00, 0xFF, 0x20, 0x28, 0x00,
+  0xFF, 0x26, 0x40, 0x0B, 0x00, 0xB5, 0x84, 0x02, 0x7E, 0x51, 0x01, 0x00,
+  0x03, 0x01, 0x01, 0x03, 0x01, 0x02, 0x03, 0x1A, 0x03, 0x01, 0x00, 0xFF,
+  0x05, 0x03, 0x00, 0xFF, 0x09, 0x07, 0x00, 0xFF, 0x0F, 0x0F, 0x00, 0xFF,
+  0x14, 0x19, 0x00, 0xFF, 0x18, 0x28, 0x00, 0xFF, 0x19, 0x40, 0x07, 0x00,
+  0xB5, 0x84, 0x02, 0x7E, 0x55, 0x01, 0x00, 0x03, 0x01, 0x01, 0x03, 0x1E,
+  0x02, 0x00, 0x00, 0xFF, 0x03, 0x02, 0x00, 0xFF, 0x05, 0x04, 0x00, 0xFF,
+  0x09, 0x09, 0x00, 0xFF, 0x0C, 0x0F, 0x00, 0xFF, 0x0F, 0x19, 0x00, 0xFF,
+  0x10, 0x28, 0x00, 0xFF, 0x0C, 0x40, 0x03, 0x00, };
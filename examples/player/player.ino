@@ -0,0 +1,35 @@
+// Plays a pre-encoded animation asset with Adafruit_DotStarPlayer, looping
+// forever. The asset (animation.h) was made with the bake example: its
+// frames are already in DotStar wire format, color order and brightness
+// applied, so playing one costs no rendering or encoding, just applying
+// the changes from the previous frame and issuing it over SPI. Playback
+// keeps the timing the animation was baked with. Assets can also be
+// played from a file on an SD card: pass the open File in place of
+// &asset, and seek it back to 0 instead of calling asset.rewind().
+
+#include <Adafruit_DotStarPlayer.h>
+#include <SPI.h>
+
+#include "animation.h"
+
+#define NUMPIXELS 30 // Must match the strip the animation was baked for
+
+// Here's how to control the LEDs from any two pins:
+#define DATAPIN 4
+#define CLOCKPIN 5
+Adafruit_DotStar strip(NUMPIXELS, DATAPIN, CLOCKPIN, DOTSTAR_BRG);
+// Hardware SPI is a little faster, but must be wired to specific pins
+// (Arduino Uno = pin 11 for data, 13 for clock, other boards are different).
+// Adafruit_DotStar strip(NUMPIXELS, DOTSTAR_BRG);
+
+Adafruit_DotStarMemoryStream asset(animation, sizeof(animation));
+Adafruit_DotStarPlayer player(&strip, &asset);
+
+void setup() { strip.begin(); }
+
+void loop() {
+  if (!player.update()) { // Shows each frame when it's due
+    asset.rewind();       // At the end, start over
+    player.reset();
+  }
+}
@@ -0,0 +1,55 @@
+// Keeps a strip within a current budget using the power model and
+// limiter: setPowerModel() describes the strip's current draw, and show()
+// then lowers the brightness of any frame that would go over the budget
+// set with setPowerLimit(). Here a rainbow alternates with full white,
+// which would draw far more than the budget at this length, and the
+// estimate, limited brightness and number of limited frames are printed
+// to the Serial console at 115200 baud.
+
+#include <Adafruit_DotStar.h>
+#include <SPI.h>
+
+#define NUMPIXELS 144 // Number of LEDs in strip
+#define BUDGET 1000   // Current budget in mA, e.g. for a 1A supply
+
+// Here's how to control the LEDs from any two pins:
+#define DATAPIN 4
+#define CLOCKPIN 5
+Adafruit_DotStar strip(NUMPIXELS, DATAPIN, CLOCKPIN, DOTSTAR_BRG);
+// Hardware SPI is a little faster, but must be wired to specific pins
+// (Arduino Uno = pin 11 for data, 13 for clock, other boards are different).
+// Adafruit_DotStar strip(NUMPIXELS, DOTSTAR_BRG);
+
+void setup() {
+  Serial.begin(115200);
+  strip.begin();
+  strip.setBrightness(255);
+  // Typical APA102: about 20 mA per channel at full (78 uA per step of
+  // 255) and 1 mA per pixel when dark. Measure your own strip for best
+  // results; the estimate is only as good as the model.
+  strip.setPowerModel(78, 78, 78, 1000);
+  strip.setPowerLimit(BUDGET);
+}
+
+void loop() {
+  static uint16_t frame = 0;
+
+  if ((frame / 100) & 1)
+    strip.fill(0xFFFFFF); // White, the worst case
+  else
+    strip.rainbow(frame * 256);
+  strip.show();
+
+  if (!(frame % 50)) {
+    Serial.print(F("Estimate "));
+    Serial.print(strip.getPowerEstimate()); // At the brightness setting
+    Serial.print(F(" mA, shown at "));
+    Serial.print(strip.getFramePower()); // After limiting
+    Serial.print(F(" mA, brightness "));
+    Serial.print(strip.getFrameBrightness());
+    Serial.print(F(", frames limited "));
+    Serial.println(strip.getFramesLimited());
+  }
+  frame++;
+  delay(20);
+}
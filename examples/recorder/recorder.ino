@@ -0,0 +1,59 @@
+// Records what show() issues to the strip, frame by frame, using
+// Adafruit_DotStarRecorder, and reports the wire bytes per frame and how
+// compactly they record (only changes between frames are stored) at a
+// few brightness settings. Here the recording is just counted; pass an
+// open File (e.g. from the SD library) in place of byteCounter to save
+// it, then play it back with Adafruit_DotStarReplay to compare wire
+// output across library versions or settings without hardware.
+// Results are printed to the Serial console at 115200 baud. This is an
+// optional demo: record/replay round trips are checked automatically by
+// the host tests in extras/host.
+
+#include <Adafruit_DotStarRecorder.h>
+#include <SPI.h>
+
+#define NUMPIXELS 144 // Number of LEDs in strip
+#define FRAMES 100    // Number of frames to record per setting
+
+// Hardware SPI (MOSI, SCK pins), see strandtest example for soft SPI.
+Adafruit_DotStar strip(NUMPIXELS, DOTSTAR_BRG);
+
+// Output that just counts bytes, standing in for a file.
+class ByteCounter : public Print {
+public:
+  size_t write(uint8_t) { return 1; }
+  size_t write(const uint8_t *, size_t len) { return len; }
+} byteCounter;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10);
+
+  strip.begin();
+
+  Adafruit_DotStarRecorder recorder(&byteCounter, strip.getFrameBytes());
+  static const uint8_t levels[] = {255, 64, 8};
+
+  for (uint8_t i = 0; i < sizeof(levels); i++) {
+    strip.setBrightness(levels[i]);
+    recorder.reset();
+    strip.setOutput(&recorder); // Record only, nothing goes to SPI
+    for (uint16_t f = 0; f < FRAMES; f++) {
+      // Comet chasing along the strip: few pixels change per frame
+      strip.setPixelColor((f + NUMPIXELS - 8) % NUMPIXELS, 0);
+      strip.setPixelColor(f % NUMPIXELS, strip.ColorHSV(f * 600));
+      strip.show();
+    }
+    strip.setOutput(NULL);
+
+    Serial.print(F("Brightness "));
+    Serial.print(levels[i]);
+    Serial.print(F(": wire bytes/frame "));
+    Serial.print(recorder.getBytes() / FRAMES);
+    Serial.print(F(", recorded bytes/frame "));
+    Serial.println(recorder.getRecordedBytes() / FRAMES);
+  }
+}
+
+void loop() {}
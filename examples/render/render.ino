@@ -0,0 +1,98 @@
+// Multi-core rendering benchmark for Adafruit_DotStarRender. For strips of
+// 10,000 to 65,535 pixels, times rainbow(), fade(), a custom kernel passed
+// to run(), and show(), first serially and then with one worker task per
+// additional CPU core, and reports the speedup over serial. On ESP32 (dual
+// core) expect close to 2x for the compute-heavy effects; show() gains by
+// encoding on the other core while this one transmits, so its time tends
+// toward the transmit time alone. Single-core boards only print the serial
+// column. Lengths that don't fit in RAM on this board are skipped. Results
+// are printed to the Serial console at 115200 baud. Nothing needs to be
+// connected to the data/clock pins.
+
+#include <Adafruit_DotStarRender.h>
+#include <SPI.h>
+
+// Hardware SPI (MOSI, SCK pins), see strandtest example for soft SPI.
+Adafruit_DotStar strip(0, DOTSTAR_BRG);
+Adafruit_DotStarRender render(&strip);
+
+// A kernel for run(): each call fills its own tile of the strip, here
+// with two interfering sine waves. It must only touch pixels first
+// through first + count - 1, as other cores are filling the rest.
+void plasma(Adafruit_DotStar *s, uint16_t first, uint16_t count, void *arg) {
+  uint8_t t = *(uint8_t *)arg;
+  for (uint16_t i = first; i < first + count; i++) {
+    uint8_t v = (Adafruit_DotStar::sine8(i + t) +
+                 Adafruit_DotStar::sine8(i * 3 - t * 2)) >> 1;
+    s->setPixelColor(i, Adafruit_DotStar::ColorHSV(v << 8, 255, v));
+  }
+}
+
+// Time 10 frames of each effect, returning the average per frame in uS.
+uint32_t timeEffect(uint8_t effect) {
+  uint32_t t = micros();
+  for (uint8_t frame = 0; frame < 10; frame++) {
+    switch (effect) {
+    case 0:
+      render.rainbow(frame * 256);
+      break;
+    case 1:
+      render.fade(200);
+      break;
+    case 2:
+      render.run(plasma, &frame);
+      break;
+    default:
+      render.show();
+      break;
+    }
+  }
+  return (micros() - t) / 10;
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10);
+
+  strip.begin();
+  render.begin(); // One worker per additional core
+  uint8_t maxWorkers = render.numWorkers();
+  Serial.print(maxWorkers + 1);
+  Serial.println(F(" core(s) in use"));
+
+  static const char *const names[] = {"rainbow()", "fade()", "run(plasma)",
+                                      "show()"};
+  static const uint16_t lengths[] = {10000, 30000, 65535};
+  for (uint8_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+    strip.updateLength(lengths[i]);
+    if (strip.numPixels() != lengths[i]) {
+      Serial.print(F("Not enough RAM for "));
+      Serial.println(lengths[i]);
+      break;
+    }
+    Serial.print(lengths[i]);
+    Serial.println(F(" pixels (uS per frame, speedup):"));
+
+    for (uint8_t effect = 0; effect < 4; effect++) {
+      Serial.print(F("  "));
+      Serial.print(names[effect]);
+      uint32_t serial = 0;
+      for (uint8_t w = 0; w <= maxWorkers; w++) {
+        render.begin(w);
+        uint32_t t = timeEffect(effect);
+        if (!w)
+          serial = t;
+        Serial.print(F("  "));
+        Serial.print(t);
+        Serial.print(F(" ("));
+        Serial.print((float)serial / (t ? t : 1), 2);
+        Serial.print(F("x)"));
+      }
+      Serial.println();
+    }
+  }
+  strip.updateLength(0);
+}
+
+void loop() {}
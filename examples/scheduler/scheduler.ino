@@ -0,0 +1,55 @@
+// Paces a rainbow animation at a fixed frame rate with
+// Adafruit_DotStarScheduler instead of delay(), and prints frame timing
+// statistics to the Serial console (115200 baud) every few seconds.
+// Try changing NUMPIXELS, FPS or the SPI clock and watch the effect on
+// show() time and dropped frames.
+
+#include <Adafruit_DotStarScheduler.h>
+#include <SPI.h>
+
+#define NUMPIXELS 144 // Number of LEDs in strip
+#define FPS 100       // Target frame rate
+
+// Hardware SPI (MOSI, SCK pins), see strandtest example for soft SPI.
+Adafruit_DotStar strip(NUMPIXELS, DOTSTAR_BRG);
+
+// Called once per frame; frame advances by exactly FPS per second, so
+// the rainbow cycles at the same speed however long each frame takes.
+void render(Adafruit_DotStar *s, uint32_t frame) {
+  s->rainbow(frame * 256);
+}
+
+Adafruit_DotStarScheduler scheduler(&strip, FPS, render);
+
+void setup() {
+  Serial.begin(115200);
+  strip.begin();
+  strip.setBrightness(32);
+}
+
+uint32_t lastReport = 0;
+
+void loop() {
+  scheduler.run(); // Returns immediately if next frame isn't due
+
+  if ((millis() - lastReport) >= 5000) {
+    lastReport = millis();
+    Serial.print(F("FPS: "));
+    Serial.print(scheduler.getActualFPS());
+    Serial.print(F("  render (uS): "));
+    Serial.print(scheduler.getRenderTime());
+    Serial.print(F(" avg, "));
+    Serial.print(scheduler.getRenderTimeMax());
+    Serial.print(F(" max  show() (uS): "));
+    Serial.print(scheduler.getShowTime());
+    Serial.print(F(" avg, "));
+    Serial.print(scheduler.getShowTimeMax());
+    Serial.print(F(" max  bytes: "));
+    Serial.print(scheduler.getBytesSent());
+    Serial.print(F("  dropped: "));
+    Serial.print(scheduler.getFramesDropped());
+    Serial.print(F("/"));
+    Serial.println(scheduler.getFramesShown() + scheduler.getFramesDropped());
+    scheduler.resetStats();
+  }
+}
@@ -0,0 +1,35 @@
+// Generates pixels on the fly as they're issued to the strip, instead of
+// storing them in RAM first. The strip object is created with length 0,
+// so there's no pixel buffer at all: a strip of any length (up to 65535)
+// costs the same small amount of RAM, and data starts going out as soon
+// as show() is called. Useful for POV, or strips too long to buffer.
+
+#include <Adafruit_DotStar.h>
+#include <SPI.h>
+
+#define NUMPIXELS 2000 // Number of LEDs in strip
+
+// Hardware SPI (MOSI, SCK pins), see strandtest example for soft SPI.
+Adafruit_DotStar strip(0, DOTSTAR_BRG); // No pixel buffer
+
+uint16_t hue = 0;
+
+// Called by show() for each chunk of pixels: fill in 'count' colors
+// starting at pixel 'first'.
+void rainbowSource(Adafruit_DotStar *s, uint16_t first, uint32_t *colors,
+                   uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) {
+    uint16_t pixelHue = hue + (uint32_t)(first + i) * 65536 / NUMPIXELS;
+    colors[i] = s->gamma32(s->ColorHSV(pixelHue));
+  }
+}
+
+void setup() {
+  strip.begin();
+  strip.setBrightness(32);
+}
+
+void loop() {
+  strip.show(rainbowSource, NUMPIXELS);
+  hue += 256;
+}
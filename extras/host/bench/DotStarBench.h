@@ -0,0 +1,65 @@
+/*!
+ * @file DotStarBench.h
+ *
+ * Minimal benchmark helpers for the Adafruit_DotStar host build. Results
+ * are printed one per line as "name: value unit", for diffing between
+ * library versions. Run under perf, valgrind etc. for more detail.
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _DOTSTAR_BENCH_H_
+#define _DOTSTAR_BENCH_H_
+
+#include "DotStarHost.h"
+
+#include <chrono>
+#include <stdio.h>
+
+/*!
+  @brief   Time a function: call it repeatedly for at least 200 ms (after
+           one warm-up call) and return the average per item.
+  @param   fn     Function to time; called with no arguments.
+  @param   items  Items (pixels, bytes...) processed per call.
+  @return  Nanoseconds per item.
+*/
+template <typename F> double benchNs(F fn, double items) {
+  typedef std::chrono::steady_clock clock;
+  fn();
+  uint32_t calls = 0;
+  clock::time_point start = clock::now(), now;
+  do {
+    fn();
+    calls++;
+    now = clock::now();
+  } while (now - start < std::chrono::milliseconds(200));
+  double ns = std::chrono::duration<double, std::nano>(now - start).count();
+  return ns / calls / items;
+}
+
+/*!
+  @brief   Print a result line.
+  @param   name   Benchmark name.
+  @param   value  Result.
+  @param   unit   Unit of result.
+*/
+static inline void benchReport(const char *name, double value,
+                               const char *unit) {
+  printf("%-40s %12.3f %s\n", name, value, unit);
+}
+
+#endif // _DOTSTAR_BENCH_H_
@@ -0,0 +1,65 @@
+// Cost of temporal dithering: encode time per pixel with and without
+// setDithering(), at a brightness where it applies. Output goes to a
+// discarding Print, so this is the encoder alone. On x86, also reported
+// in timestamp-counter ticks (roughly CPU cycles) per pixel.
+// Usage: bench_dither [pixels]
+
+#include "DotStarBench.h"
+
+#include <Adafruit_DotStar.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Output that discards everything
+class NullOutput : public Print {
+public:
+  size_t write(uint8_t) { return 1; }
+  size_t write(const uint8_t *, size_t len) { return len; }
+};
+
+// Timestamp-counter ticks per nanosecond, or 0 if not available
+static double ticksPerNs(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  typedef std::chrono::steady_clock clock;
+  clock::time_point start = clock::now();
+  uint64_t t = __rdtsc();
+  delay(100);
+  t = __rdtsc() - t;
+  return t / std::chrono::duration<double, std::nano>(clock::now() - start)
+                 .count();
+#else
+  return 0;
+#endif
+}
+
+static void report(const char *name, double ns, double tpn) {
+  benchReport(name, ns, "ns");
+  if (tpn) {
+    char label[80];
+    snprintf(label, sizeof(label), "%s, ticks", name);
+    benchReport(label, ns * tpn, "ticks");
+  }
+}
+
+int main(int argc, char **argv) {
+  uint16_t n = (argc > 1) ? atoi(argv[1]) : 1000;
+  NullOutput null;
+  double tpn = ticksPerNs();
+
+  Adafruit_DotStar strip(n, DOTSTAR_BGR);
+  strip.begin();
+  strip.rainbow();
+  strip.setOutput(&null);
+  strip.setBrightness(100);
+  printf("%u pixels, per pixel:\n", n);
+
+  report("show", benchNs([&] { strip.show(); }, n), tpn);
+  strip.setDithering(true);
+  report("show, dithered", benchNs([&] { strip.show(); }, n), tpn);
+  strip.setPixelBrightness(0, 31);
+  report("show, dithered, pixel brightness",
+         benchNs([&] { strip.show(); }, n), tpn);
+  return 0;
+}
@@ -0,0 +1,119 @@
+// Time per pixel of the library's hot paths: show() (chunked and with a
+// whole-frame buffer), setPixelColor(), fill(), ColorHSV(), rainbow(), and
+// the fade(), blend(), add() and blur() kernels, each against the same
+// effect done per pixel with getPixelColor() and setPixelColor(). Output
+// goes to the mock SPI device with data discarded, so this is the CPU cost
+// alone. Usage: bench_hotpaths [pixels]
+
+#include "DotStarBench.h"
+
+#include <Adafruit_DotStar.h>
+
+// The effects as a sketch would write them, one component at a time
+static uint32_t scalePixel(uint32_t c, uint16_t s) {
+  return ((((c >> 16) & 0xFF) * s >> 8) << 16) |
+         ((((c >> 8) & 0xFF) * s >> 8) << 8) | ((c & 0xFF) * s >> 8);
+}
+
+static uint32_t blendPixel(uint32_t a, uint32_t b, uint16_t w) {
+  return scalePixel(a, 256 - w) + scalePixel(b, w);
+}
+
+static uint32_t addPixel(uint32_t a, uint32_t b) {
+  uint32_t out = 0;
+  for (int s = 0; s < 24; s += 8) {
+    uint32_t x = ((a >> s) & 0xFF) + ((b >> s) & 0xFF);
+    out |= ((x > 255) ? 255 : x) << s;
+  }
+  return out;
+}
+
+static void fadePixels(Adafruit_DotStar &strip, uint8_t scale) {
+  for (uint16_t i = 0; i < strip.numPixels(); i++)
+    strip.setPixelColor(i, scalePixel(strip.getPixelColor(i), scale + 1));
+}
+
+static void blendPixels(Adafruit_DotStar &out, const Adafruit_DotStar &a,
+                        const Adafruit_DotStar &b, uint8_t amount) {
+  for (uint16_t i = 0; i < out.numPixels(); i++)
+    out.setPixelColor(i, blendPixel(a.getPixelColor(i), b.getPixelColor(i),
+                                    amount + (amount >> 7)));
+}
+
+static void addPixels(Adafruit_DotStar &out, const Adafruit_DotStar &src) {
+  for (uint16_t i = 0; i < out.numPixels(); i++)
+    out.setPixelColor(i, addPixel(out.getPixelColor(i), src.getPixelColor(i)));
+}
+
+static void blurPixels(Adafruit_DotStar &strip) { // 1-2-1, amount 255
+  uint16_t n = strip.numPixels();
+  uint32_t prev = strip.getPixelColor(0), cur = prev, next;
+  for (uint16_t i = 0; i < n; i++, prev = cur, cur = next) {
+    next = (i + 1 < n) ? strip.getPixelColor(i + 1) : cur;
+    uint32_t out = 0;
+    for (int s = 0; s < 24; s += 8)
+      out |= ((((prev >> s) & 0xFF) + 2 * ((cur >> s) & 0xFF) +
+               ((next >> s) & 0xFF)) >>
+              2)
+             << s;
+    strip.setPixelColor(i, out);
+  }
+}
+
+int main(int argc, char **argv) {
+  uint16_t n = (argc > 1) ? atoi(argv[1]) : 1000;
+  hostSPIMock().keepData(false);
+
+  Adafruit_DotStar strip(n, DOTSTAR_BGR);
+  strip.begin();
+  strip.rainbow();
+  printf("%u pixels, ns per pixel:\n", n);
+
+  benchReport("show", benchNs([&] { strip.show(); }, n), "ns");
+  strip.setBrightness(100);
+  benchReport("show, brightness 100", benchNs([&] { strip.show(); }, n),
+              "ns");
+  strip.setFrameBuffer(true);
+  benchReport("show, frame buffer", benchNs([&] { strip.show(); }, n), "ns");
+  strip.setFrameBuffer(false);
+  strip.setGammaCorrection(true);
+  benchReport("show, gamma", benchNs([&] { strip.show(); }, n), "ns");
+  strip.setGammaCorrection(false);
+
+  benchReport("setPixelColor",
+              benchNs(
+                  [&] {
+                    for (uint16_t i = 0; i < n; i++)
+                      strip.setPixelColor(i, i * 0x010203);
+                  },
+                  n),
+              "ns");
+  benchReport("fill", benchNs([&] { strip.fill(0x123456); }, n), "ns");
+  volatile uint32_t sink = 0;
+  benchReport("ColorHSV",
+              benchNs(
+                  [&] {
+                    for (uint16_t i = 0; i < n; i++)
+                      sink = sink + Adafruit_DotStar::ColorHSV(i * 65);
+                  },
+                  n),
+              "ns");
+  benchReport("rainbow", benchNs([&] { strip.rainbow(); }, n), "ns");
+
+  Adafruit_DotStar other(n, DOTSTAR_BGR), out(n, DOTSTAR_BGR);
+  other.rainbow(32768);
+  benchReport("fade", benchNs([&] { strip.fade(250); }, n), "ns");
+  benchReport("fade, per pixel", benchNs([&] { fadePixels(strip, 250); }, n),
+              "ns");
+  benchReport("blend", benchNs([&] { out.blend(strip, other, 100); }, n),
+              "ns");
+  benchReport("blend, per pixel",
+              benchNs([&] { blendPixels(out, strip, other, 100); }, n), "ns");
+  benchReport("add", benchNs([&] { out.add(other); }, n), "ns");
+  benchReport("add, per pixel", benchNs([&] { addPixels(out, other); }, n),
+              "ns");
+  benchReport("blur", benchNs([&] { strip.blur(255); }, n), "ns");
+  benchReport("blur, per pixel", benchNs([&] { blurPixels(strip); }, n),
+              "ns");
+  return 0;
+}
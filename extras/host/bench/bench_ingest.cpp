@@ -0,0 +1,119 @@
+// Adafruit_DotStarIngest throughput on a large capture (200 frames of
+// 1000 pixels, raw and Adalight): ns per byte streamed from memory, from
+// a file (HostFileStream) and over loopback UDP (HostUDPStream, sent in
+// 1400-byte datagrams as it's read). Frames land in the strip but aren't
+// shown, so this is the cost of the stream and parsing alone.
+// Usage: bench_ingest
+
+#include "DotStarBench.h"
+
+#include <Adafruit_DotStarIngest.h>
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Stream over a capture in memory
+class MemStream : public Stream {
+public:
+  MemStream(const std::vector<uint8_t> &d) : data(d) {}
+  int available(void) { return data.size() - pos; }
+  int read(void) { return (pos < data.size()) ? data[pos++] : -1; }
+  int peek(void) { return (pos < data.size()) ? data[pos] : -1; }
+  size_t write(uint8_t) { return 0; }
+  const std::vector<uint8_t> &data;
+  size_t pos = 0;
+};
+
+static const uint16_t PIXELS = 1000;
+static const uint32_t FRAMES = 200;
+
+// Read a whole capture, checking every frame arrived. If tx is given, the
+// capture is sent to it a datagram at a time, reading what's arrived after
+// each (so the socket buffer never overflows).
+static void ingestAll(Adafruit_DotStar &strip, Stream &in, uint8_t format,
+                      const std::vector<uint8_t> *send = NULL, int tx = -1,
+                      const struct sockaddr_in *to = NULL) {
+  in.setTimeout(0);
+  Adafruit_DotStarIngest ingest(&strip, &in, format);
+  ingest.setAutoShow(false);
+  for (size_t i = 0; send && (i < send->size()); i += 1400) {
+    sendto(tx, &(*send)[i], std::min((size_t)1400, send->size() - i), 0,
+           (const struct sockaddr *)to, sizeof(*to));
+    while (ingest.run())
+      ;
+  }
+  while (ingest.run() || in.available())
+    ;
+  if (ingest.getFrames() != FRAMES)
+    printf("Only %u of %u frames\n", ingest.getFrames(), FRAMES);
+}
+
+int main(void) {
+  std::vector<uint8_t> raw, ada;
+  uint32_t x = 1;
+  for (uint32_t f = 0; f < FRAMES; f++) {
+    uint8_t hi = (PIXELS - 1) >> 8, lo = (PIXELS - 1) & 0xFF;
+    ada.insert(ada.end(), {'A', 'd', 'a', hi, lo, (uint8_t)(hi ^ lo ^ 0x55)});
+    for (uint32_t i = 0; i < PIXELS * 3; i++) {
+      x = x * 1664525 + 1013904223; // Arbitrary pixel data
+      raw.push_back(x >> 24);
+      ada.push_back(x >> 24);
+    }
+  }
+
+  Adafruit_DotStar strip(PIXELS, DOTSTAR_BGR);
+  strip.begin();
+  char path[] = "/tmp/bench_ingest_XXXXXX";
+  int fd = mkstemp(path);
+  HostUDPStream udp(0);
+  int tx = socket(AF_INET, SOCK_DGRAM, 0);
+  struct sockaddr_in to = {};
+  to.sin_family = AF_INET;
+  to.sin_port = htons(udp.getPort());
+  inet_pton(AF_INET, "127.0.0.1", &to.sin_addr);
+  char label[80];
+
+  for (uint8_t format : {DOTSTAR_INGEST_RAW, DOTSTAR_INGEST_ADALIGHT}) {
+    const std::vector<uint8_t> &data =
+        (format == DOTSTAR_INGEST_RAW) ? raw : ada;
+    const char *name = (format == DOTSTAR_INGEST_RAW) ? "raw" : "Adalight";
+    printf("%s, %u bytes, ns per byte:\n", name, (uint32_t)data.size());
+
+    snprintf(label, sizeof(label), "%s, memory", name);
+    benchReport(label, benchNs(
+                           [&] {
+                             MemStream in(data);
+                             ingestAll(strip, in, format);
+                           },
+                           data.size()),
+                "ns");
+
+    if ((ftruncate(fd, 0) == 0) &&
+        (pwrite(fd, data.data(), data.size(), 0) == (ssize_t)data.size())) {
+      snprintf(label, sizeof(label), "%s, file", name);
+      benchReport(label, benchNs(
+                             [&] {
+                               HostFileStream in(path);
+                               ingestAll(strip, in, format);
+                             },
+                             data.size()),
+                  "ns");
+    }
+
+    if (!udp.failed() && (tx >= 0)) {
+      snprintf(label, sizeof(label), "%s, UDP", name);
+      benchReport(
+          label,
+          benchNs([&] { ingestAll(strip, udp, format, &data, tx, &to); },
+                  data.size()),
+          "ns");
+    }
+  }
+  close(tx);
+  close(fd);
+  unlink(path);
+  return 0;
+}
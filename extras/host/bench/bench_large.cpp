@@ -0,0 +1,39 @@
+// Scaling of Adafruit_DotStarLarge with strip length, up to a million
+// pixels: time per pixel for fill(), a setPixelColor() loop and show()
+// (output discarded, so the CPU cost alone). Per-pixel times should stay
+// flat as length grows. Usage: bench_large
+
+#include "DotStarBench.h"
+
+#include <Adafruit_DotStarLarge.h>
+
+int main(void) {
+  hostSPIMock().keepData(false);
+  Adafruit_DotStarLarge strip(0, DOTSTAR_BGR);
+  strip.begin();
+  char label[80];
+
+  for (uint32_t n : {10000u, 100000u, 1000000u}) {
+    strip.updateLength(n);
+    if (strip.numPixels() != n) {
+      printf("Not enough RAM for %u pixels\n", n);
+      break;
+    }
+    printf("%u pixels, %u segments, ns per pixel:\n", n,
+           strip.numSegments());
+    snprintf(label, sizeof(label), "fill, %u", n);
+    benchReport(label, benchNs([&] { strip.fill(0x102030); }, n), "ns");
+    snprintf(label, sizeof(label), "setPixelColor, %u", n);
+    benchReport(label,
+                benchNs(
+                    [&] {
+                      for (uint32_t i = 0; i < n; i++)
+                        strip.setPixelColor(i, i * 0x010203);
+                    },
+                    n),
+                "ns");
+    snprintf(label, sizeof(label), "show, %u", n);
+    benchReport(label, benchNs([&] { strip.show(); }, n), "ns");
+  }
+  return 0;
+}
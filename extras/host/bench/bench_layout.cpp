@@ -0,0 +1,48 @@
+// Adafruit_DotStarLayout on a 64x64 serpentine matrix (4096 pixels):
+// ns per pixel to blit a full-frame image with drawImage(), to fill it
+// with fillRect(), and per drawPixel(), against the usual sketch loop of
+// setPixelColor() with the serpentine index worked out per pixel.
+// Usage: bench_layout
+
+#include "DotStarBench.h"
+
+#include <Adafruit_DotStarLayout.h>
+
+static const uint16_t SIZE = 64, N = SIZE * SIZE;
+static uint32_t image[N];
+
+static void drawPixels(Adafruit_DotStarLayout &layout) {
+  for (int16_t y = 0; y < SIZE; y++)
+    for (int16_t x = 0; x < SIZE; x++)
+      layout.drawPixel(x, y, image[y * SIZE + x]);
+}
+
+// Serpentine rows, mapped by hand
+static void setPixelsXY(Adafruit_DotStar &strip) {
+  for (uint16_t y = 0; y < SIZE; y++)
+    for (uint16_t x = 0; x < SIZE; x++)
+      strip.setPixelColor(y * SIZE + ((y & 1) ? SIZE - 1 - x : x),
+                          image[y * SIZE + x]);
+}
+
+int main(void) {
+  Adafruit_DotStar strip(N, DOTSTAR_BGR);
+  strip.begin();
+  Adafruit_DotStarLayout layout(&strip);
+  layout.setMatrix(SIZE, SIZE, DOTSTAR_LAYOUT_ZIGZAG);
+  for (uint32_t i = 0; i < N; i++)
+    image[i] = i * 0x010203;
+
+  benchReport("drawImage 64x64",
+              benchNs([&] { layout.drawImage(0, 0, SIZE, SIZE, image); }, N),
+              "ns");
+  benchReport("fillRect 64x64",
+              benchNs([&] { layout.fillRect(0, 0, SIZE, SIZE, 0x102030); },
+                      N),
+              "ns");
+  benchReport("drawPixel 64x64", benchNs([&] { drawPixels(layout); }, N),
+              "ns");
+  benchReport("setPixelColor XY 64x64",
+              benchNs([&] { setPixelsXY(strip); }, N), "ns");
+  return 0;
+}
@@ -0,0 +1,57 @@
+// Adafruit_DotStarRender on the ESP32 library variant (workers on host
+// threads), with 0 to DOTSTAR_RENDER_WORKERS workers: ns per pixel for
+// run() with a light per-pixel kernel, rainbow(), and show() both chunked
+// (encoding pipelined with issuing) and with a whole-frame buffer, on
+// strips of 10,000 pixels up to the 65,535 limit. Output goes to the mock
+// SPI device with data discarded, so this is the CPU cost alone: run()
+// and rainbow() only gain with as many free cores as workers, and as the
+// mock issues each chunk instantly, chunked show() with workers measures
+// the hand-off per DOTSTAR_RENDER_CHUNK pixels rather than the overlap it
+// buys on hardware, where a chunk's transfer takes far longer.
+// Usage: bench_render [pixels...]
+
+#include "DotStarBench.h"
+
+#include <Adafruit_DotStarRender.h>
+
+static void pixelKernel(Adafruit_DotStar *s, uint16_t first, uint16_t count,
+                        void *arg) {
+  uint32_t seed = *(uint32_t *)arg;
+  for (uint16_t i = first; i < first + count; i++)
+    s->setPixelColor(i, ((i + seed) * 2654435761u) >> 8);
+}
+
+int main(int argc, char **argv) {
+  std::vector<uint16_t> sizes;
+  for (int i = 1; i < argc; i++)
+    sizes.push_back(atoi(argv[i]));
+  if (sizes.empty())
+    sizes = {10000, 30000, 65535};
+  hostSPIMock().keepData(false);
+  char label[80];
+
+  for (uint16_t n : sizes) {
+    printf("%u pixels, %u per chunk, ns per pixel:\n", n,
+           DOTSTAR_RENDER_CHUNK);
+    Adafruit_DotStar strip(n, DOTSTAR_BGR);
+    strip.begin();
+    Adafruit_DotStarRender render(&strip);
+    for (uint8_t w = 0; w <= DOTSTAR_RENDER_WORKERS; w++) {
+      render.begin(w);
+      uint32_t seed = 0;
+      snprintf(label, sizeof(label), "run, %u workers", w);
+      benchReport(label, benchNs([&] { render.run(pixelKernel, &seed); }, n),
+                  "ns");
+      snprintf(label, sizeof(label), "rainbow, %u workers", w);
+      benchReport(label, benchNs([&] { render.rainbow(seed += 100); }, n),
+                  "ns");
+      snprintf(label, sizeof(label), "show, %u workers", w);
+      benchReport(label, benchNs([&] { render.show(); }, n), "ns");
+      strip.setFrameBuffer(true);
+      snprintf(label, sizeof(label), "show, frame buffer, %u workers", w);
+      benchReport(label, benchNs([&] { render.show(); }, n), "ns");
+      strip.setFrameBuffer(false);
+    }
+  }
+  return 0;
+}
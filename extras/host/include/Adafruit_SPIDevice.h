@@ -0,0 +1,126 @@
+/*!
+ * @file Adafruit_SPIDevice.h
+ *
+ * Host stand-in for Adafruit BusIO's SPI device. Hardware SPI goes to the
+ * SPIClass's backend (see SPI.h and DotStarHost.h); soft SPI is bitbanged
+ * on the mock GPIO with digitalWrite(), as BusIO does. Building with
+ * DOTSTAR_HOST_FAST_PINIO also defines BUSIO_USE_FAST_PINIO and the port
+ * register types, backed by the same mock GPIO.
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _DOTSTAR_HOST_SPIDEVICE_H_
+#define _DOTSTAR_HOST_SPIDEVICE_H_
+
+#include "Arduino.h"
+#include "SPI.h"
+
+/*!
+  @brief  Bit order, as in BusIO.
+*/
+typedef enum _BitOrder {
+  SPI_BITORDER_MSBFIRST = 1, ///< Most significant bit first
+  SPI_BITORDER_LSBFIRST = 0, ///< Least significant bit first
+} BusIOBitOrder;
+
+#define SPI_MODE0 0 ///< CPOL 0, CPHA 0
+
+uint32_t hostPortRead(uint8_t port);
+void hostPortWrite(uint8_t port, uint32_t value);
+
+#ifdef DOTSTAR_HOST_FAST_PINIO
+#define BUSIO_USE_FAST_PINIO
+
+typedef uint32_t BusIO_PortMask; ///< Pin mask within a port
+
+/*!
+  @brief  A mock GPIO port output register: 32 pins, pin p being bit
+          p % 32 of port p / 32. Reads and writes go to the mock GPIO.
+*/
+class HostPortReg {
+public:
+  /*!
+    @brief   Read the port's output state.
+    @return  Pin states, one per bit.
+  */
+  operator uint32_t() const volatile { return hostPortRead(port); }
+  /*!
+    @brief   Write the port's output state; all changed pins change at
+             once.
+    @param   v  Pin states, one per bit.
+  */
+  void operator=(uint32_t v) volatile { hostPortWrite(port, v); }
+  /*!
+    @brief   Set pins (read-modify-write).
+    @param   m  Pins to set.
+  */
+  void operator|=(uint32_t m) volatile {
+    hostPortWrite(port, hostPortRead(port) | m);
+  }
+  /*!
+    @brief   Clear pins (read-modify-write).
+    @param   m  Pins to keep.
+  */
+  void operator&=(uint32_t m) volatile {
+    hostPortWrite(port, hostPortRead(port) & m);
+  }
+
+  uint8_t port; ///< Port number
+};
+
+typedef volatile HostPortReg BusIO_PortReg; ///< Port output register
+
+volatile HostPortReg *hostPortRegister(uint8_t port);
+
+#define digitalPinToPort(p) ((p) / 32)
+#define digitalPinToBitMask(p) (1UL << ((p) % 32))
+#define portOutputRegister(port) (hostPortRegister(port))
+#endif // DOTSTAR_HOST_FAST_PINIO
+
+/*!
+  @brief  SPI device, as in BusIO: a hardware bus or two soft SPI pins.
+*/
+class Adafruit_SPIDevice {
+public:
+  Adafruit_SPIDevice(int8_t cspin, uint32_t freq = 1000000,
+                     BusIOBitOrder dataOrder = SPI_BITORDER_MSBFIRST,
+                     uint8_t dataMode = SPI_MODE0, SPIClass *theSPI = &SPI);
+  Adafruit_SPIDevice(int8_t cspin, int8_t sck, int8_t miso, int8_t mosi,
+                     uint32_t freq = 1000000,
+                     BusIOBitOrder dataOrder = SPI_BITORDER_MSBFIRST,
+                     uint8_t dataMode = SPI_MODE0);
+
+  bool begin(void);
+  void beginTransaction(void);
+  void endTransaction(void);
+  uint8_t transfer(uint8_t send);
+  void transfer(uint8_t *buffer, size_t len);
+  bool write(const uint8_t *buffer, size_t len,
+             const uint8_t *prefix_buffer = NULL, size_t prefix_len = 0);
+
+private:
+  void softTransfer(uint8_t *buffer, size_t len);
+
+  SPIClass *spi; ///< Hardware bus, NULL if soft SPI
+  uint32_t freq; ///< Clock rate, Hz
+  uint8_t mode;  ///< SPI mode
+  int8_t sck;    ///< Soft SPI clock pin
+  int8_t mosi;   ///< Soft SPI data pin
+};
+
+#endif // _DOTSTAR_HOST_SPIDEVICE_H_
@@ -0,0 +1,206 @@
+/*!
+ * @file Arduino.h
+ *
+ * Minimal stand-in for the Arduino core, enough to build the
+ * Adafruit_DotStar library natively on Linux (or any POSIX host) for
+ * tests, benchmarks and driving strips through spidev. Pin I/O goes to
+ * the mock GPIO in DotStarHost.h. Not part of the Arduino library itself.
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _DOTSTAR_HOST_ARDUINO_H_
+#define _DOTSTAR_HOST_ARDUINO_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef bool boolean; ///< Arduino's name for bool
+typedef uint8_t byte; ///< Arduino's name for uint8_t
+
+// Flash and RAM share an address space here
+#define PROGMEM
+#define F(s) (s)
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+#define pgm_read_dword(p) (*(const uint32_t *)(p))
+#define pgm_read_ptr(p) (*(void *const *)(p))
+#define memcpy_P memcpy
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+
+#define DEC 10
+#define HEX 16
+
+uint32_t micros(void);
+uint32_t millis(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield(void);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void noInterrupts(void);
+void interrupts(void);
+
+/*!
+  @brief  Byte sink, as in the Arduino core. print() and println() cover
+          the types the library's examples and tools use.
+*/
+class Print {
+public:
+  virtual ~Print() {}
+  /*!
+    @brief   Write one byte.
+    @return  Number of bytes written.
+  */
+  virtual size_t write(uint8_t) = 0;
+  virtual size_t write(const uint8_t *buf, size_t len);
+  /*!
+    @brief   Write a NUL-terminated string.
+    @param   s  String.
+    @return  Number of bytes written.
+  */
+  size_t write(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+  /*!
+    @brief   Finish any buffered output; called per frame by the library.
+  */
+  virtual void flush(void) {}
+
+  size_t print(const char *s);
+  size_t print(char c);
+  size_t print(unsigned long n, int base = DEC);
+  size_t print(long n, int base = DEC);
+  /*!
+    @brief   Print an unsigned number.
+    @param   n     Value.
+    @param   base  Radix, DEC or HEX.
+    @return  Number of bytes written.
+  */
+  size_t print(unsigned int n, int base = DEC) {
+    return print((unsigned long)n, base);
+  }
+  /*!
+    @brief   Print a signed number.
+    @param   n     Value.
+    @param   base  Radix, DEC or HEX.
+    @return  Number of bytes written.
+  */
+  size_t print(int n, int base = DEC) { return print((long)n, base); }
+  /*!
+    @brief   Print a byte as a number.
+    @param   n     Value.
+    @param   base  Radix, DEC or HEX.
+    @return  Number of bytes written.
+  */
+  size_t print(uint8_t n, int base = DEC) {
+    return print((unsigned long)n, base);
+  }
+  size_t print(double n, int digits = 2);
+  size_t println(void);
+  /*!
+    @brief   print() followed by a newline.
+    @param   v  Value to print.
+    @return  Number of bytes written.
+  */
+  template <typename T> size_t println(T v) { return print(v) + println(); }
+  /*!
+    @brief   print() with a radix or precision, followed by a newline.
+    @param   v  Value to print.
+    @param   b  Radix or digits, as for print().
+    @return  Number of bytes written.
+  */
+  template <typename T> size_t println(T v, int b) {
+    return print(v, b) + println();
+  }
+};
+
+/*!
+  @brief  Byte source, as in the Arduino core. As on AVR cores, readBytes()
+          is NOT virtual: it reads through read() one byte at a time, so
+          subclasses' own readBytes() is only used when called through the
+          subclass type.
+*/
+class Stream : public Print {
+public:
+  /*!
+    @brief   Get the number of bytes ready to read.
+    @return  Byte count.
+  */
+  virtual int available(void) = 0;
+  /*!
+    @brief   Read one byte.
+    @return  Byte value, or -1 if none available.
+  */
+  virtual int read(void) = 0;
+  /*!
+    @brief   Get the next byte without consuming it.
+    @return  Byte value, or -1 if none available.
+  */
+  virtual int peek(void) = 0;
+  /*!
+    @brief   Set the time readBytes() etc. wait for data. There's no
+             waiting here, data that's not available ends the read.
+    @param   ms  Timeout in milliseconds (ignored).
+  */
+  void setTimeout(unsigned long ms) { (void)ms; }
+  size_t readBytes(char *buf, size_t len);
+  /*!
+    @brief   Read bytes through read().
+    @param   buf  Destination.
+    @param   len  Maximum number of bytes.
+    @return  Number of bytes read.
+  */
+  size_t readBytes(uint8_t *buf, size_t len) {
+    return readBytes((char *)buf, len);
+  }
+  long parseInt(void);
+};
+
+/*!
+  @brief  Serial console, writing to stdout.
+*/
+class HardwareSerial : public Stream {
+public:
+  /*!
+    @brief   Open the port (no-op).
+    @param   baud  Ignored.
+  */
+  void begin(unsigned long baud) { (void)baud; }
+  /*!
+    @brief   Check that the port is open.
+    @return  true, always.
+  */
+  operator bool() const { return true; }
+  size_t write(uint8_t b);
+  size_t write(const uint8_t *buf, size_t len);
+  using Print::write;
+  void flush(void);
+  int available(void);
+  int read(void);
+  int peek(void);
+};
+
+extern HardwareSerial Serial; ///< stdout
+
+#endif // _DOTSTAR_HOST_ARDUINO_H_
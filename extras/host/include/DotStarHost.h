@@ -0,0 +1,352 @@
+/*!
+ * @file DotStarHost.h
+ *
+ * Host-side devices for the Adafruit_DotStar native build: SPI backends
+ * that hardware-SPI strips issue data to (an in-memory mock for tests and
+ * benchmarks, and Linux spidev for driving real strips from a single-board
+ * computer), and the mock GPIO that soft SPI strips toggle.
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _DOTSTAR_HOST_H_
+#define _DOTSTAR_HOST_H_
+
+#include "Adafruit_SPIDevice.h"
+
+#include <vector>
+
+/*!
+  @brief  Where a hardware SPI bus's data goes. Adafruit_SPIDevice calls
+          beginTransaction(), any number of transfer()s, then
+          endTransaction().
+*/
+class HostSPIBackend {
+public:
+  virtual ~HostSPIBackend() {}
+  /*!
+    @brief   Prepare the device, called by Adafruit_SPIDevice::begin().
+    @return  true on success.
+  */
+  virtual bool begin(void) { return true; }
+  /*!
+    @brief   Start a transaction.
+    @param   freq  Clock rate, Hz.
+    @param   mode  SPI mode.
+  */
+  virtual void beginTransaction(uint32_t freq, uint8_t mode) {
+    (void)freq;
+    (void)mode;
+  }
+  /*!
+    @brief   End a transaction.
+  */
+  virtual void endTransaction(void) {}
+  /*!
+    @brief   Issue data.
+    @param   buf  Data.
+    @param   len  Length in bytes.
+  */
+  virtual void transfer(const uint8_t *buf, size_t len) = 0;
+};
+
+/*!
+  @brief  In-memory SPI device: keeps every byte issued, and counts calls,
+          so wire output can be checked byte-for-byte and measured. The
+          default SPI bus starts out with one of these, see hostSPIMock().
+*/
+class HostSPIMock : public HostSPIBackend {
+public:
+  void beginTransaction(uint32_t freq, uint8_t mode);
+  void endTransaction(void);
+  void transfer(const uint8_t *buf, size_t len);
+  void clear(void);
+  /*!
+    @brief   Get everything issued since construction or clear().
+    @return  Bytes, in order.
+  */
+  const std::vector<uint8_t> &getData(void) const { return data; }
+  /*!
+    @brief   Get the number of transfer() calls.
+    @return  Count since construction or clear().
+  */
+  uint32_t getTransfers(void) const { return transfers; }
+  /*!
+    @brief   Get the number of beginTransaction() calls.
+    @return  Count since construction or clear().
+  */
+  uint32_t getTransactions(void) const { return transactions; }
+  /*!
+    @brief   Get the length of the largest single transfer().
+    @return  Bytes.
+  */
+  size_t getLargestTransfer(void) const { return largest; }
+  /*!
+    @brief   Get the clock rate of the most recent transaction.
+    @return  Hz.
+  */
+  uint32_t getClockSpeed(void) const { return clock; }
+  /*!
+    @brief   Check whether a transaction is open.
+    @return  true between beginTransaction() and endTransaction().
+  */
+  bool inTransaction(void) const { return open; }
+  /*!
+    @brief   Keep or discard issued bytes. Counters are kept either way;
+             discarding saves memory and time in benchmarks.
+    @param   keep  true (default) to keep data, false to discard.
+  */
+  void keepData(bool keep) { keeping = keep; }
+
+private:
+  std::vector<uint8_t> data; ///< Bytes issued
+  uint32_t transfers = 0;    ///< transfer() calls
+  uint32_t transactions = 0; ///< beginTransaction() calls
+  size_t largest = 0;        ///< Largest transfer(), bytes
+  uint32_t clock = 0;        ///< Clock rate of last transaction
+  bool open = false;         ///< Set inside a transaction
+  bool keeping = true;       ///< If set, keep data
+};
+
+/*!
+  @brief  Linux spidev backend, e.g. /dev/spidev0.0 on a Raspberry Pi.
+          Data issued within a transaction is queued and sent at
+          endTransaction() in as few SPI_IOC_MESSAGE ioctls as the
+          driver's buffer size allows (/sys/module/spidev/parameters/bufsiz,
+          4096 bytes by default). If the path isn't an SPI device (e.g. a
+          regular file, a pipe or /dev/null), the data is written to it
+          as-is instead, for capturing wire output to a file.
+*/
+class HostSPIDev : public HostSPIBackend {
+public:
+  HostSPIDev(const char *path, uint32_t maxMessage = 0);
+  ~HostSPIDev();
+
+  bool begin(void);
+  void beginTransaction(uint32_t freq, uint8_t mode);
+  void endTransaction(void);
+  void transfer(const uint8_t *buf, size_t len);
+  /*!
+    @brief   Check whether the device is an SPI device (vs. a file).
+    @return  true if spidev, false if file or not open.
+  */
+  bool isSPI(void) const { return spi; }
+  /*!
+    @brief   Check whether opening or any write failed.
+    @return  true on error.
+  */
+  bool failed(void) const { return error; }
+  /*!
+    @brief   Get the number of ioctl (or write) calls made.
+    @return  Count since begin().
+  */
+  uint32_t getMessages(void) const { return messages; }
+
+private:
+  void send(void);
+
+  const char *path;           ///< Device or file path
+  int fd = -1;                ///< Open file descriptor
+  uint32_t maxMessage;        ///< Largest ioctl message, bytes
+  uint32_t freq = 0;          ///< Clock rate of transaction, Hz
+  uint8_t mode = 0;           ///< SPI mode of transaction
+  bool spi = false;           ///< Set if path is an SPI device
+  bool error = false;         ///< Set on any failure
+  uint32_t messages = 0;      ///< ioctl or write calls
+  std::vector<uint8_t> queue; ///< Data awaiting endTransaction()
+};
+
+HostSPIMock &hostSPIMock(void);
+
+/*!
+  @brief  Stream reading from an outside source through a buffer, without
+          ever waiting: available() is what's buffered plus whatever the
+          source has ready, 0 if nothing is. Bytes left over from one read
+          are kept ahead of the next, so data split across reads (e.g. a
+          pixel straddling two datagrams) joins up.
+*/
+class HostInputStream : public Stream {
+public:
+  /*!
+    @brief   Create a stream with a given buffer size.
+    @param   size  Buffer size, at least twice the largest single read.
+  */
+  HostInputStream(size_t size) : buf(size) {}
+  int available(void);
+  int read(void);
+  int peek(void);
+  /*!
+    @brief   Writing isn't supported.
+    @return  0.
+  */
+  size_t write(uint8_t) { return 0; }
+  using Print::write;
+  /*!
+    @brief   Check whether the source failed to open.
+    @return  true on error.
+  */
+  bool failed(void) const { return fd < 0; }
+
+protected:
+  /*!
+    @brief   Read what the source has ready, without waiting.
+    @param   dst  Destination.
+    @param   max  Space at dst, bytes.
+    @return  Bytes read, 0 if none.
+  */
+  virtual size_t fill(uint8_t *dst, size_t max) = 0;
+
+  int fd = -1; ///< Open file descriptor or socket
+
+private:
+  std::vector<uint8_t> buf; ///< Data read ahead
+  size_t pos = 0;           ///< Next byte in buf
+  size_t len = 0;           ///< Bytes in buf
+};
+
+/*!
+  @brief  Stream reading a file, pipe or FIFO, e.g. frames for
+          Adafruit_DotStarIngest from a capture file or another process.
+*/
+class HostFileStream : public HostInputStream {
+public:
+  HostFileStream(const char *path);
+  ~HostFileStream();
+
+protected:
+  size_t fill(uint8_t *dst, size_t max);
+};
+
+/*!
+  @brief  Stream receiving UDP datagrams on a local port, e.g. from a
+          media server, back to back as one byte stream. Datagrams lost in
+          transit are simply missing from the stream, which Adalight
+          framing recovers from.
+*/
+class HostUDPStream : public HostInputStream {
+public:
+  HostUDPStream(uint16_t port, const char *addr = "127.0.0.1");
+  ~HostUDPStream();
+  /*!
+    @brief   Get the port bound, e.g. the one picked for port 0.
+    @return  Port number.
+  */
+  uint16_t getPort(void) const { return port; }
+  /*!
+    @brief   Get the number of datagrams received.
+    @return  Count since construction.
+  */
+  uint32_t getDatagrams(void) const { return datagrams; }
+
+protected:
+  size_t fill(uint8_t *dst, size_t max);
+
+private:
+  uint16_t port = 0;      ///< Bound port
+  uint32_t datagrams = 0; ///< Datagrams received
+};
+
+/*!
+  @brief  Test clock. Once set, micros() and millis() return a time that
+          moves only when advanced, by advance(), delay() or
+          delayMicroseconds(), so timing can be tested exactly. Not for
+          use while other threads read the time.
+*/
+class HostClock {
+public:
+  static void set(uint32_t us);
+  static void advance(uint32_t us);
+  static void release(void);
+  /*!
+    @brief   Check whether the clock is stopped.
+    @return  true after set(), until release().
+  */
+  static bool isSet(void) { return manual; }
+  /*!
+    @brief   Get the stopped clock's time.
+    @return  Time in microseconds.
+  */
+  static uint32_t get(void) { return now; }
+
+private:
+  static uint32_t now; ///< Time in microseconds, if manual
+  static bool manual;  ///< Set if stopped
+};
+
+/*!
+  @brief  Mock GPIO: 128 pins (4 ports of 32) with edge counts, and a
+          decoder that turns activity on a soft SPI data/clock pin pair
+          back into bytes (mode 0, MSB first). A simulated interrupt
+          handler can be set to run between pin writes, as long as
+          noInterrupts() isn't in effect.
+*/
+class HostGPIO {
+public:
+  static void reset(void);
+  static int get(uint8_t pin);
+  static uint32_t getEdges(uint8_t pin);
+  /*!
+    @brief   Get the number of pin writes (digitalWrite() or port
+             register writes) since reset().
+    @return  Count.
+  */
+  static uint32_t getWrites(void) { return writes; }
+  static void decode(uint8_t data, uint8_t clock);
+  /*!
+    @brief   Get the bytes decoded since decode() was called.
+    @return  Bytes, in order.
+  */
+  static const std::vector<uint8_t> &getDecoded(void) { return decoded; }
+  /*!
+    @brief   Get the number of clock bits past the last whole byte.
+    @return  0 if the decoded data ends on a byte boundary.
+  */
+  static uint8_t getPartialBits(void) { return bits; }
+  static void setInterrupt(void (*isr)(void), uint32_t every);
+  /*!
+    @brief   Check whether interrupts are enabled.
+    @return  false between noInterrupts() and interrupts().
+  */
+  static bool interruptsEnabled(void) { return enabled; }
+
+private:
+  static void write(uint8_t port, uint32_t value);
+  static void interrupt(void);
+  static uint32_t ports[4];            ///< Pin states
+  static uint32_t edges[128];          ///< Changes per pin
+  static uint32_t writes;              ///< Pin or port writes
+  static int dataPin;                  ///< Decoded data pin, -1 = none
+  static int clockPin;                 ///< Decoded clock pin, -1 = none
+  static std::vector<uint8_t> decoded; ///< Decoded bytes
+  static uint8_t acc;                  ///< Byte being decoded
+  static uint8_t bits;                 ///< Bits in acc
+  static void (*isr)(void);            ///< Simulated interrupt handler
+  static uint32_t isrEvery;            ///< Writes between interrupts
+  static uint32_t isrCount;            ///< Writes since last interrupt
+  static bool enabled;                 ///< Interrupts enabled
+  static bool pending;                 ///< Interrupt held off
+  static bool inISR;                   ///< Set while isr runs
+
+  friend void digitalWrite(uint8_t pin, uint8_t val);
+  friend int digitalRead(uint8_t pin);
+  friend uint32_t hostPortRead(uint8_t port);
+  friend void hostPortWrite(uint8_t port, uint32_t value);
+  friend void noInterrupts(void);
+  friend void interrupts(void);
+};
+
+#endif // _DOTSTAR_HOST_H_
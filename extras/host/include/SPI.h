@@ -0,0 +1,52 @@
+/*!
+ * @file SPI.h
+ *
+ * Host stand-in for the Arduino SPI library. An SPIClass is just a handle
+ * on a HostSPIBackend (DotStarHost.h) that Adafruit_SPIDevice issues data
+ * to: the default SPI object starts out with an in-memory mock, and can
+ * be pointed at a spidev device or file instead.
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _DOTSTAR_HOST_SPI_H_
+#define _DOTSTAR_HOST_SPI_H_
+
+#include "Arduino.h"
+
+class HostSPIBackend;
+
+/*!
+  @brief  Hardware SPI bus, as seen by Adafruit_SPIDevice.
+*/
+class SPIClass {
+public:
+  SPIClass(HostSPIBackend *backend = NULL);
+  /*!
+    @brief   Route this bus to a different backend.
+    @param   b  Backend, e.g. a HostSPIDev. NULL for the default mock.
+  */
+  void setBackend(HostSPIBackend *b) { backend = b; }
+  HostSPIBackend *getBackend(void) const;
+
+private:
+  HostSPIBackend *backend; ///< Where data goes, NULL for the default
+};
+
+extern SPIClass SPI; ///< Default bus, initially the mock
+
+#endif // _DOTSTAR_HOST_SPI_H_
@@ -0,0 +1,95 @@
+/*!
+ * @file FreeRTOS.h
+ *
+ * Host stand-in for the parts of ESP32 FreeRTOS that
+ * Adafruit_DotStarRender and Adafruit_DotStarGroup use, on std::thread.
+ * Building with ESP32 defined picks these up, so the parallel render path
+ * can be tested; Adafruit_DotStarGroup uses them on any Linux host build.
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _DOTSTAR_HOST_FREERTOS_H_
+#define _DOTSTAR_HOST_FREERTOS_H_
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+typedef int BaseType_t;           ///< Signed result type
+typedef unsigned UBaseType_t;     ///< Unsigned result type
+#define pdPASS 1                  ///< Success
+#define portMAX_DELAY 0xFFFFFFFFu ///< Wait forever
+#define tskNO_AFFINITY 0x7FFFFFFF ///< Task may run on any core
+
+#ifndef portNUM_PROCESSORS
+#define portNUM_PROCESSORS 2 ///< Cores, as on ESP32
+#endif
+
+/*!
+  @brief  Counting semaphore.
+*/
+struct HostSemaphore {
+  std::mutex m;               ///< Guards n
+  std::condition_variable cv; ///< Signalled when n rises
+  unsigned n;                 ///< Count
+  unsigned max;               ///< Maximum count
+};
+
+/*!
+  @brief  Task: a detached thread, and whether it's waiting on a
+          semaphore, so vTaskDelete() can wait for it to be.
+*/
+struct HostTask {
+  std::thread thread;         ///< Runs the task function
+  std::mutex m;               ///< Guards waiting
+  std::condition_variable cv; ///< Signalled when waiting changes
+  bool waiting = false;       ///< Blocked in xSemaphoreTake()
+};
+
+typedef HostSemaphore *SemaphoreHandle_t; ///< Semaphore handle
+typedef HostTask *TaskHandle_t;           ///< Task handle
+
+/*!
+  @brief   Get the calling thread's task.
+  @return  Reference to the handle, NULL outside of tasks.
+*/
+inline TaskHandle_t &hostCurrentTask(void) {
+  static thread_local TaskHandle_t task = NULL;
+  return task;
+}
+
+/*!
+  @brief   Note whether the calling task is blocked on a semaphore.
+  @param   waiting  true on blocking, false on waking.
+*/
+inline void hostTaskWaiting(bool waiting) {
+  TaskHandle_t t = hostCurrentTask();
+  if (t) {
+    std::lock_guard<std::mutex> lock(t->m);
+    t->waiting = waiting;
+    t->cv.notify_all();
+  }
+}
+
+/*!
+  @brief   Get the calling task's core.
+  @return  0, always.
+*/
+inline BaseType_t xPortGetCoreID(void) { return 0; }
+
+#endif // _DOTSTAR_HOST_FREERTOS_H_
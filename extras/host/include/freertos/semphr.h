@@ -0,0 +1,89 @@
+/*!
+ * @file semphr.h
+ *
+ * Host stand-in for FreeRTOS semaphores, see FreeRTOS.h.
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _DOTSTAR_HOST_SEMPHR_H_
+#define _DOTSTAR_HOST_SEMPHR_H_
+
+#include "FreeRTOS.h"
+
+/*!
+  @brief   Create a counting semaphore.
+  @param   max   Maximum count.
+  @param   init  Initial count.
+  @return  Handle.
+*/
+inline SemaphoreHandle_t xSemaphoreCreateCounting(unsigned max,
+                                                  unsigned init) {
+  SemaphoreHandle_t s = new HostSemaphore;
+  s->n = init;
+  s->max = max;
+  return s;
+}
+
+/*!
+  @brief   Create a binary semaphore, initially empty.
+  @return  Handle.
+*/
+inline SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+  return xSemaphoreCreateCounting(1, 0);
+}
+
+/*!
+  @brief   Take a semaphore, waiting as long as it takes.
+  @param   s        Handle.
+  @param   timeout  Ignored, always waits.
+  @return  pdPASS.
+*/
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t s, unsigned timeout) {
+  (void)timeout;
+  std::unique_lock<std::mutex> lock(s->m);
+  if (!s->n) {
+    hostTaskWaiting(true);
+    s->cv.wait(lock, [s] { return s->n > 0; });
+    hostTaskWaiting(false);
+  }
+  s->n--;
+  return pdPASS;
+}
+
+/*!
+  @brief   Give a semaphore.
+  @param   s  Handle.
+  @return  pdPASS, or 0 if already at its maximum count.
+*/
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+  std::lock_guard<std::mutex> lock(s->m);
+  if (s->n >= s->max)
+    return 0;
+  s->n++;
+  s->cv.notify_one();
+  return pdPASS;
+}
+
+/*!
+  @brief   Delete a semaphore. Left allocated, as a deleted task's thread
+           (see vTaskDelete()) may still be waiting on it.
+  @param   s  Handle.
+*/
+inline void vSemaphoreDelete(SemaphoreHandle_t s) { (void)s; }
+
+#endif // _DOTSTAR_HOST_SEMPHR_H_
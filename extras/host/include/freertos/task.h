@@ -0,0 +1,82 @@
+/*!
+ * @file task.h
+ *
+ * Host stand-in for FreeRTOS tasks, see FreeRTOS.h.
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _DOTSTAR_HOST_TASK_H_
+#define _DOTSTAR_HOST_TASK_H_
+
+#include "FreeRTOS.h"
+
+/*!
+  @brief   Create a task, as a detached thread.
+  @param   fn        Task function.
+  @param   name      Ignored.
+  @param   stack     Ignored.
+  @param   arg       Argument passed to fn.
+  @param   priority  Ignored.
+  @param   handle    Receives the handle.
+  @param   core      Ignored.
+  @return  pdPASS.
+*/
+inline BaseType_t xTaskCreatePinnedToCore(void (*fn)(void *), const char *name,
+                                          unsigned stack, void *arg,
+                                          UBaseType_t priority,
+                                          TaskHandle_t *handle,
+                                          BaseType_t core) {
+  (void)name;
+  (void)stack;
+  (void)priority;
+  (void)core;
+  TaskHandle_t t = new HostTask;
+  t->thread = std::thread([fn, arg, t] {
+    hostCurrentTask() = t;
+    fn(arg);
+  });
+  t->thread.detach();
+  *handle = t;
+  return pdPASS;
+}
+
+/*!
+  @brief   Delete a task. Threads can't be killed, so this waits for it to
+           block on a semaphore (for Adafruit_DotStarRender and
+           Adafruit_DotStarGroup workers, their start semaphore, never
+           given again) and leaves it parked there. Until then it may not
+           have run at all, and would go on to read its arguments after
+           their owner has freed them. Left allocated, like the semaphore.
+  @param   task  Handle.
+*/
+inline void vTaskDelete(TaskHandle_t task) {
+  std::unique_lock<std::mutex> lock(task->m);
+  task->cv.wait(lock, [task] { return task->waiting; });
+}
+
+/*!
+  @brief   Get a task's priority.
+  @param   task  Handle, NULL for the calling task.
+  @return  1, always.
+*/
+inline UBaseType_t uxTaskPriorityGet(void *task) {
+  (void)task;
+  return 1;
+}
+
+#endif // _DOTSTAR_HOST_TASK_H_
@@ -0,0 +1,444 @@
+/*!
+ * @file Arduino.cpp
+ *
+ * Host Arduino core stand-in: timing, the mock GPIO, Print/Stream and the
+ * Serial console. See Arduino.h and DotStarHost.h.
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "DotStarHost.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <thread>
+
+// TIMING ------------------------------------------------------------------
+
+uint32_t HostClock::now = 0;
+bool HostClock::manual = false;
+
+/*!
+  @brief   Stop the clock at a given time. From now on micros() and
+           millis() only move when the clock is advanced.
+  @param   us  Time in microseconds.
+*/
+void HostClock::set(uint32_t us) {
+  now = us;
+  manual = true;
+}
+
+/*!
+  @brief   Move a stopped clock forward.
+  @param   us  Microseconds to add; wraps like micros().
+*/
+void HostClock::advance(uint32_t us) { now += us; }
+
+/*!
+  @brief   Go back to real time.
+*/
+void HostClock::release(void) { manual = false; }
+
+/*!
+  @brief   Microseconds since an arbitrary start; wraps like on Arduino.
+  @return  Time in microseconds, or the stopped clock's (see HostClock).
+*/
+uint32_t micros(void) {
+  if (HostClock::isSet())
+    return HostClock::get();
+  return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/*!
+  @brief   Milliseconds since an arbitrary start.
+  @return  Time in milliseconds, or the stopped clock's (see HostClock).
+*/
+uint32_t millis(void) {
+  if (HostClock::isSet())
+    return HostClock::get() / 1000;
+  return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/*!
+  @brief   Sleep, or advance the stopped clock (see HostClock).
+  @param   ms  Milliseconds.
+*/
+void delay(uint32_t ms) {
+  if (HostClock::isSet())
+    HostClock::advance(ms * 1000);
+  else
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+/*!
+  @brief   Sleep, or advance the stopped clock (see HostClock).
+  @param   us  Microseconds.
+*/
+void delayMicroseconds(uint32_t us) {
+  if (HostClock::isSet())
+    HostClock::advance(us);
+  else
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+/*!
+  @brief   Let other threads run.
+*/
+void yield(void) { std::this_thread::yield(); }
+
+// MOCK GPIO ---------------------------------------------------------------
+
+uint32_t HostGPIO::ports[4];
+uint32_t HostGPIO::edges[128];
+uint32_t HostGPIO::writes;
+int HostGPIO::dataPin = -1;
+int HostGPIO::clockPin = -1;
+std::vector<uint8_t> HostGPIO::decoded;
+uint8_t HostGPIO::acc;
+uint8_t HostGPIO::bits;
+void (*HostGPIO::isr)(void);
+uint32_t HostGPIO::isrEvery;
+uint32_t HostGPIO::isrCount;
+bool HostGPIO::enabled = true;
+bool HostGPIO::pending;
+bool HostGPIO::inISR;
+
+/*!
+  @brief   Set all pins low, and clear counts, decoder and interrupt
+           handler.
+*/
+void HostGPIO::reset(void) {
+  memset(ports, 0, sizeof(ports));
+  memset(edges, 0, sizeof(edges));
+  writes = 0;
+  dataPin = clockPin = -1;
+  decoded.clear();
+  acc = bits = 0;
+  isr = NULL;
+  isrEvery = isrCount = 0;
+  enabled = true;
+  pending = false;
+}
+
+/*!
+  @brief   Read a pin's output state.
+  @param   pin  Pin number, 0-127.
+  @return  LOW or HIGH.
+*/
+int HostGPIO::get(uint8_t pin) { return (ports[pin / 32] >> (pin % 32)) & 1; }
+
+/*!
+  @brief   Get the number of times a pin has changed state.
+  @param   pin  Pin number, 0-127.
+  @return  Rising plus falling edges since reset().
+*/
+uint32_t HostGPIO::getEdges(uint8_t pin) { return edges[pin]; }
+
+/*!
+  @brief   Start decoding soft SPI output on a pair of pins: the data pin
+           is sampled on each rising edge of the clock pin, MSB first.
+  @param   data   Data pin.
+  @param   clock  Clock pin.
+*/
+void HostGPIO::decode(uint8_t data, uint8_t clock) {
+  dataPin = data;
+  clockPin = clock;
+  decoded.clear();
+  acc = bits = 0;
+}
+
+/*!
+  @brief   Set a simulated interrupt handler, called after every so many
+           pin writes while interrupts are enabled (or as soon as they're
+           re-enabled, if held off). It may write pins itself.
+  @param   handler  Function to call, NULL for none.
+  @param   every    Pin writes between calls.
+*/
+void HostGPIO::setInterrupt(void (*handler)(void), uint32_t every) {
+  isr = handler;
+  isrEvery = every;
+  isrCount = 0;
+  pending = false;
+}
+
+/*!
+  @brief   Run the interrupt handler.
+*/
+void HostGPIO::interrupt(void) {
+  pending = false;
+  inISR = true;
+  (*isr)();
+  inISR = false;
+}
+
+/*!
+  @brief   Change a port's pin states: all at once, as a port register
+           write would. Counts edges, feeds the soft SPI decoder and
+           triggers the simulated interrupt.
+  @param   port   Port number, 0-3.
+  @param   value  New pin states.
+*/
+void HostGPIO::write(uint8_t port, uint32_t value) {
+  uint32_t changed = ports[port] ^ value, c;
+  ports[port] = value;
+  writes++;
+  for (uint8_t i = 0; (c = changed >> i); i++)
+    edges[port * 32 + i] += c & 1;
+  // Rising clock edge: sample data (at its new state, if it changed in
+  // the same write; nothing here changes both at once).
+  if ((clockPin >= 0) && (clockPin / 32 == port) &&
+      ((changed & value) >> (clockPin % 32) & 1)) {
+    acc = (acc << 1) | get(dataPin);
+    if (++bits == 8) {
+      decoded.push_back(acc);
+      bits = 0;
+    }
+  }
+  if (isr && !inISR && (++isrCount >= isrEvery)) {
+    isrCount = 0;
+    if (enabled)
+      interrupt();
+    else
+      pending = true;
+  }
+}
+
+/*!
+  @brief   Set a pin's output state.
+  @param   pin  Pin number, 0-127.
+  @param   val  LOW or HIGH.
+*/
+void digitalWrite(uint8_t pin, uint8_t val) {
+  uint32_t m = 1UL << (pin % 32), p = HostGPIO::ports[pin / 32];
+  HostGPIO::write(pin / 32, val ? (p | m) : (p & ~m));
+}
+
+/*!
+  @brief   Read a pin's output state (there are no inputs).
+  @param   pin  Pin number, 0-127.
+  @return  LOW or HIGH.
+*/
+int digitalRead(uint8_t pin) { return HostGPIO::get(pin); }
+
+/*!
+  @brief   Set a pin's mode (no-op, all pins are outputs).
+  @param   pin   Pin number.
+  @param   mode  INPUT or OUTPUT.
+*/
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void)pin;
+  (void)mode;
+}
+
+/*!
+  @brief   Hold off the simulated interrupt handler.
+*/
+void noInterrupts(void) { HostGPIO::enabled = false; }
+
+/*!
+  @brief   Allow the simulated interrupt handler, running it now if it
+           was held off.
+*/
+void interrupts(void) {
+  HostGPIO::enabled = true;
+  if (HostGPIO::pending)
+    HostGPIO::interrupt();
+}
+
+/*!
+  @brief   Read a mock port's output state.
+  @param   port  Port number, 0-3.
+  @return  Pin states, one per bit.
+*/
+uint32_t hostPortRead(uint8_t port) { return HostGPIO::ports[port]; }
+
+/*!
+  @brief   Write a mock port's output state.
+  @param   port   Port number, 0-3.
+  @param   value  Pin states, one per bit.
+*/
+void hostPortWrite(uint8_t port, uint32_t value) {
+  HostGPIO::write(port, value);
+}
+
+#ifdef DOTSTAR_HOST_FAST_PINIO
+/*!
+  @brief   Get a mock port's output register.
+  @param   port  Port number, 0-3.
+  @return  Pointer to register.
+*/
+volatile HostPortReg *hostPortRegister(uint8_t port) {
+  static HostPortReg regs[4] = {{0}, {1}, {2}, {3}};
+  return &regs[port];
+}
+#endif
+
+// PRINT & STREAM ----------------------------------------------------------
+
+/*!
+  @brief   Write bytes one at a time.
+  @param   buf  Data.
+  @param   len  Length in bytes.
+  @return  Number of bytes written.
+*/
+size_t Print::write(const uint8_t *buf, size_t len) {
+  size_t n = 0;
+  while (len-- && write(*buf++))
+    n++;
+  return n;
+}
+
+/*!
+  @brief   Print a string.
+  @param   s  NUL-terminated string.
+  @return  Number of bytes written.
+*/
+size_t Print::print(const char *s) { return write(s); }
+
+/*!
+  @brief   Print a character.
+  @param   c  Character.
+  @return  Number of bytes written.
+*/
+size_t Print::print(char c) { return write((uint8_t)c); }
+
+/*!
+  @brief   Print an unsigned number.
+  @param   n     Value.
+  @param   base  Radix, DEC or HEX.
+  @return  Number of bytes written.
+*/
+size_t Print::print(unsigned long n, int base) {
+  char s[24];
+  snprintf(s, sizeof(s), (base == HEX) ? "%lX" : "%lu", n);
+  return write(s);
+}
+
+/*!
+  @brief   Print a signed number.
+  @param   n     Value.
+  @param   base  Radix, DEC or HEX (HEX prints the two's complement).
+  @return  Number of bytes written.
+*/
+size_t Print::print(long n, int base) {
+  if (base == HEX)
+    return print((unsigned long)n, base);
+  char s[24];
+  snprintf(s, sizeof(s), "%ld", n);
+  return write(s);
+}
+
+/*!
+  @brief   Print a floating-point number.
+  @param   n       Value.
+  @param   digits  Digits after the decimal point.
+  @return  Number of bytes written.
+*/
+size_t Print::print(double n, int digits) {
+  char s[48];
+  snprintf(s, sizeof(s), "%.*f", digits, n);
+  return write(s);
+}
+
+/*!
+  @brief   Print a newline.
+  @return  Number of bytes written.
+*/
+size_t Print::println(void) { return write("\r\n"); }
+
+/*!
+  @brief   Read bytes one at a time through read(), stopping at the first
+           byte not available.
+  @param   buf  Destination.
+  @param   len  Maximum number of bytes.
+  @return  Number of bytes read.
+*/
+size_t Stream::readBytes(char *buf, size_t len) {
+  size_t n = 0;
+  int c;
+  while ((n < len) && ((c = read()) >= 0))
+    buf[n++] = (char)c;
+  return n;
+}
+
+/*!
+  @brief   Skip to the next number and read it.
+  @return  Value, 0 if none.
+*/
+long Stream::parseInt(void) {
+  int c;
+  while (((c = peek()) >= 0) && (c != '-') && ((c < '0') || (c > '9')))
+    read();
+  bool neg = (c == '-');
+  if (neg)
+    read();
+  long v = 0;
+  while (((c = peek()) >= '0') && (c <= '9')) {
+    v = v * 10 + c - '0';
+    read();
+  }
+  return neg ? -v : v;
+}
+
+HardwareSerial Serial;
+
+/*!
+  @brief   Write a byte to stdout.
+  @param   b  Byte.
+  @return  1.
+*/
+size_t HardwareSerial::write(uint8_t b) {
+  putchar(b);
+  return 1;
+}
+
+/*!
+  @brief   Write bytes to stdout.
+  @param   buf  Data.
+  @param   len  Length in bytes.
+  @return  Number of bytes written.
+*/
+size_t HardwareSerial::write(const uint8_t *buf, size_t len) {
+  return fwrite(buf, 1, len, stdout);
+}
+
+/*!
+  @brief   Flush stdout.
+*/
+void HardwareSerial::flush(void) { fflush(stdout); }
+
+/*!
+  @brief   Check for input (there is none).
+  @return  0.
+*/
+int HardwareSerial::available(void) { return 0; }
+
+/*!
+  @brief   Read input (there is none).
+  @return  -1.
+*/
+int HardwareSerial::read(void) { return -1; }
+
+/*!
+  @brief   Peek at input (there is none).
+  @return  -1.
+*/
+int HardwareSerial::peek(void) { return -1; }
@@ -0,0 +1,357 @@
+/*!
+ * @file HostSPI.cpp
+ *
+ * Host SPI: the SPIClass and Adafruit_SPIDevice stand-ins, and the mock
+ * and spidev backends. See SPI.h, Adafruit_SPIDevice.h and DotStarHost.h.
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "DotStarHost.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/spi/spidev.h>
+#include <sys/ioctl.h>
+#endif
+
+// SPI BUS -----------------------------------------------------------------
+
+SPIClass SPI;
+
+/*!
+  @brief   Get the mock device the default SPI bus starts out with (and
+           that any bus without a backend of its own uses).
+  @return  Reference to the mock.
+*/
+HostSPIMock &hostSPIMock(void) {
+  static HostSPIMock mock;
+  return mock;
+}
+
+/*!
+  @brief   SPIClass constructor.
+  @param   backend  Where data goes. NULL (default) for the mock, see
+                    hostSPIMock().
+*/
+SPIClass::SPIClass(HostSPIBackend *backend) : backend(backend) {}
+
+/*!
+  @brief   Get the backend this bus issues data to.
+  @return  Backend.
+*/
+HostSPIBackend *SPIClass::getBackend(void) const {
+  return backend ? backend : &hostSPIMock();
+}
+
+// ADAFRUIT_SPIDEVICE ------------------------------------------------------
+
+/*!
+  @brief   Hardware SPI device constructor.
+  @param   cspin      Chip select pin (unused, DotStars have none).
+  @param   freq       Clock rate, Hz.
+  @param   dataOrder  Bit order (MSB first is assumed).
+  @param   dataMode   SPI mode.
+  @param   theSPI     Bus.
+*/
+Adafruit_SPIDevice::Adafruit_SPIDevice(int8_t cspin, uint32_t freq,
+                                       BusIOBitOrder dataOrder,
+                                       uint8_t dataMode, SPIClass *theSPI)
+    : spi(theSPI ? theSPI : &SPI), freq(freq), mode(dataMode), sck(-1),
+      mosi(-1) {
+  (void)cspin;
+  (void)dataOrder;
+}
+
+/*!
+  @brief   Soft SPI device constructor.
+  @param   cspin      Chip select pin (unused).
+  @param   sck        Clock pin.
+  @param   miso       Input pin (unused, there are no inputs).
+  @param   mosi       Data pin.
+  @param   freq       Clock rate, Hz (there are no delays).
+  @param   dataOrder  Bit order (MSB first is assumed).
+  @param   dataMode   SPI mode (0 is assumed).
+*/
+Adafruit_SPIDevice::Adafruit_SPIDevice(int8_t cspin, int8_t sck, int8_t miso,
+                                       int8_t mosi, uint32_t freq,
+                                       BusIOBitOrder dataOrder,
+                                       uint8_t dataMode)
+    : spi(NULL), freq(freq), mode(dataMode), sck(sck), mosi(mosi) {
+  (void)cspin;
+  (void)miso;
+  (void)dataOrder;
+}
+
+/*!
+  @brief   Initialize the device: set soft SPI pins low, or begin the
+           hardware bus's backend.
+  @return  true on success.
+*/
+bool Adafruit_SPIDevice::begin(void) {
+  if (!spi) {
+    digitalWrite(sck, LOW);
+    digitalWrite(mosi, LOW);
+    return true;
+  }
+  return spi->getBackend()->begin();
+}
+
+/*!
+  @brief   Begin a transaction at this device's clock rate and mode.
+*/
+void Adafruit_SPIDevice::beginTransaction(void) {
+  if (spi)
+    spi->getBackend()->beginTransaction(freq, mode);
+}
+
+/*!
+  @brief   End a transaction.
+*/
+void Adafruit_SPIDevice::endTransaction(void) {
+  if (spi)
+    spi->getBackend()->endTransaction();
+}
+
+/*!
+  @brief   Send one byte.
+  @param   send  Byte.
+  @return  Byte received (always 0, there's no input).
+*/
+uint8_t Adafruit_SPIDevice::transfer(uint8_t send) {
+  transfer(&send, 1);
+  return send;
+}
+
+/*!
+  @brief   Send bytes. As with BusIO, the buffer is overwritten with the
+           data received, which here is all zeros.
+  @param   buffer  Data.
+  @param   len     Length in bytes.
+*/
+void Adafruit_SPIDevice::transfer(uint8_t *buffer, size_t len) {
+  if (spi)
+    spi->getBackend()->transfer(buffer, len);
+  else
+    softTransfer(buffer, len);
+  memset(buffer, 0, len);
+}
+
+/*!
+  @brief   Send bytes (and optional prefix), leaving them unchanged.
+  @param   buffer         Data.
+  @param   len            Length in bytes.
+  @param   prefix_buffer  Data sent first, or NULL.
+  @param   prefix_len     Length of prefix.
+  @return  true, always.
+*/
+bool Adafruit_SPIDevice::write(const uint8_t *buffer, size_t len,
+                               const uint8_t *prefix_buffer,
+                               size_t prefix_len) {
+  std::vector<uint8_t> tmp(prefix_buffer, prefix_buffer + prefix_len);
+  tmp.insert(tmp.end(), buffer, buffer + len);
+  beginTransaction();
+  transfer(tmp.data(), tmp.size());
+  endTransaction();
+  return true;
+}
+
+/*!
+  @brief   Bitbang bytes on the soft SPI pins, one digitalWrite() per pin
+           change as BusIO's generic path does: data, then clock high,
+           then clock low, per bit.
+  @param   buffer  Data.
+  @param   len     Length in bytes.
+*/
+void Adafruit_SPIDevice::softTransfer(uint8_t *buffer, size_t len) {
+  while (len--) {
+    uint8_t b = *buffer++;
+    for (uint8_t bit = 0x80; bit; bit >>= 1) {
+      digitalWrite(mosi, (b & bit) ? HIGH : LOW);
+      digitalWrite(sck, HIGH);
+      digitalWrite(sck, LOW);
+    }
+  }
+}
+
+// MOCK BACKEND ------------------------------------------------------------
+
+/*!
+  @brief   Start a transaction.
+  @param   freq  Clock rate, Hz.
+  @param   mode  SPI mode.
+*/
+void HostSPIMock::beginTransaction(uint32_t freq, uint8_t mode) {
+  (void)mode;
+  clock = freq;
+  transactions++;
+  open = true;
+}
+
+/*!
+  @brief   End a transaction.
+*/
+void HostSPIMock::endTransaction(void) { open = false; }
+
+/*!
+  @brief   Record data.
+  @param   buf  Data.
+  @param   len  Length in bytes.
+*/
+void HostSPIMock::transfer(const uint8_t *buf, size_t len) {
+  if (keeping)
+    data.insert(data.end(), buf, buf + len);
+  transfers++;
+  if (len > largest)
+    largest = len;
+}
+
+/*!
+  @brief   Discard recorded data and reset counters.
+*/
+void HostSPIMock::clear(void) {
+  data.clear();
+  transfers = transactions = 0;
+  largest = 0;
+}
+
+// SPIDEV BACKEND ----------------------------------------------------------
+
+/*!
+  @brief   HostSPIDev constructor. Call begin() (or begin() the strip)
+           to open the device.
+  @param   path        Device path, e.g. "/dev/spidev0.0", or a file.
+  @param   maxMessage  Largest ioctl message in bytes, 0 (default) for the
+                       spidev driver's buffer size.
+*/
+HostSPIDev::HostSPIDev(const char *path, uint32_t maxMessage)
+    : path(path), maxMessage(maxMessage) {}
+
+/*!
+  @brief   Close the device.
+*/
+HostSPIDev::~HostSPIDev() {
+  if (fd >= 0)
+    close(fd);
+}
+
+/*!
+  @brief   Open the device, and find out whether it's spidev or a file.
+  @return  true on success, false if it could not be opened.
+*/
+bool HostSPIDev::begin(void) {
+  if (fd >= 0)
+    return !error;
+  if ((fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+    error = true;
+    return false;
+  }
+  messages = 0;
+#if defined(__linux__)
+  uint8_t m = SPI_MODE_0;
+  spi = ioctl(fd, SPI_IOC_WR_MODE, &m) == 0;
+  if (spi) {
+    uint8_t bits = 8;
+    ioctl(fd, SPI_IOC_WR_BITS_PER_WORD, &bits);
+    if (!maxMessage) {
+      FILE *f = fopen("/sys/module/spidev/parameters/bufsiz", "r");
+      unsigned long n = 0;
+      if (f) {
+        if (fscanf(f, "%lu", &n) != 1)
+          n = 0;
+        fclose(f);
+      }
+      maxMessage = n ? n : 4096;
+    }
+  }
+#endif
+  return true;
+}
+
+/*!
+  @brief   Start a transaction: data is queued until endTransaction().
+  @param   freq  Clock rate, Hz.
+  @param   mode  SPI mode.
+*/
+void HostSPIDev::beginTransaction(uint32_t freq, uint8_t mode) {
+  this->freq = freq;
+  this->mode = mode;
+}
+
+/*!
+  @brief   End a transaction, sending the queued data.
+*/
+void HostSPIDev::endTransaction(void) { send(); }
+
+/*!
+  @brief   Queue data.
+  @param   buf  Data.
+  @param   len  Length in bytes.
+*/
+void HostSPIDev::transfer(const uint8_t *buf, size_t len) {
+  queue.insert(queue.end(), buf, buf + len);
+}
+
+/*!
+  @brief   Send queued data: ioctl messages of up to maxMessage bytes to
+           spidev, or one write() to a file.
+*/
+void HostSPIDev::send(void) {
+  if (queue.empty())
+    return;
+  if (fd < 0) {
+    error = true;
+  } else if (!spi) {
+    size_t done = 0;
+    ssize_t n;
+    while (done < queue.size()) {
+      n = ::write(fd, &queue[done], queue.size() - done);
+      messages++;
+      if (n < 0) {
+        if (errno == EINTR)
+          continue;
+        error = true;
+        break;
+      }
+      done += n;
+    }
+  }
+#if defined(__linux__)
+  else {
+    struct spi_ioc_transfer t;
+    for (size_t done = 0, n; done < queue.size(); done += n) {
+      n = queue.size() - done;
+      if (n > maxMessage)
+        n = maxMessage;
+      memset(&t, 0, sizeof(t));
+      t.tx_buf = (unsigned long)&queue[done];
+      t.len = n;
+      t.speed_hz = freq;
+      t.bits_per_word = 8;
+      messages++;
+      if (ioctl(fd, SPI_IOC_MESSAGE(1), &t) < 0) {
+        error = true;
+        break;
+      }
+    }
+  }
+#endif
+  queue.clear();
+}
@@ -0,0 +1,153 @@
+/*!
+ * @file HostStream.cpp
+ *
+ * Host Streams for feeding frames in from outside: HostFileStream (files,
+ * pipes, FIFOs) and HostUDPStream (a local UDP port). See DotStarHost.h.
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "DotStarHost.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// BUFFERING ---------------------------------------------------------------
+
+/*!
+  @brief   Get the number of bytes ready to read. If less than half the
+           buffer is held, what's left moves to the front and the source
+           is read for more.
+  @return  Byte count, 0 if nothing's buffered or waiting.
+*/
+int HostInputStream::available(void) {
+  if ((len - pos < buf.size() / 2) && (fd >= 0)) {
+    memmove(buf.data(), &buf[pos], len - pos);
+    len -= pos;
+    pos = 0;
+    len += fill(&buf[len], buf.size() - len);
+  }
+  return len - pos;
+}
+
+/*!
+  @brief   Read one byte.
+  @return  Byte value, or -1 if none available.
+*/
+int HostInputStream::read(void) {
+  return ((pos < len) || available()) ? buf[pos++] : -1;
+}
+
+/*!
+  @brief   Get the next byte without consuming it.
+  @return  Byte value, or -1 if none available.
+*/
+int HostInputStream::peek(void) {
+  return ((pos < len) || available()) ? buf[pos] : -1;
+}
+
+// FILE --------------------------------------------------------------------
+
+/*!
+  @brief   Open a file, pipe or FIFO for reading.
+  @param   path  Path, or "-" for standard input.
+*/
+HostFileStream::HostFileStream(const char *path) : HostInputStream(8192) {
+  if (!strcmp(path, "-")) {
+    fd = dup(0);
+    if (fd >= 0)
+      fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  } else {
+    fd = open(path, O_RDONLY | O_NONBLOCK);
+  }
+}
+
+/*!
+  @brief   Close the file.
+*/
+HostFileStream::~HostFileStream() {
+  if (fd >= 0)
+    close(fd);
+}
+
+/*!
+  @brief   Read what's ready, without waiting.
+  @param   dst  Destination.
+  @param   max  Space at dst, bytes.
+  @return  Bytes read, 0 at end of file or if a pipe is empty.
+*/
+size_t HostFileStream::fill(uint8_t *dst, size_t max) {
+  ssize_t n = ::read(fd, dst, max);
+  return (n > 0) ? n : 0;
+}
+
+// UDP ---------------------------------------------------------------------
+
+/*!
+  @brief   Open a UDP socket bound to a local address and port.
+  @param   port  Port number, 0 to pick any free port (see getPort()).
+  @param   addr  IPv4 address to bind, default loopback only; "0.0.0.0"
+                 for all interfaces.
+*/
+HostUDPStream::HostUDPStream(uint16_t port, const char *addr)
+    : HostInputStream(65536 * 2) {
+  struct sockaddr_in sa;
+  socklen_t salen = sizeof(sa);
+  memset(&sa, 0, sizeof(sa));
+  sa.sin_family = AF_INET;
+  sa.sin_port = htons(port);
+  if ((inet_pton(AF_INET, addr, &sa.sin_addr) != 1) ||
+      ((fd = socket(AF_INET, SOCK_DGRAM, 0)) < 0))
+    return;
+  if (bind(fd, (struct sockaddr *)&sa, sizeof(sa)) ||
+      getsockname(fd, (struct sockaddr *)&sa, &salen)) {
+    close(fd);
+    fd = -1;
+    return;
+  }
+  this->port = ntohs(sa.sin_port);
+}
+
+/*!
+  @brief   Close the socket.
+*/
+HostUDPStream::~HostUDPStream() {
+  if (fd >= 0)
+    close(fd);
+}
+
+/*!
+  @brief   Receive waiting datagrams, as many as fit, without waiting.
+  @param   dst  Destination.
+  @param   max  Space at dst, bytes; at least one maximum-size datagram.
+  @return  Bytes received, 0 if no datagram is waiting.
+*/
+size_t HostUDPStream::fill(uint8_t *dst, size_t max) {
+  size_t total = 0;
+  ssize_t n;
+  // A datagram too big for what's left would be truncated, so stop short
+  while ((max - total >= 65536) &&
+         ((n = recv(fd, dst + total, max - total, MSG_DONTWAIT)) >= 0)) {
+    total += n;
+    datagrams++;
+  }
+  return total;
+}
@@ -0,0 +1,152 @@
+/*!
+ * @file DotStarTest.h
+ *
+ * Minimal test helpers for the Adafruit_DotStar host build: CHECK macros
+ * that count failures, and a reference APA102 encoder written straight
+ * from the datasheet, independent of the library's own encoders.
+ *
+ * This file is part of the Adafruit_DotStar library.
+ *
+ * Adafruit_DotStar is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Adafruit_DotStar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DotStar. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _DOTSTAR_TEST_H_
+#define _DOTSTAR_TEST_H_
+
+#include "DotStarHost.h"
+
+#include <stdio.h>
+#include <vector>
+
+static int testFailures = 0; ///< Failed checks so far
+
+/*!
+  @brief  Check a condition, reporting and counting it if false.
+*/
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+      testFailures++;                                                          \
+    }                                                                          \
+  } while (0)
+
+/*!
+  @brief  Check two integers are equal, reporting both if not.
+*/
+#define CHECK_EQ(a, b)                                                         \
+  do {                                                                         \
+    long long _a = (long long)(a), _b = (long long)(b);                        \
+    if (_a != _b) {                                                            \
+      fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n",        \
+              __FILE__, __LINE__, #a, #b, _a, _b);                             \
+      testFailures++;                                                          \
+    }                                                                          \
+  } while (0)
+
+/*!
+  @brief  Check two byte sequences are equal, reporting the first
+          difference if not.
+*/
+#define CHECK_BYTES(a, b)                                                      \
+  do {                                                                         \
+    if (!sameBytes(a, b)) {                                                    \
+      fprintf(stderr, "%s:%d: CHECK_BYTES(%s, %s) failed\n", __FILE__,         \
+              __LINE__, #a, #b);                                               \
+      testFailures++;                                                          \
+    }                                                                          \
+  } while (0)
+
+/*!
+  @brief   Compare byte sequences, printing the first difference.
+  @param   a  First.
+  @param   b  Second.
+  @return  true if equal.
+*/
+static inline bool sameBytes(const std::vector<uint8_t> &a,
+                             const std::vector<uint8_t> &b) {
+  size_t n = (a.size() < b.size()) ? a.size() : b.size();
+  for (size_t i = 0; i < n; i++) {
+    if (a[i] != b[i]) {
+      fprintf(stderr, "  differ at byte %zu: %02X != %02X\n", i, a[i], b[i]);
+      return false;
+    }
+  }
+  if (a.size() != b.size()) {
+    fprintf(stderr, "  lengths differ: %zu != %zu\n", a.size(), b.size());
+    return false;
+  }
+  return true;
+}
+
+/*!
+  @brief   Report the result.
+  @param   name  Test name.
+  @return  Process exit status: 0 if all checks passed.
+*/
+static inline int testResult(const char *name) {
+  if (testFailures)
+    fprintf(stderr, "%s: %d check(s) FAILED\n", name, testFailures);
+  else
+    printf("%s: all checks passed\n", name);
+  return testFailures ? 1 : 0;
+}
+
+/*!
+  @brief   Encode one APA102 frame: 4 zero bytes, per pixel 0xFF then the
+           color bytes in the strip's order scaled by brightness, then
+           (n + 15) / 16 bytes of 0xFF.
+  @param   colors      Packed 0x00RRGGBB colors.
+  @param   order       DOTSTAR_* color order.
+  @param   brightness  As passed to setBrightness(), 255 = unscaled.
+  @return  Frame bytes.
+*/
+static inline std::vector<uint8_t>
+refFrame(const std::vector<uint32_t> &colors, uint8_t order,
+         uint8_t brightness = 255) {
+  std::vector<uint8_t> f(4, 0x00);
+  uint8_t off[3] = {(uint8_t)(order & 3), (uint8_t)((order >> 2) & 3),
+                    (uint8_t)((order >> 4) & 3)};
+  for (size_t i = 0; i < colors.size(); i++) {
+    uint8_t px[3];
+    for (int c = 0; c < 3; c++) {
+      uint32_t v = (colors[i] >> (16 - c * 8)) & 0xFF;
+      if (brightness != 255)
+        v = (v * (brightness + 1)) >> 8;
+      px[off[c]] = v;
+    }
+    f.push_back(0xFF);
+    f.insert(f.end(), px, px + 3);
+  }
+  f.insert(f.end(), (colors.size() + 15) / 16, 0xFF);
+  return f;
+}
+
+/*!
+  @brief   Make a repeatable pseudo-random color sequence.
+  @param   n     Number of colors.
+  @param   seed  Seed.
+  @return  Packed 0x00RRGGBB colors.
+*/
+static inline std::vector<uint32_t> testColors(size_t n, uint32_t seed = 1) {
+  std::vector<uint32_t> c(n);
+  for (size_t i = 0; i < n; i++) {
+    seed = seed * 1664525 + 1013904223;
+    c[i] = seed >> 8;
+  }
+  return c;
+}
+
+#endif // _DOTSTAR_TEST_H_
@@ -0,0 +1,128 @@
+// showAsync() and poll(): the frame goes out a chunk per poll() with the
+// bus released in between, drawing the next frame meanwhile doesn't
+// affect it, and the result matches a blocking show().
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStar.h>
+
+static Adafruit_DotStar *doneStrip = NULL;
+static uint32_t doneCount = 0;
+
+static void onDone(Adafruit_DotStar *s) {
+  doneStrip = s;
+  doneCount++;
+}
+
+static void testOverlap(void) {
+  HostSPIMock &mock = hostSPIMock();
+  const uint16_t n = 100, chunk = DOTSTAR_CHUNK_PIXELS;
+  const uint16_t chunks = (n + chunk - 1) / chunk;
+  std::vector<uint32_t> colors = testColors(n, 5), next = testColors(n, 6);
+  Adafruit_DotStar strip(n, DOTSTAR_GRB);
+  strip.begin();
+  strip.setShowCallback(onDone);
+  strip.setPixels(0, colors.data(), n);
+  strip.setBrightness(150);
+  std::vector<uint8_t> ref = refFrame(colors, DOTSTAR_GRB, 150);
+
+  // Start frame and first chunk only, in separate transactions
+  mock.clear();
+  doneCount = 0;
+  CHECK(strip.showAsync());
+  CHECK(strip.isBusy());
+  CHECK_EQ(mock.getData().size(), 4 + chunk * 4);
+  CHECK_EQ(mock.getTransactions(), 2);
+  CHECK(!mock.inTransaction());
+  CHECK_EQ(doneCount, 0);
+
+  // Draw the next frame while this one goes out, one chunk per poll()
+  strip.setPixels(0, next.data(), n);
+  strip.setBrightness(20);
+  uint16_t polls = 0;
+  while (strip.poll()) {
+    polls++;
+    CHECK_EQ(mock.getData().size(), 4 + (polls + 1) * chunk * 4);
+    CHECK(!mock.inTransaction());
+  }
+  CHECK_EQ(polls + 1, chunks - 1); // poll() that finished returned false
+  CHECK(!strip.isBusy());
+  CHECK_EQ(mock.getTransactions(), 1 + chunks);
+  CHECK_BYTES(mock.getData(), ref);
+  CHECK_EQ(doneCount, 1);
+  CHECK(doneStrip == &strip);
+  CHECK(!strip.poll()); // Nothing pending
+  CHECK_EQ(doneCount, 1);
+
+  // A blocking show() of the new frame gives what showAsync() would
+  std::vector<uint8_t> ref2 = refFrame(next, DOTSTAR_GRB, 20);
+  mock.clear();
+  strip.show();
+  CHECK_BYTES(mock.getData(), ref2);
+  mock.clear();
+  CHECK(strip.showAsync());
+  strip.waitForShow();
+  CHECK_BYTES(mock.getData(), ref2);
+  CHECK_EQ(doneCount, 2); // show() doesn't call back
+}
+
+// show() or another showAsync() while a frame is in progress completes it
+// first; nothing is lost or interleaved.
+static void testBackToBack(void) {
+  HostSPIMock &mock = hostSPIMock();
+  const uint16_t n = 70;
+  std::vector<uint32_t> a = testColors(n, 1), b = testColors(n, 2);
+  Adafruit_DotStar strip(n, DOTSTAR_RGB);
+  strip.begin();
+  strip.setShowCallback(onDone);
+
+  std::vector<uint8_t> ref = refFrame(a, DOTSTAR_RGB), rb;
+  rb = refFrame(b, DOTSTAR_RGB);
+  ref.insert(ref.end(), rb.begin(), rb.end());
+
+  mock.clear();
+  doneCount = 0;
+  strip.setPixels(0, a.data(), n);
+  CHECK(strip.showAsync());
+  strip.setPixels(0, b.data(), n);
+  strip.show();
+  CHECK_BYTES(mock.getData(), ref);
+  CHECK_EQ(doneCount, 1);
+
+  mock.clear();
+  strip.setPixels(0, a.data(), n);
+  CHECK(strip.showAsync());
+  strip.setPixels(0, b.data(), n);
+  CHECK(strip.showAsync());
+  strip.waitForShow();
+  CHECK_BYTES(mock.getData(), ref);
+  CHECK_EQ(doneCount, 3);
+}
+
+// Dirty tracking: an unchanged frame isn't started, but the callback is
+// still made.
+static void testSkipped(void) {
+  HostSPIMock &mock = hostSPIMock();
+  Adafruit_DotStar strip(20, DOTSTAR_BGR);
+  strip.begin();
+  strip.setShowCallback(onDone);
+  strip.setDirtyTracking(true);
+  strip.fill(0x123456);
+  CHECK(strip.showAsync());
+  strip.waitForShow();
+  mock.clear();
+  doneCount = 0;
+  CHECK(strip.showAsync());
+  CHECK(!strip.isBusy());
+  CHECK_EQ(mock.getData().size(), 0);
+  CHECK_EQ(mock.getTransactions(), 0);
+  CHECK_EQ(doneCount, 1);
+  CHECK_EQ(strip.getFramesSkipped(), 1);
+}
+
+int main(void) {
+  testOverlap();
+  testBackToBack();
+  testSkipped();
+  return testResult("async");
+}
@@ -0,0 +1,108 @@
+// Temporal dithering: each frame's color bytes are the exactly scaled
+// value rounded down or up, and over 256 frames they add up to the exact
+// value, so the average is exact. Also where dithering doesn't apply.
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStar.h>
+
+static void testAverage(void) {
+  HostSPIMock &mock = hostSPIMock();
+  const uint16_t n = 40;
+  std::vector<uint32_t> colors = testColors(n, 12);
+  for (uint8_t b : {1, 37, 100, 254}) {
+    Adafruit_DotStar strip(n, DOTSTAR_BGR);
+    strip.begin();
+    strip.setPixels(0, colors.data(), n);
+    strip.setBrightness(b);
+    CHECK(strip.setDithering(true));
+
+    // Per wire byte, exact value * 256 and sum over frames
+    std::vector<uint8_t> ref = refFrame(colors, DOTSTAR_BGR, 255);
+    std::vector<uint32_t> exact(n * 4), sum(n * 4, 0);
+    for (uint32_t i = 0; i < n * 4; i++)
+      exact[i] = ref[4 + i] * (b + 1u);
+    bool inRange = true;
+    for (int f = 0; f < 256; f++) {
+      mock.clear();
+      strip.show();
+      const std::vector<uint8_t> &d = mock.getData();
+      CHECK_EQ(d.size(), strip.getFrameBytes());
+      for (uint32_t i = 0; i < n * 4; i++) {
+        if (i % 4 == 0) { // Header
+          inRange = inRange && (d[4 + i] == 0xFF);
+          continue;
+        }
+        uint32_t lo = exact[i] >> 8, hi = lo + ((exact[i] & 255) != 0);
+        inRange = inRange && (d[4 + i] >= lo) && (d[4 + i] <= hi);
+        sum[i] += d[4 + i];
+      }
+    }
+    CHECK(inRange);
+    bool exactSum = true;
+    for (uint32_t i = 0; i < n * 4; i++)
+      exactSum = exactSum && ((i % 4 == 0) || (sum[i] == exact[i]));
+    CHECK(exactSum);
+  }
+}
+
+// Pixels of one color don't all step up in the same frame, and dirty
+// tracking keeps issuing frames while dithering.
+static void testSpread(void) {
+  HostSPIMock &mock = hostSPIMock();
+  const uint16_t n = 32;
+  Adafruit_DotStar strip(n, DOTSTAR_RGB);
+  strip.begin();
+  strip.fill(0x808080);
+  strip.setBrightness(100); // 128 * 101 / 256 = 50.5
+  CHECK(strip.setDithering(true));
+  strip.setDirtyTracking(true);
+  for (int f = 0; f < 4; f++) {
+    mock.clear();
+    strip.show();
+    const std::vector<uint8_t> &d = mock.getData();
+    CHECK_EQ(d.size(), strip.getFrameBytes());
+    uint32_t up = 0;
+    for (uint16_t i = 0; i < n; i++)
+      up += (d[4 + i * 4 + 1] == 51);
+    CHECK(up > 0);
+    CHECK(up < n);
+  }
+  CHECK_EQ(strip.getFramesSkipped(), 0);
+}
+
+// Nothing to dither: full brightness, hardware brightness and MONO
+static void testOff(void) {
+  HostSPIMock &mock = hostSPIMock();
+  const uint16_t n = 20;
+  std::vector<uint32_t> colors = testColors(n, 3);
+  Adafruit_DotStar strip(n, DOTSTAR_GRB);
+  strip.begin();
+  strip.setPixels(0, colors.data(), n);
+  CHECK(strip.setDithering(true));
+  for (int f = 0; f < 3; f++) {
+    mock.clear();
+    strip.show();
+    CHECK_BYTES(mock.getData(), refFrame(colors, DOTSTAR_GRB));
+  }
+
+  strip.setBrightness(64);
+  strip.setHardwareBrightness(true);
+  mock.clear();
+  strip.show();
+  std::vector<uint8_t> first = mock.getData();
+  mock.clear();
+  strip.show();
+  CHECK_BYTES(mock.getData(), first);
+  CHECK(strip.setDithering(false));
+
+  Adafruit_DotStar mono(n, DOTSTAR_MONO);
+  CHECK(!mono.setDithering(true));
+}
+
+int main(void) {
+  testAverage();
+  testSpread();
+  testOff();
+  return testResult("dither");
+}
@@ -0,0 +1,183 @@
+// fade(), blend(), add() and blur(), which work on the pixel buffer four
+// bytes at a time, against plain per-component math on random colors
+// (with 0x00 and 0xFF components mixed in, to catch carries between
+// lanes): every strip length up to 24 and a few longer, so the buffer
+// ends on each 4-byte remainder; ranges starting and ending anywhere, for
+// fade() and blur() (whose ends blur with themselves); and strips in
+// other color orders, which take the per-pixel path.
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStar.h>
+
+// Apply f to each component of packed colors
+template <typename F>
+static uint32_t each(uint32_t a, uint32_t b, uint32_t c, F f) {
+  uint32_t out = 0;
+  for (int s = 16; s >= 0; s -= 8)
+    out |= (uint32_t)f((a >> s) & 0xFF, (b >> s) & 0xFF, (c >> s) & 0xFF)
+           << s;
+  return out;
+}
+
+static uint32_t refFade(uint32_t x, uint8_t scale) {
+  return each(x, 0, 0, [&](uint32_t v, uint32_t, uint32_t) {
+    return (v * (scale + 1)) >> 8;
+  });
+}
+
+// Weight of 0-256 for an amount of 0-255, so that 255 is all the way
+static uint32_t weight(uint8_t amount) { return amount + (amount >> 7); }
+
+static uint32_t refBlend(uint32_t a, uint32_t b, uint8_t amount) {
+  uint32_t w = weight(amount);
+  return each(a, b, 0, [&](uint32_t u, uint32_t v, uint32_t) {
+    return (u * (256 - w) + v * w) >> 8;
+  });
+}
+
+static uint32_t refAdd(uint32_t a, uint32_t b) {
+  return each(a, b, 0, [](uint32_t u, uint32_t v, uint32_t) {
+    return std::min(u + v, (uint32_t)255);
+  });
+}
+
+static uint32_t refBlur(uint32_t p, uint32_t x, uint32_t n, uint8_t amount) {
+  uint32_t w = weight(amount);
+  return each(p, x, n, [&](uint32_t a, uint32_t b, uint32_t c) {
+    return (b * (256 - w) + ((a + 2 * b + c) >> 2) * w) >> 8;
+  });
+}
+
+// Random colors, about one component in four forced to 0x00 or 0xFF
+static std::vector<uint32_t> effectColors(size_t n, uint32_t seed) {
+  std::vector<uint32_t> c = testColors(n, seed), r = testColors(n, ~seed);
+  for (size_t i = 0; i < n; i++)
+    for (int s = 0; s < 24; s += 8)
+      if (((r[i] >> s) & 3) == 0)
+        c[i] = (c[i] & ~(0xFFu << s)) | (((r[i] >> (s + 2)) & 1) ? 0xFFu << s
+                                                                  : 0);
+  return c;
+}
+
+static bool sameColors(const Adafruit_DotStar &s,
+                       const std::vector<uint32_t> &ref, const char *what,
+                       uint32_t amount) {
+  for (uint16_t i = 0; i < s.numPixels(); i++) {
+    if (s.getPixelColor(i) != ref[i]) {
+      fprintf(stderr, "  %s %u, n %u, pixel %u: %06X, expected %06X\n",
+              what, amount, s.numPixels(), i, s.getPixelColor(i), ref[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+static const uint8_t amounts[] = {0, 1, 2, 64, 127, 128, 129, 200, 254, 255};
+
+static std::vector<uint16_t> lengths(void) {
+  std::vector<uint16_t> n;
+  for (uint16_t i = 1; i <= 24; i++)
+    n.push_back(i);
+  for (uint16_t i : {63, 64, 65, 100, 1001})
+    n.push_back(i);
+  return n;
+}
+
+static void testFade(void) {
+  for (uint16_t n : lengths()) {
+    std::vector<uint32_t> c = effectColors(n, n);
+    Adafruit_DotStar strip(n, DOTSTAR_BGR);
+    for (uint8_t scale : amounts) {
+      for (uint16_t first : {0, 1, 2, 3, 5}) {
+        for (uint16_t count : {0, 1, 2, 3, 4, 7, 50}) {
+          strip.setPixels(0, c.data(), n);
+          strip.fade(scale, first, count);
+          uint16_t end = (count && first + count < n) ? first + count : n;
+          std::vector<uint32_t> ref = c;
+          for (uint16_t i = first; i < end; i++)
+            ref[i] = refFade(c[i], scale);
+          CHECK(sameColors(strip, ref, "fade", scale));
+        }
+      }
+    }
+  }
+}
+
+static void testBlendAdd(void) {
+  for (uint16_t n : lengths()) {
+    std::vector<uint32_t> ca = effectColors(n, n + 100),
+                          cb = effectColors(n, n + 200);
+    // Same color order (word at a time), and not (pixel by pixel)
+    for (uint8_t order : {DOTSTAR_BGR, DOTSTAR_GRB}) {
+      Adafruit_DotStar a(n, DOTSTAR_BGR), b(n, order), out(n, DOTSTAR_BGR);
+      a.setPixels(0, ca.data(), n);
+      b.setPixels(0, cb.data(), n);
+      for (uint8_t amount : amounts) {
+        out.blend(a, b, amount);
+        std::vector<uint32_t> ref(n);
+        for (uint16_t i = 0; i < n; i++)
+          ref[i] = refBlend(ca[i], cb[i], amount);
+        CHECK(sameColors(out, ref, "blend", amount));
+      }
+      // In place, either side
+      out.setPixels(0, ca.data(), n);
+      out.blend(out, b, 77);
+      std::vector<uint32_t> ref(n);
+      for (uint16_t i = 0; i < n; i++)
+        ref[i] = refBlend(ca[i], cb[i], 77);
+      CHECK(sameColors(out, ref, "blend in place", 77));
+      out.setPixels(0, cb.data(), n);
+      out.blend(a, out, 77);
+      CHECK(sameColors(out, ref, "blend in place", 77));
+
+      out.setPixels(0, ca.data(), n);
+      out.add(b);
+      for (uint16_t i = 0; i < n; i++)
+        ref[i] = refAdd(ca[i], cb[i]);
+      CHECK(sameColors(out, ref, "add", 0));
+    }
+  }
+  // Shortest strip wins, the rest is left alone
+  Adafruit_DotStar a(10, DOTSTAR_BGR), b(7, DOTSTAR_BGR), out(10, DOTSTAR_BGR);
+  a.fill(0x808080);
+  b.fill(0x808080);
+  out.fill(0x010101);
+  out.add(b);
+  CHECK_EQ(out.getPixelColor(6), 0x818181);
+  CHECK_EQ(out.getPixelColor(7), 0x010101);
+  out.blend(a, b, 255);
+  CHECK_EQ(out.getPixelColor(9), 0x010101);
+}
+
+static void testBlur(void) {
+  for (uint16_t n : lengths()) {
+    std::vector<uint32_t> c = effectColors(n, n + 300);
+    for (uint8_t order : {DOTSTAR_BGR, DOTSTAR_RGB}) {
+      Adafruit_DotStar strip(n, order);
+      for (uint8_t amount : amounts) {
+        for (uint16_t first : {0, 1, 4}) {
+          for (uint16_t count : {0, 1, 2, 3, 9}) {
+            strip.setPixels(0, c.data(), n);
+            strip.blur(amount, first, count);
+            if (first >= n)
+              continue;
+            uint16_t end = (count && first + count < n) ? first + count : n;
+            std::vector<uint32_t> ref = c;
+            for (uint16_t i = first; i < end; i++)
+              ref[i] = refBlur(c[(i > first) ? i - 1 : i], c[i],
+                               c[(i + 1 < end) ? i + 1 : i], amount);
+            CHECK(sameColors(strip, ref, "blur", amount));
+          }
+        }
+      }
+    }
+  }
+}
+
+int main(void) {
+  testFade();
+  testBlendAdd();
+  testBlur();
+  return testResult("effects");
+}
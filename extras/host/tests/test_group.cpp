@@ -0,0 +1,212 @@
+// Adafruit_DotStarGroup: strips on the shared clock decode (from the mock
+// GPIO) to each strip's own frame padded to the longest, with power
+// limits and setOutput() applied as by the strip's own show(), and
+// interrupt handlers' changes to other pins on the port kept. Strips on
+// SPI buses of their own are each shown on a task, concurrently. Built
+// against both the digitalWrite() and the BUSIO_USE_FAST_PINIO library
+// variants.
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStarGroup.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+static const uint8_t CLOCK = 3;
+
+// A frame padded with 0xFF to a group's length
+static std::vector<uint8_t> padded(std::vector<uint8_t> f, uint32_t len) {
+  f.resize(len, 0xFF);
+  return f;
+}
+
+// Show the group once per strip, decoding that strip's data pin
+static std::vector<std::vector<uint8_t>>
+decodeGroup(Adafruit_DotStarGroup &group, const std::vector<uint8_t> &pins) {
+  std::vector<std::vector<uint8_t>> out;
+  for (uint8_t pin : pins) {
+    HostGPIO::reset();
+    HostGPIO::decode(pin, CLOCK);
+    group.show();
+    CHECK_EQ(HostGPIO::getPartialBits(), 0);
+    CHECK_EQ(HostGPIO::getEdges(CLOCK), HostGPIO::getDecoded().size() * 16);
+    CHECK_EQ(HostGPIO::get(CLOCK), LOW);
+    out.push_back(HostGPIO::getDecoded());
+  }
+  return out;
+}
+
+// Strips of different lengths, orders and brightness, on the data/clock
+// port or (data pin 40) another
+static void testClocked(void) {
+  for (uint8_t far : {4, 40}) {
+    const uint16_t len[] = {37, 5, 100};
+    const uint8_t order[] = {DOTSTAR_BGR, DOTSTAR_RGB, DOTSTAR_GBR},
+                  bright[] = {255, 60, 200};
+    std::vector<uint8_t> pins = {2, far, 6};
+    Adafruit_DotStarGroup group(CLOCK);
+    std::vector<std::vector<uint32_t>> colors;
+    for (int i = 0; i < 3; i++) {
+      Adafruit_DotStar *s = group.addStrip(len[i], pins[i], order[i]);
+      CHECK(s != NULL);
+      colors.push_back(testColors(len[i], i + 20));
+      s->setPixels(0, colors[i].data(), len[i]);
+      s->setBrightness(bright[i]);
+    }
+    group.begin();
+    CHECK_EQ(group.numStrips(), 3);
+    CHECK_EQ(group.numTasks(), 0);
+    CHECK_EQ(group.getFrameBytes(), (4 + 100 * 4 + 7 + 3) & ~3);
+
+    std::vector<std::vector<uint8_t>> out = decodeGroup(group, pins);
+    for (int i = 0; i < 3; i++)
+      CHECK_BYTES(out[i], padded(refFrame(colors[i], order[i], bright[i]),
+                                 group.getFrameBytes()));
+    CHECK(group.getStrip(0)->getPixelsEncoded() > 0);
+    CHECK(group.getStrip(3) == NULL);
+  }
+}
+
+// A power-limited strip issues what its own show() would, and a strip
+// with an output sends its unpadded frame there, holding its data pin
+// low unless SPI output was kept
+static void testStripOptions(void) {
+  HostSPIMock &mock = hostSPIMock();
+  const uint16_t n = 30;
+  std::vector<uint32_t> colors = testColors(n, 31);
+  Adafruit_DotStar alone(n, DOTSTAR_BGR);
+  alone.begin();
+  alone.setPixels(0, colors.data(), n);
+  alone.setPowerModel(20, 20, 20, 500);
+  alone.setPowerLimit(200);
+  mock.clear();
+  alone.show();
+  CHECK_EQ(alone.getFramesLimited(), 1);
+  std::vector<uint8_t> limited = mock.getData();
+
+  Adafruit_DotStarGroup group(CLOCK);
+  Adafruit_DotStar *a = group.addStrip(n, 2, DOTSTAR_BGR),
+                   *b = group.addStrip(n, 4, DOTSTAR_BGR);
+  group.begin();
+  a->setPixels(0, colors.data(), n);
+  a->setPowerModel(20, 20, 20, 500);
+  a->setPowerLimit(200);
+  b->setPixels(0, colors.data(), n);
+  Adafruit_DotStarCapture cap(b->getFrameBytes());
+  b->setOutput(&cap);
+
+  std::vector<std::vector<uint8_t>> out = decodeGroup(group, {2, 4});
+  CHECK_BYTES(out[0], padded(limited, group.getFrameBytes()));
+  CHECK_EQ(a->getFramesLimited(), 2);
+  CHECK_EQ(a->getFrameBrightness(), alone.getFrameBrightness());
+  CHECK_EQ(a->getFramePower(), alone.getFramePower());
+  CHECK_BYTES(out[1], std::vector<uint8_t>(group.getFrameBytes(), 0x00));
+  std::vector<uint8_t> ref = refFrame(colors, DOTSTAR_BGR);
+  CHECK_EQ(cap.getFrames(), 2);
+  CHECK_BYTES(std::vector<uint8_t>(cap.getFrame(),
+                                   cap.getFrame() + cap.getFrameLength()),
+              ref);
+
+  b->setOutput(&cap, true);
+  out = decodeGroup(group, {4});
+  CHECK_BYTES(out[0], padded(ref, group.getFrameBytes()));
+  b->setOutput(NULL);
+}
+
+// Simulated interrupt handler toggling another pin on the group's port
+static uint32_t toggles = 0;
+static void toggleISR(void) {
+  digitalWrite(5, !HostGPIO::get(5));
+  toggles++;
+}
+
+static void testInterrupts(void) {
+  const uint16_t n = 20;
+  std::vector<uint32_t> colors = testColors(n, 32);
+  Adafruit_DotStarGroup group(CLOCK);
+  group.addStrip(n, 2, DOTSTAR_RGB)->setPixels(0, colors.data(), n);
+  group.addStrip(n, 4, DOTSTAR_RGB)->setPixels(0, colors.data(), n);
+  group.begin();
+  std::vector<uint8_t> ref =
+      padded(refFrame(colors, DOTSTAR_RGB), group.getFrameBytes());
+  for (uint32_t every : {1, 3, 7, 100}) {
+    HostGPIO::reset();
+    HostGPIO::decode(4, CLOCK);
+    HostGPIO::setInterrupt(toggleISR, every);
+    toggles = 0;
+    group.show();
+    CHECK(toggles > 0);
+    CHECK_BYTES(HostGPIO::getDecoded(), ref);
+    CHECK_EQ(HostGPIO::getEdges(5), toggles);
+    CHECK_EQ(HostGPIO::get(5), toggles & 1);
+    CHECK(HostGPIO::interruptsEnabled());
+  }
+}
+
+// SPI backend that, on starting a transaction, waits (up to a few
+// seconds) for the other buses to start theirs: buses shown concurrently
+// all get there, while buses shown one after another would time out.
+static std::mutex barrierLock;
+static std::condition_variable barrierCV;
+static int arrived = 0, together = 0;
+static const int BUSES = 3;
+
+class BarrierSPI : public HostSPIMock {
+public:
+  void beginTransaction(uint32_t freq, uint8_t mode) {
+    std::unique_lock<std::mutex> lock(barrierLock);
+    if (++arrived == BUSES)
+      barrierCV.notify_all();
+    if (barrierCV.wait_for(lock, std::chrono::seconds(5),
+                           [] { return arrived >= BUSES; }))
+      together++;
+    lock.unlock();
+    HostSPIMock::beginTransaction(freq, mode);
+  }
+};
+
+// Strips on their own buses, alongside one on the shared clock
+static void testBuses(void) {
+  const uint16_t len[] = {50, 300, 7};
+  const uint8_t order[] = {DOTSTAR_BRG, DOTSTAR_RGB, DOTSTAR_BGR};
+  BarrierSPI dev[BUSES];
+  SPIClass bus[BUSES] = {SPIClass(&dev[0]), SPIClass(&dev[1]),
+                         SPIClass(&dev[2])};
+  Adafruit_DotStarGroup group(CLOCK);
+  std::vector<std::vector<uint32_t>> colors;
+  for (int i = 0; i < BUSES; i++) {
+    colors.push_back(testColors(len[i], i + 40));
+    Adafruit_DotStar *s = group.addStrip(len[i], &bus[i], order[i]);
+    CHECK(s != NULL);
+    s->setPixels(0, colors[i].data(), len[i]);
+  }
+  std::vector<uint32_t> c = testColors(10, 43);
+  group.addStrip(10, 2, DOTSTAR_BGR)->setPixels(0, c.data(), 10);
+  group.begin();
+  CHECK_EQ(group.numStrips(), 4);
+  CHECK_EQ(group.numTasks(), BUSES);
+  CHECK_EQ(group.getFrameBytes(), 4 + 300 * 4 + 19);
+
+  for (int frame = 0; frame < 2; frame++) {
+    for (int i = 0; i < BUSES; i++)
+      dev[i].clear();
+    arrived = together = 0;
+    std::vector<std::vector<uint8_t>> out = decodeGroup(group, {2});
+    CHECK_BYTES(out[0], padded(refFrame(c, DOTSTAR_BGR), 4 + 40 + 4));
+    for (int i = 0; i < BUSES; i++) {
+      CHECK_BYTES(dev[i].getData(), refFrame(colors[i], order[i]));
+      CHECK(!dev[i].inTransaction());
+    }
+    CHECK_EQ(together, BUSES);
+  }
+}
+
+int main(void) {
+  testClocked();
+  testStripOptions();
+  testInterrupts();
+  testBuses();
+  return testResult("group");
+}
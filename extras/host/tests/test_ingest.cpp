@@ -0,0 +1,250 @@
+// Adafruit_DotStarIngest: raw and Adalight frames land in the strip and
+// are shown, however the data is split across run() calls, with bad
+// Adalight headers skipped (resyncing on the next header, even one
+// starting inside the rejected bytes) and raw frames waiting for a strip
+// with pixels. Frames also come in from a file and over UDP through the
+// host Streams.
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStarIngest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Stream over a buffer that can be added to, one chunk at a time
+class ChunkStream : public Stream {
+public:
+  int available(void) { return limit - pos; }
+  int read(void) { return (pos < limit) ? data[pos++] : -1; }
+  int peek(void) { return (pos < limit) ? data[pos] : -1; }
+  size_t write(uint8_t) { return 0; }
+  // Make up to n more bytes available
+  void release(size_t n) {
+    limit = (limit + n < data.size()) ? limit + n : data.size();
+  }
+  std::vector<uint8_t> data;
+  size_t pos = 0, limit = 0;
+};
+
+static void addPixels(std::vector<uint8_t> &d,
+                      const std::vector<uint32_t> &c) {
+  for (uint32_t x : c) {
+    d.push_back(x >> 16);
+    d.push_back(x >> 8);
+    d.push_back(x);
+  }
+}
+
+static void testRaw(void) {
+  HostSPIMock &mock = hostSPIMock();
+  const uint16_t n = 25;
+  Adafruit_DotStar strip(n, DOTSTAR_BGR);
+  strip.begin();
+  ChunkStream in;
+  in.setTimeout(0);
+  std::vector<uint32_t> a = testColors(n, 1), b = testColors(n, 2);
+  addPixels(in.data, a);
+  addPixels(in.data, b);
+  Adafruit_DotStarIngest ingest(&strip, &in, DOTSTAR_INGEST_RAW);
+
+  // Dribbled in 7 bytes at a time: a frame completes on the call that
+  // receives its last pixel, and is shown
+  mock.clear();
+  int frames = 0;
+  for (int i = 0; i < 100 && frames < 2; i++) {
+    in.release(7);
+    if (ingest.run()) {
+      CHECK_BYTES(mock.getData(), refFrame(frames ? b : a, DOTSTAR_BGR));
+      mock.clear();
+      frames++;
+    }
+  }
+  CHECK_EQ(frames, 2);
+  CHECK_EQ(ingest.getFrames(), 2);
+  CHECK_EQ(ingest.getBytes(), n * 6);
+  CHECK(!ingest.run());
+}
+
+// A raw stream into an empty strip reads nothing (rather than completing
+// empty frames forever) until the strip has pixels.
+static void testRawEmpty(void) {
+  Adafruit_DotStar strip(0, DOTSTAR_RGB);
+  strip.begin();
+  ChunkStream in;
+  in.setTimeout(0);
+  std::vector<uint32_t> a = testColors(4, 3);
+  addPixels(in.data, a);
+  in.release(in.data.size());
+  Adafruit_DotStarIngest ingest(&strip, &in, DOTSTAR_INGEST_RAW);
+  ingest.setAutoShow(false);
+  for (int i = 0; i < 3; i++)
+    CHECK(!ingest.run());
+  CHECK_EQ(ingest.getFrames(), 0);
+  CHECK_EQ(ingest.getBytes(), 0);
+  CHECK_EQ(in.available(), 12);
+
+  strip.updateLength(4);
+  CHECK(ingest.run());
+  CHECK_EQ(ingest.getFrames(), 1);
+  for (uint16_t i = 0; i < 4; i++)
+    CHECK_EQ(strip.getPixelColor(i), a[i]);
+}
+
+static void adalight(std::vector<uint8_t> &d, uint16_t count, bool good) {
+  uint8_t hi = (count - 1) >> 8, lo = count - 1;
+  d.insert(d.end(), {'A', 'd', 'a', hi, lo});
+  d.push_back(hi ^ lo ^ (good ? 0x55 : 0xAA));
+}
+
+static void testAdalight(void) {
+  HostSPIMock &mock = hostSPIMock();
+  const uint16_t n = 10;
+  Adafruit_DotStar strip(n, DOTSTAR_GRB);
+  strip.begin();
+  ChunkStream in;
+  in.setTimeout(0);
+  std::vector<uint32_t> a = testColors(n, 4), b = testColors(14, 5),
+                        c = testColors(3, 6);
+  in.data = {'x', 'A', 'A', 'd'}; // Noise first
+  adalight(in.data, n, true);
+  addPixels(in.data, a);
+  adalight(in.data, n, false); // Bad checksum, skipped
+  adalight(in.data, 14, true); // Longer than the strip
+  addPixels(in.data, b);
+  adalight(in.data, 3, true); // Shorter
+  addPixels(in.data, c);
+  in.release(in.data.size());
+
+  Adafruit_DotStarIngest ingest(&strip, &in);
+  mock.clear();
+  CHECK(ingest.run());
+  CHECK_BYTES(mock.getData(), refFrame(a, DOTSTAR_GRB));
+  mock.clear();
+  CHECK(ingest.run());
+  b.resize(n);
+  CHECK_BYTES(mock.getData(), refFrame(b, DOTSTAR_GRB));
+  CHECK_EQ(ingest.getErrors(), 1);
+  CHECK(ingest.run());
+  for (uint16_t i = 0; i < n; i++)
+    CHECK_EQ(strip.getPixelColor(i), (i < 3) ? c[i] : b[i]);
+  CHECK(!ingest.run());
+  CHECK_EQ(ingest.getFrames(), 3);
+  CHECK_EQ(ingest.getBytes(), in.data.size());
+}
+
+// A header with a bad checksum mid-stream, its pixel data (sprinkled
+// with partial and whole "Ada"s) following, then good frames: each good
+// frame comes through, however the data is dribbled in, including one
+// whose header starts on the rejected header's count bytes.
+static void testResync(void) {
+  const uint16_t n = 8;
+  std::vector<uint32_t> a = testColors(n, 7), b = testColors(n, 8);
+  std::vector<uint8_t> data;
+  adalight(data, n, true);
+  addPixels(data, a);
+  adalight(data, n, false);
+  data.insert(data.end(), {'A', 1, 'A', 'd', 2, 'A', 'd', 'a', 0, 0, 0x77,
+                           'd', 'a', 'A'});
+  adalight(data, n, true);
+  addPixels(data, b);
+  // "AdaAda": rejected count and checksum bytes are a new header's start
+  data.insert(data.end(), {'A', 'd', 'a'});
+  adalight(data, n, true);
+  addPixels(data, a);
+
+  for (size_t step : {(size_t)1, (size_t)2, (size_t)5, data.size()}) {
+    Adafruit_DotStar strip(n, DOTSTAR_BGR);
+    strip.begin();
+    ChunkStream in;
+    in.setTimeout(0);
+    in.data = data;
+    Adafruit_DotStarIngest ingest(&strip, &in);
+    ingest.setAutoShow(false);
+    std::vector<std::vector<uint32_t>> got;
+    while (in.pos < data.size()) {
+      in.release(step);
+      while (ingest.run()) {
+        got.push_back({});
+        for (uint16_t i = 0; i < n; i++)
+          got.back().push_back(strip.getPixelColor(i));
+      }
+    }
+    CHECK_EQ(got.size(), 3);
+    for (size_t f = 0; f < got.size() && f < 3; f++)
+      for (uint16_t i = 0; i < n; i++)
+        CHECK_EQ(got[f][i], ((f == 1) ? b : a)[i]);
+    // The "Ada" (0, 0, 0x77) header, and the first of "AdaAda"
+    CHECK_EQ(ingest.getErrors(), 3);
+    CHECK_EQ(ingest.getBytes(), data.size());
+  }
+}
+
+// Adalight frames from a capture file, and from UDP datagrams that split
+// pixels between them
+static void testHostStreams(void) {
+  const uint16_t n = 50;
+  std::vector<std::vector<uint32_t>> frames;
+  std::vector<uint8_t> data;
+  for (int f = 0; f < 20; f++) {
+    frames.push_back(testColors(n, 100 + f));
+    adalight(data, n, true);
+    addPixels(data, frames.back());
+  }
+
+  char path[] = "/tmp/test_ingest_XXXXXX";
+  int fd = mkstemp(path);
+  CHECK(fd >= 0);
+  CHECK_EQ(write(fd, data.data(), data.size()), (ssize_t)data.size());
+  close(fd);
+  HostFileStream file(path);
+  CHECK(HostFileStream("/nonexistent/capture").failed());
+
+  HostUDPStream udp(0);
+  CHECK(!udp.failed());
+  CHECK(udp.getPort() != 0);
+  int tx = socket(AF_INET, SOCK_DGRAM, 0);
+  struct sockaddr_in to = {};
+  to.sin_family = AF_INET;
+  to.sin_port = htons(udp.getPort());
+  inet_pton(AF_INET, "127.0.0.1", &to.sin_addr);
+  const size_t mtu = 1000; // Not a multiple of 3, nor of a frame
+  for (size_t i = 0; i < data.size(); i += mtu)
+    sendto(tx, &data[i], std::min(mtu, data.size() - i), 0,
+           (struct sockaddr *)&to, sizeof(to));
+  close(tx);
+
+  for (Stream *in : {(Stream *)&file, (Stream *)&udp}) {
+    Adafruit_DotStar strip(n, DOTSTAR_RGB);
+    strip.begin();
+    in->setTimeout(0);
+    Adafruit_DotStarIngest ingest(&strip, in);
+    ingest.setAutoShow(false);
+    size_t f = 0;
+    for (int i = 0; i < 1000 && f < frames.size(); i++) {
+      if (!ingest.run())
+        continue;
+      bool same = true;
+      for (uint16_t p = 0; p < n; p++)
+        same = same && (strip.getPixelColor(p) == frames[f][p]);
+      CHECK(same);
+      f++;
+    }
+    CHECK_EQ(f, frames.size());
+    CHECK_EQ(ingest.getErrors(), 0);
+    CHECK_EQ(ingest.getBytes(), data.size());
+  }
+  CHECK_EQ(udp.getDatagrams(), (data.size() + mtu - 1) / mtu);
+  unlink(path);
+}
+
+int main(void) {
+  testRaw();
+  testRawEmpty();
+  testAdalight();
+  testResync();
+  testHostStreams();
+  return testResult("ingest");
+}
@@ -0,0 +1,157 @@
+// Adafruit_DotStarLarge beyond 65,535 pixels: pixels read back across
+// segment boundaries, fill() spans segments, and show() issues one frame
+// with the full (n + 15) / 16 byte end frame, byte-identical to the
+// reference encoder. Power limiting matches Adafruit_DotStar's, and a
+// Large strip can't be handed to code taking an Adafruit_DotStar (which
+// would see an empty strip).
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStarLarge.h>
+
+#include <type_traits>
+
+static_assert(!std::is_convertible<Adafruit_DotStarLarge *,
+                                   Adafruit_DotStar *>::value,
+              "Adafruit_DotStarLarge must not convert to Adafruit_DotStar");
+
+static void testLong(void) {
+  HostSPIMock &mock = hostSPIMock();
+  const uint32_t n = 70000, seg = DOTSTAR_SEGMENT_PIXELS;
+  Adafruit_DotStarLarge strip(n, DOTSTAR_BGR);
+  strip.begin();
+  CHECK_EQ(strip.numPixels(), n);
+  CHECK_EQ(strip.numSegments(), (n + seg - 1) / seg);
+  CHECK_EQ(strip.getFrameBytes(), 4 + n * 4 + 4375);
+
+  std::vector<uint32_t> colors = testColors(n, 21);
+  for (uint32_t i = 0; i < n; i++)
+    strip.setPixelColor(i, colors[i]);
+  bool same = true;
+  for (uint32_t i = 0; i < n; i++)
+    same = same && (strip.getPixelColor(i) == colors[i]);
+  CHECK(same);
+  CHECK_EQ(strip.getPixelColor(n), 0); // Out of range
+  strip.setPixelColor(n, 0xFFFFFF);    // Ignored
+
+  // Segment layout: pixel seg is the first of segment 1
+  const uint8_t *s1 = strip.getSegment(1);
+  CHECK(s1 != NULL);
+  CHECK_EQ(s1[2], (uint8_t)(colors[seg] >> 16)); // BGR: red last
+  CHECK(strip.getSegment(strip.numSegments()) == NULL);
+
+  for (uint8_t b : {255, 60}) {
+    strip.setBrightness(b);
+    mock.clear();
+    strip.show();
+    const std::vector<uint8_t> &d = mock.getData();
+    CHECK_EQ(d.size(), strip.getFrameBytes());
+    CHECK_EQ(mock.getTransactions(), 1);
+    CHECK_BYTES(d, refFrame(colors, DOTSTAR_BGR, b));
+    uint32_t ones = 0;
+    for (size_t i = 4 + n * 4; i < d.size(); i++)
+      ones += (d[i] == 0xFF);
+    CHECK_EQ(ones, 4375);
+  }
+  strip.setBrightness(255);
+
+  // fill() across segment boundaries, leaving neighbors alone
+  uint32_t first = seg - 3, count = 2 * seg + 10;
+  strip.fill(0x0A0B0C, first, count);
+  for (uint32_t i = first; i < first + count; i++)
+    colors[i] = 0x0A0B0C;
+  same = true;
+  for (uint32_t i = 0; i < n; i++)
+    same = same && (strip.getPixelColor(i) == colors[i]);
+  CHECK(same);
+  strip.fill(0x123456, n - 5); // To end of strip
+  for (uint32_t i = n - 5; i < n; i++)
+    colors[i] = 0x123456;
+  mock.clear();
+  strip.show();
+  CHECK_BYTES(mock.getData(), refFrame(colors, DOTSTAR_BGR));
+
+  strip.clear();
+  CHECK_EQ(strip.getPixelColor(first), 0);
+  CHECK_EQ(strip.getPixelColor(n - 1), 0);
+}
+
+// Resizing, up to a million pixels
+static void testLengths(void) {
+  HostSPIMock &mock = hostSPIMock();
+  mock.keepData(false);
+  Adafruit_DotStarLarge strip(0, DOTSTAR_RGB);
+  strip.begin();
+  CHECK_EQ(strip.numPixels(), 0);
+  for (uint32_t n : {1u, 65535u, 65536u, 1000000u}) {
+    strip.updateLength(n);
+    CHECK_EQ(strip.numPixels(), n);
+    CHECK_EQ(strip.getFrameBytes(), 4 + n * 4 + (n + 15) / 16);
+    strip.fill(0x010203);
+    CHECK_EQ(strip.getPixelColor(n - 1), 0x010203);
+    mock.clear();
+    strip.show();
+    CHECK_EQ(mock.getTransfers(),
+             1 + (n + 15) / 16 + ((n + 15) / 16 + 63) / 64);
+  }
+  mock.keepData(true);
+  strip.updateLength(0);
+  CHECK_EQ(strip.numPixels(), 0);
+  CHECK_EQ(strip.numSegments(), 0);
+
+  Adafruit_DotStarLarge mono(100, DOTSTAR_MONO);
+  CHECK_EQ(mono.numPixels(), 0);
+}
+
+template <typename S>
+static void setup(S &strip, uint32_t limit, bool hw, uint8_t bright) {
+  strip.setPowerModel(60, 55, 70, 500);
+  strip.setPowerLimit(limit);
+  strip.setHardwareBrightness(hw);
+  strip.setBrightness(bright);
+}
+
+// The same pixels, power model and limit give the same frames and
+// metrics as a regular strip, across segments
+static void testPower(void) {
+  HostSPIMock &mock = hostSPIMock();
+  const uint16_t n = DOTSTAR_SEGMENT_PIXELS * 2 + 100;
+  std::vector<uint32_t> colors = testColors(n, 22);
+  Adafruit_DotStar ref(n, DOTSTAR_BGR);
+  Adafruit_DotStarLarge large(n, DOTSTAR_BGR);
+  ref.begin();
+  large.begin();
+  ref.setPixels(0, colors.data(), n);
+  for (uint32_t i = 0; i < n; i++)
+    large.setPixelColor(i, colors[i]);
+  CHECK_EQ(large.getPowerEstimate(), 0); // No model yet
+
+  for (uint32_t limit : {0u, 100000u, 50000u, 5000u, 100u}) {
+    for (bool hw : {false, true}) {
+      for (uint8_t b : {255, 90}) {
+        setup(ref, limit, hw, b);
+        setup(large, limit, hw, b);
+        CHECK_EQ(large.getPowerEstimate(), ref.getPowerEstimate());
+        mock.clear();
+        ref.show();
+        std::vector<uint8_t> expect = mock.getData();
+        mock.clear();
+        large.show();
+        CHECK_BYTES(mock.getData(), expect);
+        CHECK_EQ(large.getFrameBrightness(), ref.getFrameBrightness());
+        CHECK_EQ(large.getFramePower(), ref.getFramePower());
+        CHECK_EQ(large.getFramesLimited(), ref.getFramesLimited());
+      }
+    }
+  }
+  CHECK(large.getFramesLimited() > 0);
+  large.setPowerModel(0, 0, 0, 0);
+  CHECK_EQ(large.getPowerEstimate(), 0);
+}
+
+int main(void) {
+  testLong();
+  testLengths();
+  testPower();
+  return testResult("large");
+}
@@ -0,0 +1,241 @@
+// Adafruit_DotStarLayout: setMatrix() maps every position as a strip laid
+// along the wiring would, for all corner, row/column and serpentine flags,
+// tiled panels and Adafruit_GFX-style rotations (spot-checked against
+// hand-drawn matrices), and refuses sizes that don't fit 16 bits. Drawing
+// writes the mapped pixels and touches exactly the span they cover.
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStarLayout.h>
+
+// Exposes the dirty span that drawing touches
+class DirtyProbe : public Adafruit_DotStar {
+public:
+  DirtyProbe(uint16_t n) : Adafruit_DotStar(n, DOTSTAR_BGR) {}
+  uint16_t first(void) const { return dirtyFirst; }
+  uint16_t end(void) const { return dirtyEnd; }
+  void clean(void) {
+    dirtyFirst = numPixels();
+    dirtyEnd = 0;
+  }
+};
+
+// Position of the k-th pixel of a w x h grid, walking it as the flags say
+// the strip is laid: along rows or columns from the given corner, every
+// other one reversed if serpentine
+static void walk(uint32_t k, uint16_t w, uint16_t h, uint8_t flags,
+                 uint32_t &x, uint32_t &y) {
+  bool cols = flags & DOTSTAR_LAYOUT_COLUMNS;
+  uint32_t len = cols ? h : w, major = k / len, minor = k % len;
+  if ((flags & DOTSTAR_LAYOUT_ZIGZAG) && (major & 1))
+    minor = len - 1 - minor;
+  x = cols ? major : minor;
+  y = cols ? minor : major;
+  if (flags & DOTSTAR_LAYOUT_RIGHT)
+    x = w - 1 - x;
+  if (flags & DOTSTAR_LAYOUT_BOTTOM)
+    y = h - 1 - y;
+}
+
+// Expected map: lay the strip tile by tile, then view the result as
+// Adafruit_GFX does after setRotation(), where drawing at (x, y) lands on
+// the unrotated panel at rotation 1: (W-1-y, x), 2: (W-1-x, H-1-y),
+// 3: (y, H-1-x)
+static std::vector<uint16_t> refMatrix(uint16_t w, uint16_t h, uint8_t flags,
+                                       uint8_t rotation, uint8_t tx,
+                                       uint8_t ty) {
+  uint32_t W = w * tx, H = h * ty, x, y, px, py;
+  std::vector<uint16_t> panel(W * H), out(W * H);
+  for (uint32_t t = 0; t < (uint32_t)tx * ty; t++) {
+    walk(t, tx, ty, flags >> 4, x, y);
+    for (uint32_t k = 0; k < (uint32_t)w * h; k++) {
+      walk(k, w, h, flags, px, py);
+      panel[(y * h + py) * W + x * w + px] = t * w * h + k;
+    }
+  }
+  uint32_t rw = (rotation & 1) ? H : W, rh = (rotation & 1) ? W : H;
+  for (y = 0; y < rh; y++) {
+    for (x = 0; x < rw; x++) {
+      uint32_t ux = x, uy = y;
+      if (rotation == 1) {
+        ux = W - 1 - y;
+        uy = x;
+      } else if (rotation == 2) {
+        ux = W - 1 - x;
+        uy = H - 1 - y;
+      } else if (rotation == 3) {
+        ux = y;
+        uy = H - 1 - x;
+      }
+      out[y * rw + x] = panel[uy * W + ux];
+    }
+  }
+  return out;
+}
+
+static std::vector<uint16_t> getMap(const Adafruit_DotStarLayout &layout) {
+  std::vector<uint16_t> m;
+  for (int16_t y = 0; y < layout.height(); y++)
+    for (int16_t x = 0; x < layout.width(); x++)
+      m.push_back(layout.getIndex(x, y));
+  return m;
+}
+
+static bool sameMap(const Adafruit_DotStarLayout &layout,
+                    const std::vector<uint16_t> &ref, const char *what) {
+  if (getMap(layout) == ref)
+    return true;
+  fprintf(stderr, "  %s: map differs\n", what);
+  return false;
+}
+
+// A few matrices drawn out by hand, 3 wide and 2 high unless rotated
+static void testExamples(void) {
+  Adafruit_DotStar strip(12, DOTSTAR_BGR);
+  Adafruit_DotStarLayout layout(&strip);
+  struct {
+    uint8_t flags, rotation, tx, ty;
+    std::vector<uint16_t> map;
+  } examples[] = {
+      {DOTSTAR_LAYOUT_ROWS, 0, 1, 1, {0, 1, 2, 3, 4, 5}},
+      {DOTSTAR_LAYOUT_ZIGZAG, 0, 1, 1, {0, 1, 2, 5, 4, 3}},
+      {DOTSTAR_LAYOUT_BOTTOM + DOTSTAR_LAYOUT_RIGHT + DOTSTAR_LAYOUT_COLUMNS,
+       0, 1, 1, {5, 3, 1, 4, 2, 0}},
+      {DOTSTAR_LAYOUT_COLUMNS + DOTSTAR_LAYOUT_ZIGZAG, 0, 1, 1,
+       {0, 3, 4, 1, 2, 5}},
+      // Rotated: 2 wide, 3 high
+      {DOTSTAR_LAYOUT_ROWS, 1, 1, 1, {2, 5, 1, 4, 0, 3}},
+      {DOTSTAR_LAYOUT_ROWS, 2, 1, 1, {5, 4, 3, 2, 1, 0}},
+      {DOTSTAR_LAYOUT_ROWS, 3, 1, 1, {3, 0, 4, 1, 5, 2}},
+      // Two 3x2 serpentine tiles side by side, from the right
+      {DOTSTAR_LAYOUT_ZIGZAG + DOTSTAR_LAYOUT_TILE_RIGHT, 0, 2, 1,
+       {6, 7, 8, 0, 1, 2, 11, 10, 9, 5, 4, 3}},
+  };
+  for (auto &e : examples) {
+    CHECK(layout.setMatrix(3, 2, e.flags, e.rotation, e.tx, e.ty));
+    CHECK_EQ(layout.width(), ((e.rotation & 1) ? 2 : 3 * e.tx));
+    CHECK(sameMap(layout, e.map, "example"));
+  }
+}
+
+// Every combination of flags and rotation, on single panels and grids of
+// tiles
+static void testAllFlags(void) {
+  Adafruit_DotStar strip(10, DOTSTAR_BGR);
+  Adafruit_DotStarLayout layout(&strip);
+  const uint8_t sizes[][4] = {{1, 1, 1, 1}, {5, 3, 1, 1}, {4, 4, 1, 1},
+                              {3, 2, 3, 2}, {2, 5, 2, 4}, {1, 7, 4, 1}};
+  char what[80];
+  for (auto &s : sizes) {
+    for (uint16_t flags = 0; flags < 256; flags++) {
+      for (uint8_t rot = 0; rot < 4; rot++) {
+        snprintf(what, sizeof(what), "%ux%u, %ux%u tiles, flags 0x%02X, "
+                 "rotation %u", s[0], s[1], s[2], s[3], flags, rot);
+        CHECK(layout.setMatrix(s[0], s[1], flags, rot, s[2], s[3]));
+        CHECK(sameMap(layout, refMatrix(s[0], s[1], flags, rot, s[2], s[3]),
+                      what));
+      }
+    }
+  }
+  // Out of range positions have no pixel
+  CHECK_EQ(layout.getIndex(-1, 0), DOTSTAR_LAYOUT_NONE);
+  CHECK_EQ(layout.getIndex(0, layout.height()), DOTSTAR_LAYOUT_NONE);
+}
+
+// Matrices more than 65535 across or down (in total, over the tiles) are
+// refused rather than wrapping to a small size, and leave no layout
+static void testLimits(void) {
+  Adafruit_DotStar strip(10, DOTSTAR_BGR);
+  Adafruit_DotStarLayout layout(&strip);
+  CHECK(!layout.setMatrix(0, 5, 0));
+  CHECK(!layout.setMatrix(4096, 1, 0, 0, 16, 1)); // 65536 wraps to 0
+  CHECK(!layout.setMatrix(1000, 2, 0, 0, 66, 1)); // 66000 wraps to 464
+  CHECK(!layout.setMatrix(1, 300, 0, 1, 1, 255)); // 76500 wraps to 10964
+  CHECK(!layout.setMatrix(65535, 1, 0, 0, 2, 1));
+  CHECK(layout.setMatrix(257, 1, 0, 1, 255, 1)); // 65535 fits
+  CHECK_EQ(layout.width(), 1);
+  CHECK_EQ(layout.height(), 65535);
+  CHECK_EQ(layout.getIndex(0, 0), 65534);
+  // Indices past the end of the strip still map, but don't draw
+  layout.drawPixel(0, 0, 0xFFFFFF);
+  CHECK_EQ(strip.getPixelColor(9), 0);
+}
+
+// Drawing sets the mapped pixels, and touches exactly the span from the
+// lowest to the highest pixel drawn (none for positions without one)
+static void testDraw(void) {
+  const uint16_t n = 60;
+  DirtyProbe strip(n);
+  Adafruit_DotStarLayout layout(&strip);
+  CHECK(layout.setMatrix(4, 5, DOTSTAR_LAYOUT_ZIGZAG + DOTSTAR_LAYOUT_COLUMNS,
+                         1, 2, 2)); // 10 wide, 8 high; 80 positions
+  std::vector<uint32_t> img = testColors(10 * 8, 50);
+  struct {
+    int16_t x, y;
+    uint16_t w, h;
+  } rects[] = {{0, 0, 10, 8}, {-3, -2, 6, 5}, {7, 6, 9, 9}, {2, 3, 1, 1},
+               {4, 0, 1, 8},  {0, 5, 10, 1},  {10, 0, 2, 2}, {-5, 1, 5, 3}};
+  for (auto &r : rects) {
+    for (int mode = 0; mode < 3; mode++) { // drawImage, fillRect, column
+      strip.clear();
+      strip.clean();
+      std::vector<uint32_t> expect(n, 0);
+      uint32_t lo = 0xFFFF, hi = 0;
+      for (int16_t y = r.y; y < r.y + r.h; y++) {
+        for (int16_t x = r.x; x < r.x + r.w; x++) {
+          if ((mode == 2) && (x != r.x))
+            continue;
+          uint16_t i = layout.getIndex(x, y);
+          if (i >= n)
+            continue;
+          uint32_t k = (uint32_t)(y - r.y) * r.w + (x - r.x);
+          expect[i] = (mode == 1) ? 0x123456 : img[k % img.size()];
+          lo = std::min(lo, (uint32_t)i);
+          hi = std::max(hi, (uint32_t)i);
+        }
+      }
+      std::vector<uint32_t> src(r.w * r.h);
+      for (size_t k = 0; k < src.size(); k++)
+        src[k] = img[k % img.size()];
+      if (mode == 0) {
+        layout.drawImage(r.x, r.y, r.w, r.h, src.data());
+      } else if (mode == 1) {
+        layout.fillRect(r.x, r.y, r.w, r.h, 0x123456);
+      } else { // Column of an image r.w wide, stepping through rows
+        std::vector<uint32_t> col;
+        for (uint16_t y = 0; y < r.h; y++)
+          col.push_back(src[y * r.w]);
+        layout.drawColumn(r.x, r.y, col.data(), r.h);
+      }
+      bool same = true;
+      for (uint16_t i = 0; i < n; i++)
+        same = same && (strip.getPixelColor(i) == expect[i]);
+      CHECK(same);
+      if (lo <= hi) {
+        CHECK_EQ(strip.first(), lo);
+        CHECK_EQ(strip.end(), hi + 1);
+      } else {
+        CHECK(!strip.isDirty());
+      }
+    }
+  }
+  // Single pixels and rows
+  strip.clean();
+  layout.drawPixel(3, 4, 0xABCDEF);
+  uint16_t i = layout.getIndex(3, 4);
+  CHECK_EQ(layout.getPixel(3, 4), 0xABCDEF);
+  CHECK_EQ(strip.first(), i);
+  CHECK_EQ(strip.end(), i + 1);
+  layout.drawRow(-2, 7, img.data(), 12);
+  for (int16_t x = 0; x < 10; x++)
+    if (layout.getIndex(x, 7) < n)
+      CHECK_EQ(layout.getPixel(x, 7), img[x + 2]);
+}
+
+int main(void) {
+  testExamples();
+  testAllFlags();
+  testLimits();
+  testDraw();
+  return testResult("layout");
+}
@@ -0,0 +1,199 @@
+// DOTSTAR_MONO strips: packed 10-bit storage round-trips, fill(), shift()
+// and rotate() on packed pixels, and the wire output of show(), the frame
+// buffer and showAsync().
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStar.h>
+
+// Exposes the buffer size for checking the packed layout
+class MonoProbe : public Adafruit_DotStar {
+public:
+  MonoProbe(uint16_t n) : Adafruit_DotStar(n, DOTSTAR_MONO) {}
+  using Adafruit_DotStar::bufferBytes;
+};
+
+static std::vector<uint16_t> testLevels(size_t n, uint32_t seed) {
+  std::vector<uint32_t> c = testColors(n, seed);
+  std::vector<uint16_t> l(n);
+  for (size_t i = 0; i < n; i++)
+    l[i] = c[i] & 1023;
+  return l;
+}
+
+// Levels read back exactly, the buffer holds the upper 8 bits of each
+// then the lower 2 bits packed four per byte, and changing one pixel
+// leaves its neighbors (which share a byte of low bits) alone.
+static void testPacking(void) {
+  for (uint16_t n : {1, 2, 3, 4, 5, 37, 300}) {
+    MonoProbe strip(n);
+    CHECK_EQ(strip.numPixels(), n);
+    CHECK_EQ(strip.bufferBytes(n), n + (n + 3) / 4);
+    std::vector<uint16_t> l = testLevels(n, n);
+    for (uint16_t i = 0; i < n; i++)
+      strip.setPixelLevel(i, l[i]);
+    const uint8_t *p = strip.getPixels();
+    for (uint16_t i = 0; i < n; i++) {
+      CHECK_EQ(strip.getPixelLevel(i), l[i]);
+      CHECK_EQ(p[i], l[i] >> 2);
+      CHECK_EQ((p[n + i / 4] >> ((i % 4) * 2)) & 3, l[i] & 3);
+    }
+    // Rewrite every pixel (in a scrambled order) with every low-bit
+    // pattern, checking all others each time
+    for (uint16_t k = 0; k < n; k++) {
+      uint16_t i = (k * 7) % n, v = 1023 - l[i];
+      strip.setPixelLevel(i, v);
+      l[i] = v;
+      for (uint16_t j = 0; j < n; j++)
+        CHECK_EQ(strip.getPixelLevel(j), l[j]);
+    }
+  }
+
+  Adafruit_DotStar strip(10, DOTSTAR_MONO);
+  strip.setPixelLevel(3, 5000); // Clipped
+  CHECK_EQ(strip.getPixelLevel(3), 1023);
+  strip.setPixelLevel(10, 1); // Out of range, ignored
+  CHECK_EQ(strip.getPixelLevel(10), 0);
+  // RGB functions use the largest component, 255 -> 1023
+  strip.setPixelColor(4, 0x102030);
+  CHECK_EQ(strip.getPixelLevel(4), (0x30 << 2) | (0x30 >> 6));
+  CHECK_EQ(strip.getPixelColor(4), 0x303030);
+  strip.setPixelColor(5, 0xFF0000);
+  CHECK_EQ(strip.getPixelLevel(5), 1023);
+  strip.fill(0x000080, 6, 2);
+  CHECK_EQ(strip.getPixelLevel(6), 0x202);
+  CHECK_EQ(strip.getPixelLevel(7), 0x202);
+  CHECK_EQ(strip.getPixelLevel(8), 0);
+  strip.clear();
+  for (uint16_t i = 0; i < 10; i++)
+    CHECK_EQ(strip.getPixelLevel(i), 0);
+}
+
+// fill() over every alignment of a range against the packed low-bit
+// bytes sets exactly the pixels in the range.
+static void testFill(void) {
+  const uint16_t n = 19;
+  std::vector<uint16_t> l = testLevels(n, 5);
+  for (uint16_t first = 0; first < n; first++) {
+    for (uint16_t count = 0; first + count <= n; count++) {
+      Adafruit_DotStar strip(n, DOTSTAR_MONO);
+      for (uint16_t i = 0; i < n; i++)
+        strip.setPixelLevel(i, l[i]);
+      strip.fill(0x0000FF - first, first, count); // 0 = to end
+      uint16_t end = count ? first + count : n,
+               v = ((0xFF - first) << 2) | ((0xFF - first) >> 6);
+      bool ok = true;
+      for (uint16_t i = 0; i < n; i++)
+        ok = ok && (strip.getPixelLevel(i) ==
+                    ((i >= first && i < end) ? v : l[i]));
+      if (!ok)
+        fprintf(stderr, "  fill(%u, %u)\n", first, count);
+      CHECK(ok);
+    }
+  }
+}
+
+// shift() and rotate() move 10-bit levels intact across the packed
+// low-bit bytes, for counts in both directions and beyond the length.
+static void testMove(void) {
+  const uint16_t n = 23;
+  std::vector<uint16_t> l = testLevels(n, 99);
+  for (int32_t k : {1, 3, 4, 5, 11, 22, 23, 40, -1, -4, -9, -23, -50}) {
+    Adafruit_DotStar a(n, DOTSTAR_MONO), b(n, DOTSTAR_MONO);
+    for (uint16_t i = 0; i < n; i++) {
+      a.setPixelLevel(i, l[i]);
+      b.setPixelLevel(i, l[i]);
+    }
+    a.rotate(k);
+    b.shift(k, 0x000000);
+    int32_t r = ((k % n) + n) % n;
+    for (int32_t i = 0; i < n; i++) {
+      CHECK_EQ(a.getPixelLevel((i + r) % n), l[i]);
+      int32_t j = i - k; // Shifted pixel i came from j, if on the strip
+      CHECK_EQ(b.getPixelLevel(i), (j >= 0 && j < n) ? l[j] : 0);
+    }
+  }
+}
+
+// Check one pixel's wire bytes for a level at a brightness: header 0xFF,
+// the level spread over the three channels, which differ by at most 1
+// (largest first) and sum to level * 765 / 1023 to within rounding.
+static bool monoPixelOK(const uint8_t *px, uint16_t level, uint8_t bright) {
+  uint32_t v = (bright == 255) ? level : (level * (bright + 1u)) >> 8;
+  int32_t t = px[1] + px[2] + px[3], err = t * 1023 - (int32_t)v * 765;
+  return (px[0] == 0xFF) && (px[1] >= px[2]) && (px[2] >= px[3]) &&
+         (px[1] - px[3] <= 1) && (2 * err <= 1023) && (2 * err >= -1023);
+}
+
+// Frame layout and per-pixel encoding of show(), and the same bytes from
+// the frame buffer and showAsync().
+static void testWire(void) {
+  HostSPIMock &mock = hostSPIMock();
+  const uint16_t n = 1024;
+  Adafruit_DotStar strip(n, DOTSTAR_MONO);
+  strip.begin();
+  for (uint16_t i = 0; i < n; i++)
+    strip.setPixelLevel(i, i);
+
+  for (uint8_t b : {255, 128, 7}) {
+    strip.setBrightness(b);
+    mock.clear();
+    strip.show();
+    const std::vector<uint8_t> &d = mock.getData();
+    CHECK_EQ(d.size(), strip.getFrameBytes());
+    CHECK_EQ(d[0] | d[1] | d[2] | d[3], 0);
+    bool ok = true;
+    int32_t prev = -1;
+    for (uint16_t i = 0; i < n; i++) {
+      const uint8_t *px = &d[4 + i * 4];
+      ok = ok && monoPixelOK(px, i, b);
+      int32_t t = px[1] + px[2] + px[3];
+      ok = ok && (t >= prev); // Monotonic in level
+      prev = t;
+    }
+    CHECK(ok);
+    CHECK_EQ(prev, (b == 255) ? 765 : prev);
+    for (size_t i = 4 + n * 4; i < d.size(); i++)
+      CHECK_EQ(d[i], 0xFF);
+    std::vector<uint8_t> chunked = d;
+
+    strip.setFrameBuffer(true);
+    mock.clear();
+    strip.show();
+    CHECK_BYTES(mock.getData(), chunked);
+    strip.setFrameBuffer(false);
+
+    // showAsync() issues the frame as it was, though the buffer changes
+    // while it's in progress
+    mock.clear();
+    CHECK(strip.showAsync());
+    for (uint16_t i = 0; i < n; i++)
+      strip.setPixelLevel(i, 1023 - i);
+    strip.waitForShow();
+    CHECK_BYTES(mock.getData(), chunked);
+    for (uint16_t i = 0; i < n; i++)
+      strip.setPixelLevel(i, i);
+  }
+
+  // 5-bit hardware brightness: levels issued unscaled, brightness in the
+  // header
+  strip.setBrightness(127);
+  strip.setHardwareBrightness(true);
+  mock.clear();
+  strip.show();
+  bool ok = true;
+  for (uint16_t i = 0; i < n; i++) {
+    const uint8_t *px = &mock.getData()[4 + i * 4];
+    uint8_t hdr[4] = {0xFF, px[1], px[2], px[3]};
+    ok = ok && (px[0] == (0xE0 | 16)) && monoPixelOK(hdr, i, 255);
+  }
+  CHECK(ok);
+}
+
+int main(void) {
+  testPacking();
+  testFill();
+  testMove();
+  testWire();
+  return testResult("mono");
+}
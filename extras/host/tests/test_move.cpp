@@ -0,0 +1,128 @@
+// shift() and rotate() on every pixel format, against a simple model,
+// including counts beyond the strip length and the extremes of int32_t,
+// and rotations of a long strip both by stashing and by reversal.
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStar.h>
+
+// A strip in each storage format: RGB, MONO, 8- and 4-bit palette
+static void setup(Adafruit_DotStar &strip, uint8_t bits) {
+  if (bits) {
+    CHECK(strip.setPaletteMode(bits));
+    for (uint16_t i = 0; i < (1 << bits); i++)
+      strip.setPaletteColor(i, i * 0x010101);
+  }
+}
+
+// Expected pixel i after shift (or rotate) of a strip whose pixel j was
+// value j + 1, with 0 for vacated pixels.
+static uint32_t expected(int64_t i, int64_t k, uint16_t n, bool wrap) {
+  int64_t j = i - k;
+  if (wrap)
+    j = ((j % n) + n) % n;
+  return (j >= 0 && j < n) ? j + 1 : 0;
+}
+
+static void testCounts(void) {
+  const uint16_t n = 13;
+  const int32_t counts[] = {1,          -1,        5,         -5,
+                            12,         -12,       13,        -13,
+                            14,         -14,       40,        -40,
+                            INT32_MAX,  INT32_MIN, INT32_MIN + 1};
+  for (uint8_t bits : {0, 4, 8, 10}) { // 10 = MONO
+    for (bool wrap : {false, true}) {
+      for (int32_t k : counts) {
+        Adafruit_DotStar strip(n, (bits == 10) ? DOTSTAR_MONO : DOTSTAR_BGR);
+        setup(strip, (bits == 10) ? 0 : bits);
+        for (uint16_t i = 0; i < n; i++) {
+          if (bits == 10)
+            strip.setPixelLevel(i, i + 1);
+          else if (bits)
+            strip.setPixelIndex(i, i + 1);
+          else
+            strip.setPixelColor(i, i + 1);
+        }
+        if (wrap)
+          strip.rotate(k);
+        else
+          strip.shift(k, 0);
+        bool ok = true;
+        for (uint16_t i = 0; i < n; i++) {
+          uint32_t v = (bits == 10) ? strip.getPixelLevel(i)
+                       : bits       ? strip.getPixelIndex(i)
+                                    : strip.getPixelColor(i);
+          ok = ok && (v == expected(i, k, n, wrap));
+        }
+        if (!ok)
+          fprintf(stderr, "  bits %u, %s(%d)\n", bits,
+                  wrap ? "rotate" : "shift", k);
+        CHECK(ok);
+      }
+    }
+  }
+}
+
+// A long strip rotated by counts up to and beyond the stack stash
+// (DOTSTAR_CHUNK_PIXELS), on either side of half the length
+static void testLong(void) {
+  const uint16_t n = 1001;
+  const int32_t counts[] = {1,   -1,  DOTSTAR_CHUNK_PIXELS,
+                            -DOTSTAR_CHUNK_PIXELS, DOTSTAR_CHUNK_PIXELS + 1,
+                            100, -100, 500, 501, -500, 999, n + 37};
+  for (uint8_t bits : {0, 4, 8, 10}) { // 10 = MONO
+    uint32_t mask = (bits == 10) ? 1023 : bits ? (1u << bits) - 1 : 0xFFFFFF;
+    std::vector<uint32_t> v = testColors(n, bits + 1);
+    for (uint32_t &x : v)
+      x &= mask;
+    for (int32_t k : counts) {
+      Adafruit_DotStar strip(n, (bits == 10) ? DOTSTAR_MONO : DOTSTAR_BGR);
+      setup(strip, (bits == 10) ? 0 : bits);
+      for (uint16_t i = 0; i < n; i++) {
+        if (bits == 10)
+          strip.setPixelLevel(i, v[i]);
+        else if (bits)
+          strip.setPixelIndex(i, v[i]);
+        else
+          strip.setPixelColor(i, v[i]);
+      }
+      strip.rotate(k);
+      int32_t r = ((k % n) + n) % n;
+      bool ok = true;
+      for (uint16_t i = 0; i < n; i++) {
+        uint32_t x = (bits == 10) ? strip.getPixelLevel((i + r) % n)
+                     : bits       ? strip.getPixelIndex((i + r) % n)
+                                  : strip.getPixelColor((i + r) % n);
+        ok = ok && (x == v[i]);
+      }
+      if (!ok)
+        fprintf(stderr, "  bits %u, rotate(%d)\n", bits, k);
+      CHECK(ok);
+    }
+  }
+}
+
+// Vacated pixels take the given color; nothing happens on an empty strip
+static void testFill(void) {
+  Adafruit_DotStar strip(8, DOTSTAR_RGB);
+  strip.fill(0x112233);
+  strip.shift(INT32_MIN, 0x445566);
+  for (uint16_t i = 0; i < 8; i++)
+    CHECK_EQ(strip.getPixelColor(i), 0x445566);
+  strip.setPixelColor(0, 0x010203);
+  strip.shift(3, 0xABCDEF);
+  CHECK_EQ(strip.getPixelColor(2), 0xABCDEF);
+  CHECK_EQ(strip.getPixelColor(3), 0x010203);
+
+  Adafruit_DotStar empty(0, DOTSTAR_RGB);
+  empty.shift(INT32_MIN, 0xFFFFFF);
+  empty.rotate(INT32_MIN);
+  CHECK_EQ(empty.numPixels(), 0);
+}
+
+int main(void) {
+  testCounts();
+  testLong();
+  testFill();
+  return testResult("move");
+}
@@ -0,0 +1,158 @@
+// Adafruit_DotStarPlayer: an animation baked with Adafruit_DotStarRecorder
+// plays back byte-for-byte to the SPI device. From an
+// Adafruit_DotStarMemoryStream the data is block-copied, never read a
+// byte at a time (Stream::readBytes() isn't virtual here, as on AVR),
+// including over a file mmap()ed in place of PROGMEM.
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStarPlayer.h>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Print to a growing block of memory, standing in for a file
+class MemoryPrint : public Print {
+public:
+  size_t write(uint8_t b) {
+    data.push_back(b);
+    return 1;
+  }
+  size_t write(const uint8_t *buf, size_t len) {
+    data.insert(data.end(), buf, buf + len);
+    return len;
+  }
+  std::vector<uint8_t> data;
+};
+
+// Memory stream counting single-byte reads
+class CountingStream : public Adafruit_DotStarMemoryStream {
+public:
+  CountingStream(const uint8_t *data, uint32_t len, bool progmem = true)
+      : Adafruit_DotStarMemoryStream(data, len, progmem) {}
+  int read(void) {
+    reads++;
+    return Adafruit_DotStarMemoryStream::read();
+  }
+  uint32_t reads = 0;
+};
+
+static const int FRAMES = 12;
+
+// Record FRAMES frames of a changing rainbow, keeping the wire bytes of each
+static void bake(Adafruit_DotStar &strip, MemoryPrint &asset,
+                 std::vector<std::vector<uint8_t>> &wire) {
+  HostSPIMock &mock = hostSPIMock();
+  Adafruit_DotStarRecorder rec(&asset, strip.getFrameBytes());
+  strip.setOutput(&rec, true);
+  for (int f = 0; f < FRAMES; f++) {
+    strip.rainbow(f * 4096);
+    strip.setPixelColor(f, 0xFFFFFF);
+    mock.clear();
+    strip.show();
+    wire.push_back(mock.getData());
+  }
+  strip.setOutput(NULL);
+}
+
+static void testPlay(void) {
+  HostSPIMock &mock = hostSPIMock();
+  const uint16_t n = 60;
+  Adafruit_DotStar strip(n, DOTSTAR_BGR);
+  strip.begin();
+  MemoryPrint asset;
+  std::vector<std::vector<uint8_t>> wire;
+  bake(strip, asset, wire);
+
+  // Memory stream: bulk copies only
+  CountingStream mem(asset.data.data(), asset.data.size());
+  Adafruit_DotStarPlayer player(&strip, &mem);
+  for (int f = 0; f < FRAMES; f++) {
+    mock.clear();
+    CHECK(player.show());
+    CHECK_BYTES(mock.getData(), wire[f]);
+  }
+  CHECK(!player.show());
+  CHECK(!player.error());
+  CHECK_EQ(mem.reads, 0);
+
+  // Same through the Stream interface, which reads bytes one at a time
+  mem.rewind();
+  mem.reads = 0;
+  Adafruit_DotStarPlayer slow(&strip, (Stream *)&mem);
+  for (int f = 0; f < FRAMES; f++) {
+    mock.clear();
+    CHECK(slow.show());
+    CHECK_BYTES(mock.getData(), wire[f]);
+  }
+  CHECK(!slow.show());
+  CHECK(mem.reads >= asset.data.size());
+
+  // Replay over a memory stream takes the same path
+  mem.rewind();
+  mem.reads = 0;
+  Adafruit_DotStarReplay replay(&mem, strip.getFrameBytes());
+  for (int f = 0; f < FRAMES; f++) {
+    CHECK(replay.read());
+    CHECK_BYTES(std::vector<uint8_t>(replay.getFrame(),
+                                     replay.getFrame() +
+                                         replay.getFrameLength()),
+                wire[f]);
+  }
+  CHECK(!replay.read());
+  CHECK(!replay.error());
+  CHECK_EQ(mem.reads, 0);
+
+  // Looping: rewind and reset
+  mem.rewind();
+  player.reset();
+  mock.clear();
+  CHECK(player.show());
+  CHECK_BYTES(mock.getData(), wire[0]);
+}
+
+// An asset written to a file and mmap()ed, as on a Linux host, plays
+// from the mapping as from PROGMEM: straight out of the page cache.
+static void testMapped(void) {
+  HostSPIMock &mock = hostSPIMock();
+  Adafruit_DotStar strip(100, DOTSTAR_GRB);
+  strip.begin();
+  strip.setBrightness(80);
+  MemoryPrint asset;
+  std::vector<std::vector<uint8_t>> wire;
+  bake(strip, asset, wire);
+
+  char path[] = "/tmp/test_player_XXXXXX";
+  int fd = mkstemp(path);
+  CHECK(fd >= 0);
+  CHECK_EQ(write(fd, asset.data.data(), asset.data.size()),
+           asset.data.size());
+  void *map = mmap(NULL, asset.data.size(), PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  unlink(path); // The mapping keeps the data
+  CHECK(map != MAP_FAILED);
+  if (map == MAP_FAILED)
+    return;
+
+  CountingStream mem((const uint8_t *)map, asset.data.size(), false);
+  Adafruit_DotStarPlayer player(&strip, &mem);
+  for (int loop = 0; loop < 2; loop++) {
+    for (int f = 0; f < FRAMES; f++) {
+      mock.clear();
+      CHECK(player.show());
+      CHECK_BYTES(mock.getData(), wire[f]);
+    }
+    CHECK(!player.show());
+    CHECK(!player.error());
+    mem.rewind();
+    player.reset();
+  }
+  CHECK_EQ(mem.reads, 0);
+  munmap(map, asset.data.size());
+}
+
+int main(void) {
+  testPlay();
+  testMapped();
+  return testResult("player");
+}
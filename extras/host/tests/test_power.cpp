@@ -0,0 +1,157 @@
+// Power estimation and limiting: when a frame is dimmed to fit the power
+// limit, its wire bytes are exactly those of the same frame shown at the
+// lowered brightness, including with gamma correction and white balance
+// (which go through the output lookup table) and whether issued by show(),
+// the frame buffer, showAsync() or Adafruit_DotStarRender. Built against
+// both the serial and the ESP32 (worker task) library variants. With
+// hardware brightness, the current of what's issued (5-bit header levels)
+// stays within the limit. clear() keeps the estimate right, palette mode
+// included.
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStarRender.h>
+
+static const uint16_t N = 100;
+
+// Strip with a power model and the output options under test
+static void setup(Adafruit_DotStar &strip, bool gamma, bool white) {
+  strip.begin();
+  std::vector<uint32_t> colors = testColors(N, 31);
+  strip.setPixels(0, colors.data(), N);
+  strip.setPowerModel(78, 78, 78, 1000);
+  CHECK(strip.setGammaCorrection(gamma));
+  if (white)
+    CHECK(strip.setWhiteBalance(255, 190, 120));
+}
+
+// Wire bytes of an unlimited strip with the same pixels at a brightness.
+// Replaces what the SPI mock holds, so take a copy of that first.
+static std::vector<uint8_t> expected(uint8_t bright, bool gamma,
+                                     bool white) {
+  HostSPIMock &mock = hostSPIMock();
+  Adafruit_DotStar ref(N, DOTSTAR_BGR);
+  setup(ref, gamma, white);
+  ref.setBrightness(bright);
+  mock.clear();
+  ref.show();
+  return mock.getData();
+}
+
+static void sourceColors(Adafruit_DotStar *, uint16_t first, uint32_t *c,
+                         uint16_t count) {
+  std::vector<uint32_t> colors = testColors(N, 31);
+  for (uint16_t i = 0; i < count; i++)
+    c[i] = colors[first + i];
+}
+
+static void testLimited(void) {
+  HostSPIMock &mock = hostSPIMock();
+  for (int opts = 0; opts < 4; opts++) {
+    bool gamma = opts & 1, white = opts & 2;
+    Adafruit_DotStar strip(N, DOTSTAR_BGR);
+    setup(strip, gamma, white);
+    strip.setBrightness(200);
+    uint32_t full = strip.getPowerEstimate();
+    strip.setPowerLimit(full / 3);
+    Adafruit_DotStarRender render(&strip);
+    render.begin(); // No workers (false) on the serial variant
+
+    for (int how = 0; how < 4; how++) {
+      mock.clear();
+      if (how == 0) {
+        strip.show();
+      } else if (how == 1) {
+        CHECK(strip.setFrameBuffer(true));
+        strip.show();
+        strip.setFrameBuffer(false);
+      } else if (how == 2) {
+        CHECK(strip.showAsync());
+        strip.waitForShow();
+      } else {
+        render.show();
+      }
+      std::vector<uint8_t> data = mock.getData();
+      uint8_t b = strip.getFrameBrightness();
+      CHECK(b < 200);
+      CHECK(strip.getFramePower() <= full / 3);
+      CHECK_BYTES(data, expected(b, gamma, white));
+    }
+    CHECK_EQ(strip.getFramesLimited(), 4);
+
+    // show(source) isn't limited: back to the brightness setting
+    mock.clear();
+    strip.show(sourceColors);
+    std::vector<uint8_t> data = mock.getData();
+    CHECK_BYTES(data, expected(200, gamma, white));
+    CHECK_EQ(strip.getFrameBrightness(), 200);
+
+    // Nor is anything once the limit's lifted
+    strip.setPowerLimit(0);
+    mock.clear();
+    strip.show();
+    CHECK_EQ(strip.getFrameBrightness(), 200);
+    data = mock.getData();
+    CHECK_BYTES(data, expected(200, gamma, white));
+  }
+}
+
+// With hardware brightness, the limit holds for the 5-bit level issued
+// (which brightness is rounded to), worked out from the wire bytes.
+static void testHardware(void) {
+  HostSPIMock &mock = hostSPIMock();
+  Adafruit_DotStar strip(N, DOTSTAR_BGR);
+  setup(strip, false, false);
+  strip.setHardwareBrightness(true);
+  const uint16_t step[3] = {78, 78, 78}, idle = 1000; // As setup()
+  uint32_t full = strip.getPowerEstimate();
+  for (uint32_t limit = N * idle / 1000 + 1; limit <= full; limit += 7) {
+    strip.setPowerLimit(limit);
+    mock.clear();
+    strip.show();
+    std::vector<uint8_t> data = mock.getData();
+    uint64_t ua = 0; // Color current times 31
+    for (uint16_t i = 0; i < N; i++) {
+      const uint8_t *px = &data[4 + i * 4];
+      for (int c = 0; c < 3; c++) // BGR on the wire
+        ua += (uint64_t)step[2 - c] * px[1 + c] * (px[0] & 0x1F);
+    }
+    ua = ua / 31 + (uint32_t)N * idle;
+    CHECK(ua <= (uint64_t)limit * 1000);
+    CHECK(strip.getFramePower() <= limit);
+  }
+  CHECK(strip.getFramesLimited() > 0);
+}
+
+// clear() keeps the power estimate right without a recount, including in
+// palette mode, where cleared pixels show palette color 0.
+static void testClear(void) {
+  for (uint8_t bits : {0, 4, 8}) {
+    Adafruit_DotStar strip(N, DOTSTAR_BGR);
+    if (bits) {
+      CHECK(strip.setPaletteMode(bits));
+      strip.setPaletteColor(0, 0x203040);
+      strip.setPaletteColor(1, 0xFFFFFF);
+      for (uint16_t i = 0; i < N; i += 3)
+        strip.setPixelIndex(i, 1);
+    } else {
+      strip.fill(0xFFFFFF);
+    }
+    strip.setPowerModel(20, 20, 20, 500);
+    uint32_t before = strip.getPowerEstimate();
+    strip.clear();
+    uint32_t after = strip.getPowerEstimate();
+    CHECK(after < before);
+    strip.setPowerModel(20, 20, 20, 500); // Forces a recount
+    CHECK_EQ(after, strip.getPowerEstimate());
+    if (!bits)
+      CHECK_EQ(after, (N * 500 + 999) / 1000);
+  }
+}
+
+int main(void) {
+  testLimited();
+  testHardware();
+  testClear();
+  return testResult("power");
+}
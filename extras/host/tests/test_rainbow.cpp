@@ -0,0 +1,137 @@
+// ColorHue() and ColorHSV() against the original hexcone math for every
+// hue, and rainbow() (whose per-pixel hue is stepped rather than divided,
+// and whose saturation, value and gamma go through a table on longer
+// runs) against gamma32(ColorHSV()) of the hue the original formula
+// gives each pixel: over lengths either side of the table threshold, all
+// reps, saturations, brightness and gamma settings, and filled in pieces
+// from arbitrary first/count offsets.
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStar.h>
+
+// Exposes rainbowSpan() for filling a strip in pieces
+class RainbowProbe : public Adafruit_DotStar {
+public:
+  RainbowProbe(uint16_t n) : Adafruit_DotStar(n, DOTSTAR_BGR) {}
+  using Adafruit_DotStar::rainbowSpan;
+};
+
+// The hexcone conversion as first written: hue to 0-1530, six slices of
+// 255, then saturation and value scaled with >> 8.
+static uint32_t refHSV(uint16_t hue, uint8_t sat, uint8_t val) {
+  uint32_t h = (hue * 1530L + 32768) / 65536, c[3];
+  if (h == 1530) // Last half slice of red
+    h = 0;
+  // Per slice, each of R, G, B is constant, rising (1: x) or falling
+  // (2: 255 - x) across it
+  const uint8_t slices[6][3] = {{255, 1, 0}, {2, 255, 0}, {0, 255, 1},
+                                {0, 2, 255}, {1, 0, 255}, {255, 0, 2}};
+  uint32_t x = h % 255;
+  for (int i = 0; i < 3; i++) {
+    uint8_t u = slices[h / 255][i];
+    c[i] = (u == 1) ? x : (u == 2) ? 255 - x : u;
+  }
+  uint32_t v1 = 1 + val, s1 = 1 + sat, s2 = 255 - sat, out = 0;
+  for (int i = 0; i < 3; i++)
+    out = (out << 8) | (((((c[i] * s1) >> 8) + s2) * v1) >> 8);
+  return out;
+}
+
+static void testHue(void) {
+  const uint8_t levels[] = {0, 1, 2, 100, 127, 128, 200, 254, 255};
+  bool hueOK = true, hsvOK = true;
+  for (uint32_t h = 0; h < 65536; h++) {
+    hueOK = hueOK && (Adafruit_DotStar::ColorHue(h) == refHSV(h, 255, 255));
+    for (uint8_t s : levels)
+      for (uint8_t v : levels)
+        hsvOK = hsvOK && (Adafruit_DotStar::ColorHSV(h, s, v) ==
+                          refHSV(h, s, v));
+  }
+  CHECK(hueOK);
+  CHECK(hsvOK);
+  // Every saturation and value, on hues around each slice boundary
+  bool allOK = true;
+  for (uint32_t h = 0; h < 65536; h += 4369)
+    for (uint16_t s = 0; s < 256; s++)
+      for (uint16_t v = 0; v < 256; v++)
+        allOK = allOK &&
+                (Adafruit_DotStar::ColorHSV(h, s, v) == refHSV(h, s, v));
+  CHECK(allOK);
+}
+
+// Expected color of pixel i of n after rainbow()
+static uint32_t refRainbow(uint32_t i, uint32_t n, uint16_t first_hue,
+                           int8_t reps, uint8_t sat, uint8_t val,
+                           bool gammify) {
+  uint16_t hue = first_hue + (int64_t)i * reps * 65536 / (int64_t)n;
+  uint32_t c = Adafruit_DotStar::ColorHSV(hue, sat, val);
+  return gammify ? Adafruit_DotStar::gamma32(c) : c;
+}
+
+static bool sameRainbow(const Adafruit_DotStar &strip, uint16_t first_hue,
+                        int8_t reps, uint8_t sat, uint8_t val,
+                        bool gammify) {
+  uint16_t n = strip.numPixels();
+  for (uint16_t i = 0; i < n; i++) {
+    if (strip.getPixelColor(i) !=
+        refRainbow(i, n, first_hue, reps, sat, val, gammify)) {
+      fprintf(stderr, "  n %u, pixel %u: hue %u, reps %d, sat %u, val %u%s\n",
+              n, i, first_hue, reps, sat, val, gammify ? ", gamma" : "");
+      return false;
+    }
+  }
+  return true;
+}
+
+static void testRainbow(void) {
+  const int8_t reps[] = {1, -1, 0, 2, -3, 7, 127, -128};
+  for (uint16_t n : {1, 2, 3, 85, 86, 87, 255, 1000, 1530, 4099}) {
+    Adafruit_DotStar strip(n, DOTSTAR_BGR);
+    for (int8_t r : reps) {
+      for (uint16_t hue : {0, 1, 32767, 65535}) {
+        for (uint8_t sat : {255, 0, 90}) {
+          for (uint8_t val : {255, 1, 170}) {
+            for (bool g : {true, false}) {
+              strip.rainbow(hue, r, sat, val, g);
+              CHECK(sameRainbow(strip, hue, r, sat, val, g));
+            }
+          }
+        }
+      }
+    }
+  }
+  // Defaults, and the longest strip
+  Adafruit_DotStar strip(65535, DOTSTAR_BGR);
+  strip.rainbow();
+  CHECK(sameRainbow(strip, 0, 1, 255, 255, true));
+  strip.rainbow(12345, -128, 200, 100, false);
+  CHECK(sameRainbow(strip, 12345, -128, 200, 100, false));
+}
+
+// Filled in pieces of every size from 1 up, from every offset the pieces
+// fall on, the strip matches a single rainbow()
+static void testSpans(void) {
+  for (uint16_t n : {13, 200, 1001}) {
+    RainbowProbe strip(n);
+    for (int8_t r : {1, -5, 33}) {
+      std::vector<uint32_t> sizes = testColors(64, n + r);
+      strip.clear();
+      for (uint16_t first = 0, k = 0; first < n; k++) {
+        uint16_t count = 1 + sizes[k % sizes.size()] % 120;
+        if (count > n - first)
+          count = n - first;
+        strip.rainbowSpan(777, r, 210, 230, true, first, count);
+        first += count;
+      }
+      CHECK(sameRainbow(strip, 777, r, 210, 230, true));
+    }
+  }
+}
+
+int main(void) {
+  testHue();
+  testRainbow();
+  testSpans();
+  return testResult("rainbow");
+}
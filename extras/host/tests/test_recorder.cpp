@@ -0,0 +1,155 @@
+// Adafruit_DotStarRecorder and Adafruit_DotStarReplay: frames recorded
+// from show() replay byte-for-byte, through getFrame(), play() and back
+// out to the mock SPI device, and the recording is compact when little
+// changes. Damaged recordings are reported as errors.
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStarPlayer.h>
+#include <Adafruit_DotStarRecorder.h>
+
+#include <string.h>
+
+// Print to a growing block of memory, standing in for a file
+class MemoryPrint : public Print {
+public:
+  size_t write(uint8_t b) {
+    data.push_back(b);
+    return 1;
+  }
+  size_t write(const uint8_t *buf, size_t len) {
+    data.insert(data.end(), buf, buf + len);
+    return len;
+  }
+  std::vector<uint8_t> data;
+};
+
+static std::vector<uint8_t> bytesOf(const uint8_t *p, uint32_t len) {
+  return std::vector<uint8_t>(p, p + len);
+}
+
+static const int FRAMES = 20;
+static const uint16_t N = 150;
+
+// Record an animation where a few pixels change per frame (and the
+// brightness once), keeping what went to the SPI device for each frame.
+static void record(MemoryPrint &file, std::vector<std::vector<uint8_t>> &wire,
+                   uint32_t &recorded) {
+  HostSPIMock &mock = hostSPIMock();
+  Adafruit_DotStar strip(N, DOTSTAR_BGR);
+  strip.begin();
+  std::vector<uint32_t> colors = testColors(N, 77);
+  strip.setPixels(0, colors.data(), N);
+  Adafruit_DotStarRecorder rec(&file, strip.getFrameBytes());
+  strip.setOutput(&rec, true); // Tap: SPI output continues too
+  for (int f = 0; f < FRAMES; f++) {
+    strip.setPixelColor((f * 37) % N, f * 0x010305);
+    strip.setPixelColor((f * 11) % N, 0xFFFFFF);
+    if (f == FRAMES / 2)
+      strip.setBrightness(90);
+    mock.clear();
+    strip.show();
+    wire.push_back(mock.getData());
+    CHECK_EQ(rec.getFrames(), f + 1);
+    CHECK_BYTES(bytesOf(rec.getFrame(), rec.getFrameLength()), wire.back());
+    delayMicroseconds(50);
+  }
+  CHECK(!rec.overflowed());
+  recorded = rec.getRecordedBytes();
+}
+
+static void testRoundTrip(void) {
+  MemoryPrint file;
+  std::vector<std::vector<uint8_t>> wire;
+  uint32_t recorded = 0;
+  record(file, wire, recorded);
+  uint32_t frameBytes = wire[0].size();
+
+  CHECK_EQ(recorded, file.data.size());
+  CHECK(file.data.size() > 4);
+  CHECK(!memcmp(file.data.data(), "DSR", 3));
+  CHECK_EQ(file.data[3], DOTSTAR_RECORD_VERSION);
+  // Only changes are stored: far less than the raw frames, beyond the
+  // first frame and the one where brightness changed everything
+  CHECK(recorded < frameBytes * 3);
+  CHECK(recorded > frameBytes);
+
+  // Frames as read
+  Adafruit_DotStarMemoryStream in(file.data.data(), file.data.size(), false);
+  Adafruit_DotStarReplay replay(&in, frameBytes);
+  uint32_t t = 0;
+  for (int f = 0; f < FRAMES; f++) {
+    CHECK(replay.read());
+    CHECK_BYTES(bytesOf(replay.getFrame(), replay.getFrameLength()),
+                wire[f]);
+    t += replay.getInterval();
+    CHECK_EQ(replay.getTime(), t);
+    if (f)
+      CHECK(replay.getInterval() >= 50);
+  }
+  CHECK(!replay.read());
+  CHECK(!replay.error());
+  CHECK_EQ(replay.getFrames(), FRAMES);
+
+  // Played to a capture, and through a strip to the SPI device
+  HostSPIMock &mock = hostSPIMock();
+  Adafruit_DotStar out(0, DOTSTAR_BGR);
+  out.begin();
+  Adafruit_DotStarCapture cap(frameBytes);
+  in.rewind();
+  replay.reset();
+  for (int f = 0; f < FRAMES; f++) {
+    CHECK(replay.play(&cap));
+    CHECK_EQ(cap.getFrames(), f + 1);
+    CHECK_BYTES(bytesOf(cap.getFrame(), cap.getFrameLength()), wire[f]);
+    mock.clear();
+    out.showEncoded(replay.getFrame(), replay.getFrameLength());
+    CHECK_BYTES(mock.getData(), wire[f]);
+    CHECK_EQ(mock.getTransactions(), 1);
+  }
+  CHECK(!replay.play(&cap));
+  CHECK(!replay.error());
+  CHECK_EQ(cap.getBytes(), frameBytes * FRAMES);
+}
+
+// Truncation, a bad header, and frames larger than the replay buffer
+static void testDamaged(void) {
+  MemoryPrint file;
+  std::vector<std::vector<uint8_t>> wire;
+  uint32_t recorded = 0;
+  record(file, wire, recorded);
+  uint32_t frameBytes = wire[0].size();
+
+  Adafruit_DotStarMemoryStream cut(file.data.data(), file.data.size() - 1,
+                                   false);
+  Adafruit_DotStarReplay a(&cut, frameBytes);
+  int frames = 0;
+  while (a.read())
+    frames++;
+  CHECK_EQ(frames, FRAMES - 1);
+  CHECK(a.error());
+
+  std::vector<uint8_t> bad = file.data;
+  bad[3]++;
+  Adafruit_DotStarMemoryStream badIn(bad.data(), bad.size(), false);
+  Adafruit_DotStarReplay b(&badIn, frameBytes);
+  CHECK(!b.read());
+  CHECK(b.error());
+
+  Adafruit_DotStarMemoryStream in(file.data.data(), file.data.size(), false);
+  Adafruit_DotStarReplay c(&in, frameBytes - 1);
+  CHECK(!c.read());
+  CHECK(c.error());
+
+  // Empty recording: no frames, not an error
+  Adafruit_DotStarMemoryStream empty(NULL, 0, false);
+  Adafruit_DotStarReplay d(&empty, frameBytes);
+  CHECK(!d.read());
+  CHECK(!d.error());
+}
+
+int main(void) {
+  testRoundTrip();
+  testDamaged();
+  return testResult("recorder");
+}
@@ -0,0 +1,161 @@
+// Adafruit_DotStarRender against the same work done serially on a plain
+// strip: run() with a per-pixel kernel, fill(), fade() and rainbow() leave
+// the same pixels, and show() (chunks encoded on a worker while the last
+// is issued, or tiles of a frame buffer) issues the same wire bytes, with
+// 0 to 3 workers. Lengths either side of DOTSTAR_RENDER_CHUNK and of each
+// 4-pixel tile boundary, in RGB, DOTSTAR_MONO and 4- and 8-bit palette
+// storage. Tiles cover the strip once, and start on a multiple of 4
+// pixels so they never share a packed byte. Built against the ESP32
+// (worker task) library variant.
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStarRender.h>
+
+#include <algorithm>
+#include <mutex>
+
+// Storage modes under test: color order, and palette bits (0 for colors)
+static const struct {
+  uint8_t order, bits;
+} modes[] = {{DOTSTAR_BGR, 0}, {DOTSTAR_MONO, 0}, {DOTSTAR_BGR, 4},
+             {DOTSTAR_BGR, 8}};
+
+static void setup(Adafruit_DotStar &strip, uint8_t bits) {
+  strip.begin();
+  if (bits) {
+    CHECK(strip.setPaletteMode(bits));
+    std::vector<uint32_t> c = testColors(256, 7);
+    for (uint16_t i = 0; i < 256; i++)
+      strip.setPaletteColor(i, c[i]);
+  }
+}
+
+// Run kernel: a pseudo-random value per pixel, set by color or index
+static void pixelKernel(Adafruit_DotStar *s, uint16_t first, uint16_t count,
+                        void *arg) {
+  uint32_t seed = *(uint32_t *)arg;
+  for (uint16_t i = first; i < first + count; i++) {
+    uint32_t x = (i + seed) * 2654435761u;
+    if (s->getPaletteMode())
+      s->setPixelIndex(i, x >> 24);
+    else
+      s->setPixelColor(i, x >> 8);
+  }
+}
+
+// Run kernel: note the tile, as (first, count)
+struct Tiles {
+  std::mutex m;
+  std::vector<std::pair<uint16_t, uint16_t>> tiles;
+};
+
+static void tileKernel(Adafruit_DotStar *, uint16_t first, uint16_t count,
+                       void *arg) {
+  Tiles *t = (Tiles *)arg;
+  std::lock_guard<std::mutex> lock(t->m);
+  t->tiles.push_back(std::make_pair(first, count));
+}
+
+static bool samePixels(const Adafruit_DotStar &a, const Adafruit_DotStar &b,
+                       const char *what, uint8_t workers) {
+  for (uint16_t i = 0; i < a.numPixels(); i++) {
+    if ((a.getPixelColor(i) != b.getPixelColor(i)) ||
+        (a.getPaletteMode() && (a.getPixelIndex(i) != b.getPixelIndex(i)))) {
+      fprintf(stderr, "  %s, %u workers, n %u, pixel %u: %06X, "
+              "expected %06X\n", what, workers, a.numPixels(), i,
+              a.getPixelColor(i), b.getPixelColor(i));
+      return false;
+    }
+  }
+  return true;
+}
+
+// Wire bytes of a show(); takes a copy, as the next show() replaces them
+template <typename F> static std::vector<uint8_t> wire(F show) {
+  HostSPIMock &mock = hostSPIMock();
+  mock.clear();
+  show();
+  return mock.getData();
+}
+
+static void testRender(uint16_t n, uint8_t order, uint8_t bits,
+                       uint8_t workers) {
+  Adafruit_DotStar strip(n, order), ref(n, order);
+  setup(strip, bits);
+  setup(ref, bits);
+  Adafruit_DotStarRender render(&strip);
+  CHECK_EQ(render.begin(workers), workers > 0);
+  CHECK_EQ(render.numWorkers(), workers);
+
+  Tiles t;
+  render.run(tileKernel, &t);
+  std::sort(t.tiles.begin(), t.tiles.end());
+  CHECK(t.tiles.size() <= (size_t)workers + 1);
+  uint32_t end = 0;
+  for (auto &tile : t.tiles) {
+    CHECK_EQ(tile.first, end);
+    CHECK_EQ(tile.first % 4, 0);
+    CHECK(tile.second > 0);
+    end = tile.first + tile.second;
+  }
+  CHECK_EQ(end, n);
+
+  uint32_t seed = n * 4 + workers;
+  render.run(pixelKernel, &seed);
+  pixelKernel(&ref, 0, n, &seed);
+  CHECK(samePixels(strip, ref, "run", workers));
+
+  render.fade(100);
+  ref.fade(100);
+  CHECK(samePixels(strip, ref, "fade", workers));
+
+  // Frames with brightness, and dimmed by a power limit
+  for (int how = 0; how < 2; how++) {
+    strip.setBrightness(how ? 255 : 90);
+    ref.setBrightness(how ? 255 : 90);
+    if (how) {
+      strip.setPowerModel(78, 78, 78, 1000);
+      ref.setPowerModel(78, 78, 78, 1000);
+      strip.setPowerLimit(ref.getPowerEstimate() / 2 + 1);
+      ref.setPowerLimit(ref.getPowerEstimate() / 2 + 1);
+    }
+    for (bool frame : {false, true}) {
+      CHECK(strip.setFrameBuffer(frame));
+      std::vector<uint8_t> got = wire([&] { render.show(); }),
+                           want = wire([&] { ref.show(); });
+      CHECK_BYTES(got, want);
+      CHECK_EQ(strip.getFrameBrightness(), ref.getFrameBrightness());
+    }
+  }
+
+  if (!bits) {
+    for (int8_t reps : {1, -3}) {
+      render.rainbow(12345, reps, 200, 250, reps > 0);
+      ref.rainbow(12345, reps, 200, 250, reps > 0);
+      CHECK(samePixels(strip, ref, "rainbow", workers));
+    }
+    CHECK(strip.setFrameBuffer(false));
+    std::vector<uint8_t> got = wire([&] { render.show(); }),
+                         want = wire([&] { ref.show(); });
+    CHECK_BYTES(got, want);
+  }
+
+  render.fill(0x123456);
+  ref.fill(0x123456);
+  CHECK(samePixels(strip, ref, "fill", workers));
+}
+
+int main(void) {
+  const int C = DOTSTAR_RENDER_CHUNK;
+  std::vector<uint16_t> lengths;
+  for (uint16_t n = 1; n <= 17; n++)
+    lengths.push_back(n);
+  for (int n : {C - 1, C, C + 1, C + 3, 2 * C, 3 * C - 2, 1001})
+    lengths.push_back(n);
+  for (uint8_t workers = 0; workers <= DOTSTAR_RENDER_WORKERS; workers++)
+    for (uint16_t n : lengths)
+      for (auto &m : modes)
+        testRender(n, m.order, m.bits, workers);
+  return testResult("render");
+}
@@ -0,0 +1,179 @@
+// Adafruit_DotStarScheduler on a stopped clock (HostClock) that only the
+// test, the render function and the SPI device advance: frames come due
+// exactly at the target rate, missed frame times are counted as dropped
+// and the frame number skips ahead (across micros() wrapping, too), the
+// rolling averages follow their 1/8-weighted definition, and bytes sent
+// count getFrameBytes() for every frame not skipped by dirty tracking.
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStarScheduler.h>
+
+static uint32_t renderUs = 0, showUs = 0; // Time taken by each
+static std::vector<uint32_t> frames;      // Frame numbers rendered
+static bool change = true;                // Render changes a pixel
+
+static void render(Adafruit_DotStar *strip, uint32_t frame) {
+  frames.push_back(frame);
+  if (change)
+    strip->setPixelColor(0, frame);
+  HostClock::advance(renderUs);
+}
+
+// SPI device taking showUs to issue each frame
+class ClockSPI : public HostSPIMock {
+public:
+  void endTransaction(void) {
+    HostSPIMock::endTransaction();
+    HostClock::advance(showUs);
+  }
+};
+
+static ClockSPI dev;
+static SPIClass bus(&dev);
+
+// Frames come due every 1/fps, and no sooner
+static void testPacing(void) {
+  HostClock::set(5000);
+  renderUs = 700;
+  showUs = 300;
+  frames.clear();
+  Adafruit_DotStar strip(10, DOTSTAR_BGR, &bus);
+  strip.begin();
+  Adafruit_DotStarScheduler sched(&strip, 100, render); // 10 ms
+  CHECK_EQ(sched.getFPS(), 100);
+
+  for (uint32_t f = 0; f < 5; f++) {
+    HostClock::set(5000 + f * 10000 - 1);
+    CHECK(f == 0 || !sched.run()); // 1 us early
+    HostClock::set(5000 + f * 10000);
+    CHECK(sched.run());
+    CHECK(!sched.run()); // Just ran
+    CHECK_EQ(frames.back(), f);
+  }
+  CHECK_EQ(frames.size(), 5);
+  CHECK_EQ(sched.getFramesShown(), 5);
+  CHECK_EQ(sched.getFramesDropped(), 0);
+  CHECK(sched.getActualFPS() == 100.0);
+
+  // 2.05 frame times late: two dropped, the frame number skips them, and
+  // the next is due on the original schedule
+  HostClock::set(55000 + 20500);
+  CHECK(sched.run());
+  CHECK_EQ(sched.getFramesDropped(), 2);
+  CHECK_EQ(frames.back(), 7);
+  CHECK_EQ(sched.getFrame(), 8);
+  HostClock::set(85000 - 1);
+  CHECK(!sched.run());
+  HostClock::set(85000);
+  CHECK(sched.run());
+  CHECK_EQ(frames.back(), 8);
+
+  // Late by less than a frame time: nothing dropped, the next frame is
+  // due sooner
+  HostClock::set(95000 + 9999);
+  CHECK(sched.run());
+  HostClock::set(105000);
+  CHECK(sched.run());
+  CHECK_EQ(sched.getFramesDropped(), 2);
+  CHECK_EQ(frames.back(), 10);
+
+  // micros() wrapping around
+  const uint32_t start = 0xFFFFFFFF - 15000;
+  HostClock::set(start);
+  sched.setFPS(50); // 20 ms, restarts at frame 0
+  CHECK_EQ(sched.getFramesShown(), 0);
+  frames.clear();
+  CHECK(sched.run());
+  HostClock::set(start + 20000 - 1);
+  CHECK(!sched.run());
+  HostClock::set(start + 20000);
+  CHECK(sched.run());
+  HostClock::set(start + 80005);
+  CHECK(sched.run());
+  CHECK_EQ(sched.getFramesDropped(), 2);
+  CHECK_EQ(frames.back(), 4);
+  CHECK_EQ(frames.size(), 3);
+  HostClock::release();
+}
+
+// 1/8-weighted rolling average, kept at 8X, starting from the first sample
+static uint32_t rolling(uint32_t avg8, uint32_t x, bool first) {
+  return first ? x << 3 : avg8 + x - (avg8 >> 3);
+}
+
+static void testAverages(void) {
+  HostClock::set(1000000);
+  Adafruit_DotStar strip(10, DOTSTAR_BGR, &bus);
+  strip.begin();
+  Adafruit_DotStarScheduler sched(&strip, 200, render); // 5 ms
+  uint32_t render8 = 0, show8 = 0, renderMax = 0, showMax = 0, fps8 = 0;
+  std::vector<uint32_t> times = testColors(40, 13);
+  uint32_t due = 1000000, prev = 0;
+  for (uint32_t f = 0; f < times.size(); f++) {
+    renderUs = times[f] % 2000;
+    showUs = (times[f] >> 12) % 2000;
+    // Run anywhere in the first 1 ms of the frame time
+    uint32_t at = due + (times[f] >> 4) % 1000;
+    HostClock::set(at);
+    CHECK(sched.run());
+    render8 = rolling(render8, renderUs, f == 0);
+    show8 = rolling(show8, showUs, f == 0);
+    if (renderUs > renderMax)
+      renderMax = renderUs;
+    if (showUs > showMax)
+      showMax = showUs;
+    uint32_t t = at + renderUs; // show() starts after render
+    if (f)
+      fps8 = rolling(fps8, t - prev, f == 1);
+    prev = t;
+    CHECK_EQ(sched.getRenderTime(), render8 >> 3);
+    CHECK_EQ(sched.getShowTime(), show8 >> 3);
+    CHECK_EQ(sched.getRenderTimeMax(), renderMax);
+    CHECK_EQ(sched.getShowTimeMax(), showMax);
+    CHECK(sched.getActualFPS() == (f ? (float)(8000000.0 / fps8) : 0.0f));
+    due += 5000;
+  }
+  CHECK_EQ(sched.getFramesDropped(), 0);
+
+  sched.resetStats();
+  CHECK_EQ(sched.getRenderTime(), 0);
+  CHECK_EQ(sched.getShowTimeMax(), 0);
+  CHECK_EQ(sched.getFramesShown(), 0);
+  CHECK(sched.getActualFPS() == 0.0);
+  HostClock::release();
+}
+
+// Bytes sent are getFrameBytes() per frame issued, which frames skipped
+// by dirty tracking aren't
+static void testBytes(void) {
+  HostClock::set(0);
+  renderUs = showUs = 0;
+  for (uint16_t n : {1, 60, 301}) {
+    Adafruit_DotStar strip(n, DOTSTAR_BGR, &bus);
+    strip.begin();
+    strip.setDirtyTracking(true);
+    Adafruit_DotStarScheduler sched(&strip, 1000, render);
+    dev.clear();
+    uint32_t shown = 0;
+    for (uint32_t f = 0; f < 20; f++) {
+      change = (f % 3) != 1;
+      CHECK(sched.run());
+      shown += change;
+      HostClock::advance(1000);
+    }
+    CHECK_EQ(strip.getFramesSkipped(), 20 - shown);
+    CHECK_EQ(sched.getFramesShown(), 20);
+    CHECK_EQ(sched.getBytesSent(), shown * strip.getFrameBytes());
+    CHECK_EQ(sched.getBytesSent(), dev.getData().size());
+  }
+  change = true;
+  HostClock::release();
+}
+
+int main(void) {
+  testPacing();
+  testAverages();
+  testBytes();
+  return testResult("scheduler");
+}
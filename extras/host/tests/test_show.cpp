@@ -0,0 +1,235 @@
+// show() issues the frame in chunks of DOTSTAR_CHUNK_PIXELS, or from the
+// whole-frame buffer in one transfer: byte-identical output either way,
+// and the expected number of SPI transactions, transfers and bytes. With
+// dirty tracking, the frame buffer is only re-encoded where pixels
+// changed, and a frame is never skipped after updatePins() or setOutput().
+// Pixels from a source function, and pre-encoded frames, go out as the
+// same bytes as the buffered show() of the same pixels.
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStar.h>
+
+// Transfers for one chunked frame: start frame, pixel chunks, then the end
+// frame in pieces no larger than the chunk buffer.
+static uint32_t chunkedTransfers(uint32_t n) {
+  const uint32_t chunk = DOTSTAR_CHUNK_PIXELS;
+  uint32_t endBytes = (n + 15) / 16;
+  return 1 + (n + chunk - 1) / chunk + (endBytes + chunk * 4 - 1) / (chunk * 4);
+}
+
+static void testModes(void) {
+  HostSPIMock &mock = hostSPIMock();
+  for (uint16_t n : {1, 15, 16, 17, 64, 100, 1000, 1025, 5000}) {
+    std::vector<uint32_t> colors = testColors(n, n);
+    Adafruit_DotStar strip(n, DOTSTAR_BGR);
+    strip.begin();
+    strip.setPixels(0, colors.data(), n);
+    CHECK_EQ(strip.getFrameBytes(), 4 + n * 4 + (n + 15) / 16);
+
+    for (uint8_t b : {255, 100}) {
+      strip.setBrightness(b);
+      std::vector<uint8_t> ref = refFrame(colors, DOTSTAR_BGR, b);
+
+      mock.clear();
+      strip.show();
+      CHECK_BYTES(mock.getData(), ref);
+      CHECK_EQ(mock.getTransactions(), 1);
+      CHECK_EQ(mock.getTransfers(), chunkedTransfers(n));
+      CHECK(mock.getLargestTransfer() <= DOTSTAR_CHUNK_PIXELS * 4);
+      CHECK(!mock.inTransaction());
+
+      CHECK(strip.setFrameBuffer(true));
+      // Twice, as the SPI transfer mustn't spoil the frame buffer
+      for (int i = 0; i < 2; i++) {
+        mock.clear();
+        strip.show();
+        CHECK_BYTES(mock.getData(), ref);
+        CHECK_EQ(mock.getTransactions(), 1);
+        CHECK_EQ(mock.getTransfers(), 1);
+        CHECK_EQ(mock.getLargestTransfer(), strip.getFrameBytes());
+      }
+      CHECK(strip.setFrameBuffer(false));
+
+      mock.clear();
+      strip.show();
+      CHECK_BYTES(mock.getData(), ref);
+    }
+  }
+}
+
+// The frame buffer follows changes in strip length
+static void testResize(void) {
+  HostSPIMock &mock = hostSPIMock();
+  Adafruit_DotStar strip(10, DOTSTAR_RGB);
+  strip.begin();
+  CHECK(strip.setFrameBuffer(true));
+  for (uint16_t n : {300, 3, 0, 40}) {
+    strip.updateLength(n);
+    std::vector<uint32_t> colors = testColors(n, n + 7);
+    strip.setPixels(0, colors.data(), n);
+    mock.clear();
+    strip.show();
+    CHECK_BYTES(mock.getData(), n ? refFrame(colors, DOTSTAR_RGB)
+                                  : std::vector<uint8_t>());
+    CHECK_EQ(mock.getTransfers(), n ? 1 : 0);
+  }
+}
+
+// Dirty tracking with a frame buffer: only changed pixels are re-encoded,
+// unless something else about the frame changed.
+static void testCached(void) {
+  HostSPIMock &mock = hostSPIMock();
+  const uint16_t n = 200;
+  std::vector<uint32_t> colors = testColors(n, 11);
+  Adafruit_DotStar strip(n, DOTSTAR_BRG);
+  strip.begin();
+  strip.setPixels(0, colors.data(), n);
+  strip.setBrightness(150);
+  strip.setDirtyTracking(true);
+  CHECK(strip.setFrameBuffer(true));
+  strip.show();
+  CHECK_EQ(strip.getPixelsEncoded(), n);
+  uint32_t encoded = n;
+
+  // Pixels 5 to 150 changed
+  colors[5] = 0x123456;
+  colors[150] = 0xABCDEF;
+  strip.setPixelColor(5, colors[5]);
+  strip.setPixelColor(150, colors[150]);
+  mock.clear();
+  strip.show();
+  CHECK_BYTES(mock.getData(), refFrame(colors, DOTSTAR_BRG, 150));
+  CHECK_EQ(strip.getPixelsEncoded(), encoded += 146);
+  strip.show(); // Nothing changed
+  CHECK_EQ(strip.getFramesSkipped(), 1);
+
+  // New brightness: all of them
+  strip.setBrightness(90);
+  mock.clear();
+  strip.show();
+  CHECK_BYTES(mock.getData(), refFrame(colors, DOTSTAR_BRG, 90));
+  CHECK_EQ(strip.getPixelsEncoded(), encoded += n);
+
+  // A showAsync() frame in between, which doesn't update the frame buffer
+  colors[7] = 0x010203;
+  strip.setPixelColor(7, colors[7]);
+  CHECK(strip.showAsync());
+  strip.waitForShow();
+  colors[190] = 0x040506;
+  strip.setPixelColor(190, colors[190]);
+  mock.clear();
+  strip.show();
+  CHECK_BYTES(mock.getData(), refFrame(colors, DOTSTAR_BRG, 90));
+  CHECK_EQ(strip.getPixelsEncoded(), encoded += n * 2);
+
+  // Without dirty tracking, direct changes to the buffer (getPixels()) are
+  // allowed, so every pixel is encoded every time
+  strip.setDirtyTracking(false);
+  strip.resetCounters();
+  memset(strip.getPixels(), 0, 3);
+  colors[0] = 0;
+  mock.clear();
+  strip.show();
+  CHECK_EQ(strip.getPixelsEncoded(), n);
+  CHECK_EQ(strip.getPixelColor(0), colors[0]);
+  CHECK_BYTES(mock.getData(), refFrame(colors, DOTSTAR_BRG, 90));
+}
+
+// One pixel buffer recycled across strips with updatePins(), or sent to a
+// new output: the next frame isn't skipped by dirty tracking.
+static void testRecycle(void) {
+  HostSPIMock &mock = hostSPIMock();
+  const uint16_t n = 20;
+  std::vector<uint32_t> colors = testColors(n, 12);
+  std::vector<uint8_t> ref = refFrame(colors, DOTSTAR_BGR);
+  Adafruit_DotStar strip(n, DOTSTAR_BGR);
+  strip.begin();
+  strip.setPixels(0, colors.data(), n);
+  strip.setDirtyTracking(true);
+  strip.show();
+
+  Adafruit_DotStarCapture cap(strip.getFrameBytes());
+  strip.setOutput(&cap);
+  strip.show();
+  CHECK_EQ(cap.getFrames(), 1);
+  CHECK_BYTES(std::vector<uint8_t>(cap.getFrame(),
+                                   cap.getFrame() + cap.getFrameLength()),
+              ref);
+  strip.setOutput(NULL);
+
+  HostGPIO::reset();
+  HostGPIO::decode(2, 3);
+  strip.updatePins(2, 3);
+  strip.show();
+  CHECK_BYTES(HostGPIO::getDecoded(), ref);
+
+  strip.updatePins();
+  mock.clear();
+  strip.show();
+  CHECK_BYTES(mock.getData(), ref);
+  CHECK_EQ(strip.getFramesSkipped(), 0);
+}
+
+static const std::vector<uint32_t> *sourceColors; // For source()
+
+static void source(Adafruit_DotStar *, uint16_t first, uint32_t *c,
+                   uint16_t count) {
+  for (uint16_t i = 0; i < count; i++)
+    c[i] = (*sourceColors)[first + i];
+}
+
+// show(source) and showEncoded() issue what show() does, with every
+// output setting, and don't leave dirty tracking skipping the next show()
+static void testSource(void) {
+  HostSPIMock &mock = hostSPIMock();
+  for (uint16_t n : {1, 15, 16, 17, 100, 301}) {
+    std::vector<uint32_t> colors = testColors(n, n + 3);
+    sourceColors = &colors;
+    for (int opts = 0; opts < 16; opts++) {
+      Adafruit_DotStar strip(n, DOTSTAR_GRB);
+      strip.begin();
+      strip.setPixels(0, colors.data(), n);
+      strip.setBrightness((opts & 1) ? 77 : 255);
+      strip.setHardwareBrightness(opts & 2);
+      strip.setGammaCorrection(opts & 4);
+      if (opts & 8) {
+        strip.setWhiteBalance(255, 200, 150);
+        for (uint16_t i = 0; i < n; i += 3)
+          strip.setPixelBrightness(i, i * 7);
+      }
+      strip.setDirtyTracking(true);
+      mock.clear();
+      strip.show();
+      std::vector<uint8_t> ref = mock.getData();
+
+      mock.clear();
+      strip.show(source);
+      CHECK_BYTES(mock.getData(), ref);
+      CHECK_EQ(strip.getFrameBrightness(), strip.getBrightness());
+      mock.clear();
+      strip.showEncoded(ref.data(), ref.size());
+      CHECK_BYTES(mock.getData(), ref);
+
+      // Neither leaves the next show() skipped, though the buffer hasn't
+      // changed since the last
+      mock.clear();
+      strip.show();
+      CHECK_BYTES(mock.getData(), ref);
+      strip.show(source);
+      mock.clear();
+      strip.show();
+      CHECK_BYTES(mock.getData(), ref);
+      CHECK_EQ(strip.getFramesSkipped(), 0);
+    }
+  }
+}
+
+int main(void) {
+  testModes();
+  testResize();
+  testCached();
+  testRecycle();
+  testSource();
+  return testResult("show");
+}
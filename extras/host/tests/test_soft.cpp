@@ -0,0 +1,129 @@
+// Soft (bitbang) SPI, decoded from the mock GPIO: the same bytes as
+// hardware SPI on every path (direct softTransfer() with the pins on the
+// same or different ports, and Adafruit_SPIDevice's own bitbang at low
+// clock rates), two clock edges per bit, and the data pin only changing
+// when the data does. Built against both the digitalWrite() and the
+// BUSIO_USE_FAST_PINIO port register library variants. Interrupt
+// handlers may change other pins on the same port mid-frame.
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStar.h>
+
+// Data pin changes needed to send bytes, starting from LOW
+static uint32_t dataChanges(const std::vector<uint8_t> &bytes) {
+  uint32_t changes = 0;
+  uint8_t prev = 0;
+  for (uint8_t b : bytes) {
+    for (uint8_t bit = 0x80; bit; bit >>= 1) {
+      uint8_t v = (b & bit) ? 1 : 0;
+      changes += (v != prev);
+      prev = v;
+    }
+  }
+  return changes;
+}
+
+// Show a frame on soft SPI pins and check what the GPIO saw.
+// Returns the number of pin writes.
+static uint32_t checkSoft(Adafruit_DotStar &strip, uint8_t data,
+                          uint8_t clock, const std::vector<uint8_t> &ref) {
+  HostGPIO::reset();
+  HostGPIO::decode(data, clock);
+  strip.show();
+  CHECK_BYTES(HostGPIO::getDecoded(), ref);
+  CHECK_EQ(HostGPIO::getPartialBits(), 0);
+  CHECK_EQ(HostGPIO::getEdges(clock), ref.size() * 16);
+  CHECK_EQ(HostGPIO::get(clock), LOW);
+  CHECK_EQ(HostGPIO::getEdges(data), dataChanges(ref));
+  return HostGPIO::getWrites();
+}
+
+static void testPaths(void) {
+  const uint16_t n = 50;
+  std::vector<uint32_t> colors = testColors(n, 8);
+  Adafruit_DotStar strip(n, 2, 3, DOTSTAR_BRG);
+  strip.begin();
+  strip.setPixels(0, colors.data(), n);
+  strip.setBrightness(180);
+  std::vector<uint8_t> ref = refFrame(colors, DOTSTAR_BRG, 180);
+  uint32_t bits = ref.size() * 8, transfers = 1 + (n + 15) / 16 + 1;
+
+  // Default clock rate: direct softTransfer(), same port
+  uint32_t writes = checkSoft(strip, 2, 3, ref);
+#ifdef BUSIO_USE_FAST_PINIO
+  // Two port writes per bit, plus dropping the clock after each transfer
+  CHECK_EQ(writes, bits * 2 + transfers);
+#else
+  CHECK(writes < bits * 3);
+#endif
+
+  // Pins on different ports
+  strip.updatePins(2, 40);
+  writes = checkSoft(strip, 2, 40, ref);
+  // Two clock writes per bit, and data writes only for changes (plus the
+  // first bit of each transfer, as the pin state isn't known then)
+  CHECK(writes >= bits * 2 + dataChanges(ref));
+  CHECK(writes <= bits * 2 + dataChanges(ref) + transfers);
+
+  // Low clock rate: Adafruit_SPIDevice's bitbang
+  strip.updatePins(2, 3);
+  strip.setClockSpeed(400000);
+  checkSoft(strip, 2, 3, ref);
+  strip.setClockSpeed(DOTSTAR_CLOCK_SPEED);
+
+  // Frame buffer and showAsync() go the same way
+  CHECK(strip.setFrameBuffer(true));
+  checkSoft(strip, 2, 3, ref);
+  strip.setFrameBuffer(false);
+  HostGPIO::reset();
+  HostGPIO::decode(2, 3);
+  CHECK(strip.showAsync());
+  strip.waitForShow();
+  CHECK_BYTES(HostGPIO::getDecoded(), ref);
+
+  // And back to hardware SPI, leaving the pins alone
+  HostSPIMock &mock = hostSPIMock();
+  strip.updatePins();
+  HostGPIO::reset();
+  mock.clear();
+  strip.show();
+  CHECK_BYTES(mock.getData(), ref);
+  CHECK_EQ(HostGPIO::getWrites(), 0);
+}
+
+// Simulated interrupt handler toggling another pin on the data/clock port
+static uint32_t toggles = 0;
+static void toggleISR(void) {
+  digitalWrite(5, !HostGPIO::get(5));
+  toggles++;
+}
+
+// Interrupt handlers changing other pins on the same port mid-frame keep
+// their changes, and the frame is unaffected.
+static void testInterrupts(void) {
+  const uint16_t n = 40;
+  std::vector<uint32_t> colors = testColors(n, 9);
+  Adafruit_DotStar strip(n, 2, 3, DOTSTAR_BGR);
+  strip.begin();
+  strip.setPixels(0, colors.data(), n);
+  std::vector<uint8_t> ref = refFrame(colors, DOTSTAR_BGR);
+  for (uint32_t every : {1, 3, 7, 100}) {
+    HostGPIO::reset();
+    HostGPIO::decode(2, 3);
+    HostGPIO::setInterrupt(toggleISR, every);
+    toggles = 0;
+    strip.show();
+    CHECK(toggles > 0);
+    CHECK_BYTES(HostGPIO::getDecoded(), ref);
+    CHECK_EQ(HostGPIO::getEdges(5), toggles);
+    CHECK_EQ(HostGPIO::get(5), toggles & 1);
+    CHECK(HostGPIO::interruptsEnabled());
+  }
+}
+
+int main(void) {
+  testPaths();
+  testInterrupts();
+  return testResult("soft");
+}
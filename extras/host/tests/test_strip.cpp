@@ -0,0 +1,85 @@
+// Adafruit_DotStarStrip: the same wire output as Adafruit_DotStar, and a
+// static buffer that stays put whichever way updateLength() is called.
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStar.h>
+
+template <class S> static void fillStrip(S &strip) {
+  std::vector<uint32_t> colors = testColors(strip.numPixels(), 4);
+  for (uint16_t i = 0; i < strip.numPixels(); i++)
+    strip.setPixelColor(i, colors[i]);
+}
+
+static void testOutput(void) {
+  HostSPIMock &mock = hostSPIMock();
+  Adafruit_DotStar base(60, DOTSTAR_BGR);
+  Adafruit_DotStarStrip<DOTSTAR_BGR, 60> fixed(60, DOTSTAR_RGB);
+  Adafruit_DotStarStrip<DOTSTAR_BGR> heap(60);
+  base.begin();
+  fixed.begin();
+  heap.begin();
+  fillStrip(base);
+  fillStrip(fixed);
+  fillStrip(heap);
+  std::vector<uint8_t> ref = refFrame(testColors(60, 4), DOTSTAR_BGR);
+  mock.clear();
+  base.show();
+  CHECK_BYTES(mock.getData(), ref);
+  mock.clear();
+  fixed.show();
+  CHECK_BYTES(mock.getData(), ref);
+  mock.clear();
+  heap.show();
+  CHECK_BYTES(mock.getData(), ref);
+  for (uint16_t i = 0; i < 60; i++)
+    CHECK_EQ(fixed.getPixelColor(i), base.getPixelColor(i));
+  fixed.fill(0x123456, 10, 5);
+  base.fill(0x123456, 10, 5);
+  CHECK(!memcmp(fixed.getPixels(), base.getPixels(), 60 * 3));
+}
+
+// Through a base pointer, updateLength() clips to the static buffer
+// rather than freeing it, and palette mode (which would reallocate it)
+// is refused.
+static void testStatic(void) {
+  Adafruit_DotStarStrip<DOTSTAR_GRB, 20> strip(10);
+  uint8_t *buf = strip.getPixels();
+  CHECK_EQ(strip.numPixels(), 10);
+  strip.updateLength(30);
+  CHECK_EQ(strip.numPixels(), 20);
+  CHECK(strip.getPixels() == buf);
+
+  Adafruit_DotStar *p = &strip;
+  p->updateLength(5);
+  CHECK_EQ(p->numPixels(), 5);
+  CHECK(p->getPixels() == buf);
+  p->updateLength(0);
+  CHECK_EQ(p->numPixels(), 0);
+  CHECK(p->getPixels() == buf);
+  p->updateLength(1000);
+  CHECK_EQ(p->numPixels(), 20);
+  CHECK(p->getPixels() == buf);
+  CHECK(!p->setPaletteMode(8));
+  CHECK(p->getPixels() == buf);
+
+  // Still usable afterward, and cleared on each length change
+  strip.setPixelColor(19, 0x010203);
+  CHECK_EQ(p->getPixelColor(19), 0x010203);
+  p->updateLength(20);
+  CHECK_EQ(p->getPixelColor(19), 0);
+
+  // Heap-backed: reallocated as with Adafruit_DotStar
+  Adafruit_DotStarStrip<DOTSTAR_GRB> heap(10);
+  p = &heap;
+  p->updateLength(300);
+  CHECK_EQ(heap.numPixels(), 300);
+  CHECK(p->setPaletteMode(8));
+  CHECK(p->setPaletteMode(0));
+}
+
+int main(void) {
+  testOutput();
+  testStatic();
+  return testResult("strip");
+}
@@ -0,0 +1,114 @@
+// Wire output of show() through the mock SPI device, the capture device
+// and the spidev backend's file mode, against the reference encoder.
+
+#include "DotStarTest.h"
+
+#include <Adafruit_DotStar.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+static const uint8_t orders[] = {DOTSTAR_RGB, DOTSTAR_RBG, DOTSTAR_GRB,
+                                 DOTSTAR_GBR, DOTSTAR_BRG, DOTSTAR_BGR};
+
+// Every color order, brightness and a range of lengths around the chunk
+// size match the reference, byte for byte.
+static void testReference(void) {
+  static const uint16_t lengths[] = {0, 1, 15, 16, 17, 100};
+  static const uint8_t levels[] = {255, 0, 1, 64, 200};
+  HostSPIMock &mock = hostSPIMock();
+  for (uint8_t o : orders) {
+    for (uint16_t n : lengths) {
+      std::vector<uint32_t> c = testColors(n, o + n);
+      Adafruit_DotStar strip(n, o);
+      strip.begin();
+      for (uint16_t i = 0; i < n; i++)
+        strip.setPixelColor(i, c[i]);
+      for (uint8_t b : levels) {
+        strip.setBrightness(b);
+        mock.clear();
+        strip.show();
+        // A 0-pixel strip has no buffer, and show() issues nothing
+        CHECK_BYTES(mock.getData(),
+                    n ? refFrame(c, o, b) : std::vector<uint8_t>());
+        CHECK_EQ(mock.getTransactions(), n ? 1 : 0);
+        CHECK(!mock.inTransaction());
+      }
+    }
+  }
+}
+
+// The capture device sees exactly what the SPI device does, and with
+// output redirected, nothing goes to SPI.
+static void testCapture(void) {
+  HostSPIMock &mock = hostSPIMock();
+  std::vector<uint32_t> c = testColors(50);
+  Adafruit_DotStar strip(50, DOTSTAR_GRB);
+  Adafruit_DotStarCapture cap(strip.getFrameBytes());
+  strip.begin();
+  for (uint16_t i = 0; i < 50; i++)
+    strip.setPixelColor(i, c[i]);
+
+  strip.setOutput(&cap, true);
+  mock.clear();
+  strip.show();
+  std::vector<uint8_t> got(cap.getFrame(),
+                           cap.getFrame() + cap.getFrameLength());
+  CHECK_BYTES(got, mock.getData());
+  CHECK_EQ(cap.getFrames(), 1);
+  CHECK_EQ(cap.getBytes(), strip.getFrameBytes());
+
+  strip.setOutput(&cap);
+  mock.clear();
+  strip.show();
+  CHECK_EQ(mock.getData().size(), 0);
+  CHECK_EQ(cap.getFrames(), 2);
+}
+
+// A strip on a bus routed to HostSPIDev, with a file in place of the
+// spidev device, writes its frames to the file.
+static void testFileBackend(void) {
+  char path[] = "/tmp/dotstar_wireXXXXXX";
+  int fd = mkstemp(path);
+  CHECK(fd >= 0);
+  close(fd);
+
+  std::vector<uint32_t> c = testColors(40);
+  {
+    HostSPIDev dev(path);
+    SPIClass bus(&dev);
+    Adafruit_DotStar strip(40, DOTSTAR_BGR, &bus);
+    strip.begin();
+    CHECK(!dev.isSPI());
+    for (uint16_t i = 0; i < 40; i++)
+      strip.setPixelColor(i, c[i]);
+    strip.show();
+    strip.show();
+    CHECK_EQ(dev.getMessages(), 2); // One write per frame
+    CHECK(!dev.failed());
+  }
+
+  std::vector<uint8_t> want = refFrame(c, DOTSTAR_BGR), got;
+  want.insert(want.end(), want.begin(), want.end());
+  FILE *f = fopen(path, "rb");
+  CHECK(f != NULL);
+  if (f) {
+    int b;
+    while ((b = fgetc(f)) != EOF)
+      got.push_back(b);
+    fclose(f);
+  }
+  CHECK_BYTES(got, want);
+  unlink(path);
+
+  HostSPIDev bad("/nonexistent/dir/spidev");
+  CHECK(!bad.begin());
+  CHECK(bad.failed());
+}
+
+int main(void) {
+  testReference();
+  testCapture();
+  testFileBackend();
+  return testResult("wire");
+}
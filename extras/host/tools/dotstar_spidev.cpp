@@ -0,0 +1,62 @@
+// Drive a DotStar strip from Linux through spidev, e.g. on a Raspberry Pi
+// with the strip's data and clock on MOSI and SCLK:
+//   dotstar_spidev /dev/spidev0.0 144 [clock Hz] [seconds]
+// Shows a moving rainbow at quarter brightness and prints the frame rate.
+// A clock rate of 0 instead steps through a range of rates, printing the
+// time per frame and throughput at each (see measureShowTime()).
+// Any other path (a file, /dev/null) receives the raw wire data instead.
+
+#include "DotStarHost.h"
+
+#include <Adafruit_DotStar.h>
+
+#include <stdio.h>
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s device pixels [clock Hz] [seconds]\n",
+            argv[0]);
+    return 2;
+  }
+  uint16_t n = atoi(argv[2]);
+  uint32_t freq = (argc > 3) ? strtoul(argv[3], NULL, 0) : DOTSTAR_CLOCK_SPEED;
+  uint32_t seconds = (argc > 4) ? strtoul(argv[4], NULL, 0) : 10;
+
+  HostSPIDev dev(argv[1]);
+  SPIClass bus(&dev);
+  Adafruit_DotStar strip(n, DOTSTAR_BGR, &bus,
+                         freq ? freq : DOTSTAR_CLOCK_SPEED);
+  strip.begin();
+  if (dev.failed()) {
+    perror(argv[1]);
+    return 1;
+  }
+  printf("%s: %s, %u pixels, %u Hz\n", argv[1], dev.isSPI() ? "spidev" : "file",
+         n, strip.getClockSpeed());
+
+  strip.setBrightness(64);
+  if (!freq) {
+    static const uint32_t rates[] = {1000000,  2000000,  4000000, 8000000,
+                                     12000000, 16000000, 24000000, 32000000};
+    strip.rainbow();
+    for (uint32_t r : rates) {
+      uint32_t us = strip.measureShowTime(r, 20);
+      printf("%8u Hz: %6u us/frame, %6.2f Mbit/s\n", r, us,
+             us ? strip.getFrameBytes() * 8.0 / us : 0.0);
+    }
+    strip.clear();
+    strip.show();
+    return dev.failed() ? 1 : 0;
+  }
+
+  uint32_t start = millis(), frames = 0;
+  while (millis() - start < seconds * 1000) {
+    strip.rainbow(frames * 256);
+    strip.show();
+    frames++;
+  }
+  strip.clear();
+  strip.show();
+  printf("%u frames, %.1f frames/s\n", frames, frames / (double)seconds);
+  return dev.failed() ? 1 : 0;
+}